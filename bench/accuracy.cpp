@@ -0,0 +1,383 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file the precision each function trades for its speed
+///
+/// Every function is run in float over a random input set and an adversarial one, and each result
+/// is compared against the same function instantiated for long double on the same inputs, widened.
+/// Error is reported per component in float ULPs, the spacing of floats at the reference value, and
+/// as the relative error of the whole result. Each row also carries the float timing over that set,
+/// so the two can be read side by side. Results that came out inf or NaN where the reference is
+/// finite are counted as nonfinite and left out of the error figures.
+///
+/// usage: gdkmath_accuracy_<backend> with any option of the bench
+
+#include "harness.h"
+
+#include <gdk/math.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace gdk;
+using namespace gdk::bench;
+
+namespace {
+    using vec3 = vector3<float>;
+    using quat = quaternion<float>;
+    using mat4 = matrix4x4<float>;
+
+    //! size of the random input set of every function
+    constexpr std::size_t RANDOM_INPUTS = std::size_t(1) << 16;
+
+    //! how a result is compared to its reference
+    enum class comparison {
+        //! component by component
+        components,
+        //! q and -q are the same rotation: the closer of the two is compared
+        rotation,
+        //! angles in radians: the difference is wrapped to [-pi, pi]
+        angles
+    };
+
+    //! the widened, long double counterpart of an input
+    long double widen(const float aValue) { return aValue; }
+
+    vector3<long double> widen(const vec3 &aValue) { return {aValue.x, aValue.y, aValue.z}; }
+
+    quaternion<long double> widen(const quat &aValue) { return {aValue.x, aValue.y, aValue.z, aValue.w}; }
+
+    matrix4x4<long double> widen(const mat4 &aValue) {
+        matrix4x4<long double> out;
+
+        for (std::size_t column = 0; column < 4; ++column)
+            for (std::size_t row = 0; row < 4; ++row) out.set(column, row, aValue.get(column, row));
+
+        return out;
+    }
+
+    template<typename... types>
+    auto widen(const std::tuple<types...> &aValue) {
+        return std::apply([](const auto &...aParts) { return std::make_tuple(widen(aParts)...); }, aValue);
+    }
+
+    //! the components of a result, in a fixed order
+    template<typename T>
+    std::array<long double, 1> components(const T aValue) { return {static_cast<long double>(aValue)}; }
+
+    template<typename T>
+    std::array<long double, 3> components(const vector3<T> &aValue) { return {aValue.x, aValue.y, aValue.z}; }
+
+    template<typename T>
+    std::array<long double, 4> components(const quaternion<T> &aValue) {
+        return {aValue.x, aValue.y, aValue.z, aValue.w};
+    }
+
+    template<typename T>
+    std::array<long double, 16> components(const matrix4x4<T> &aValue) {
+        std::array<long double, 16> out;
+
+        for (std::size_t column = 0; column < 4; ++column)
+            for (std::size_t row = 0; row < 4; ++row) out[column * 4 + row] = aValue.get(column, row);
+
+        return out;
+    }
+
+    //! the spacing of floats at aValue; the smallest subnormal at zero
+    long double float_ulp(const long double aValue) {
+        const auto magnitude = static_cast<float>(std::fabs(aValue));
+
+        if (!std::isfinite(magnitude)) return std::numeric_limits<float>::max();
+
+        return static_cast<long double>(std::nextafter(magnitude, std::numeric_limits<float>::infinity()))
+            - static_cast<long double>(magnitude);
+    }
+
+    //! running error over every result of one function on one input set
+    struct error_totals final {
+        double maxUlp = 0, sumUlp = 0;
+        double maxRelative = 0, sumRelative = 0;
+        std::size_t compared = 0, componentCount = 0, nonfinite = 0;
+
+        template<std::size_t size>
+        void add(const std::array<long double, size> &aResult, const std::array<long double, size> &aReference,
+            const comparison aComparison) {
+            for (std::size_t i = 0; i < size; ++i) if (!std::isfinite(aReference[i])) return;
+
+            for (std::size_t i = 0; i < size; ++i) if (!std::isfinite(aResult[i])) {
+                ++nonfinite;
+
+                return;
+            }
+
+            auto errors = difference(aResult, aReference, aComparison);
+
+            if (aComparison == comparison::rotation) {
+                auto negated = aResult;
+                for (auto &c : negated) c = -c;
+
+                const auto other = difference(negated, aReference, aComparison);
+
+                if (norm(other) < norm(errors)) errors = other;
+            }
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto ulp = static_cast<double>(std::fabs(errors[i]) / float_ulp(aReference[i]));
+
+                maxUlp = std::max(maxUlp, ulp);
+                sumUlp += ulp;
+            }
+
+            const auto scale = norm(aReference);
+            const auto relative = static_cast<double>(scale > 0 ? norm(errors) / scale : norm(errors));
+
+            maxRelative = std::max(maxRelative, relative);
+            sumRelative += relative;
+
+            componentCount += size;
+            ++compared;
+        }
+
+        void report(result &aResult) const {
+            aResult.metrics.emplace_back("max_ulp", maxUlp);
+            aResult.metrics.emplace_back("mean_ulp", componentCount ? sumUlp / static_cast<double>(componentCount) : 0);
+            aResult.metrics.emplace_back("max_rel", maxRelative);
+            aResult.metrics.emplace_back("mean_rel", compared ? sumRelative / static_cast<double>(compared) : 0);
+            aResult.metrics.emplace_back("nonfinite", static_cast<double>(nonfinite));
+        }
+
+    private:
+        template<std::size_t size>
+        static std::array<long double, size> difference(const std::array<long double, size> &aResult,
+            const std::array<long double, size> &aReference, const comparison aComparison) {
+            std::array<long double, size> out;
+
+            for (std::size_t i = 0; i < size; ++i) {
+                out[i] = aResult[i] - aReference[i];
+
+                if (aComparison == comparison::angles)
+                    out[i] = std::remainder(out[i], 2 * numbers::detail::PI);
+            }
+
+            return out;
+        }
+
+        template<std::size_t size>
+        static long double norm(const std::array<long double, size> &aValue) {
+            long double sum = 0;
+
+            for (const auto c : aValue) sum += c * c;
+
+            return std::sqrt(sum);
+        }
+    };
+
+    //! time aFunction in float over aInputs, then measure its error against long double
+    template<typename input_type, typename function_type>
+    void check(harness &aHarness, const char *const aSuite, const char *const aName,
+        const std::vector<input_type> &aInputs, const comparison aComparison, const function_type &aFunction) {
+        using output_type = decltype(std::apply(aFunction, aInputs.front()));
+
+        std::vector<output_type> out(aInputs.size());
+
+        auto *const timing = aHarness.measure(aSuite, aName, mode::throughput, aInputs.size(), 0, [&] {
+            for (std::size_t i = 0; i < aInputs.size(); ++i) out[i] = std::apply(aFunction, aInputs[i]);
+
+            escape(out);
+        });
+
+        if (!timing) return;
+
+        error_totals totals;
+
+        for (std::size_t i = 0; i < aInputs.size(); ++i)
+            totals.add(components(out[i]), components(std::apply(aFunction, widen(aInputs[i]))), aComparison);
+
+        totals.report(*timing);
+
+        for (const auto c : components(out.front())) if (std::isfinite(c)) aHarness.sink += static_cast<double>(c);
+    }
+
+    //! check aFunction over both input sets, as one suite
+    template<typename input_type, typename function_type>
+    void check(harness &aHarness, const char *const aFunction, const std::vector<input_type> &aRandom,
+        const std::vector<input_type> &aAdversarial, const comparison aComparison, function_type &&aBody) {
+        check(aHarness, aFunction, "random", aRandom, aComparison, aBody);
+        check(aHarness, aFunction, "adversarial", aAdversarial, aComparison, aBody);
+    }
+
+    //! values across the whole float range that commonly go wrong: subnormals, values whose squares
+    /// underflow or overflow, and the largest finite float
+    const float EXTREMES[] = {
+        std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(), 1e-30f, 1e-20f,
+        1e-10f, 1e-4f, 1, 1e4f, 1e10f, 1e20f, 1e30f, std::numeric_limits<float>::max()};
+
+    //! vectors built from EXTREMES: every magnitude on each axis, mixed with a small and a large one
+    std::vector<std::tuple<vec3>> extreme_vectors() {
+        std::vector<std::tuple<vec3>> out;
+
+        for (const auto a : EXTREMES) {
+            out.emplace_back(vec3(a, 0, 0));
+            out.emplace_back(vec3(0, -a, 0));
+            out.emplace_back(vec3(a, a, a));
+            out.emplace_back(vec3(a, 1e-6f * a, -a));
+
+            for (const auto b : EXTREMES) out.emplace_back(vec3(a, -b, a));
+        }
+
+        return out;
+    }
+
+    std::vector<std::tuple<vec3>> random_vectors(random_source &aRng) {
+        std::vector<std::tuple<vec3>> out(RANDOM_INPUTS);
+
+        for (auto &v : out) v = vec3(aRng.next(), aRng.next(), aRng.next()) * 100.0f;
+
+        return out;
+    }
+
+    quat random_rotation(random_source &aRng) {
+        return quat::from_euler(vec3(aRng.next(), aRng.next(), aRng.next()) * numbers::pi_f);
+    }
+
+    //! euler angles within a few ulps of the poles, where heading and roll turn about the same axis
+    vec3 near_gimbal_lock(random_source &aRng) {
+        auto pitch = numbers::pi_f / 2;
+
+        for (auto steps = static_cast<int>((aRng.next() + 1) * 8); steps > 0; --steps)
+            pitch = std::nextafter(pitch, 0.0f);
+
+        return vec3(aRng.next() < 0 ? -pitch : pitch, aRng.next() * numbers::pi_f, aRng.next() * numbers::pi_f);
+    }
+
+    //! an affine transform with the given scale; a tiny or lopsided scale makes it near singular
+    mat4 transform(random_source &aRng, const vec3 &aScale) {
+        return mat4(vec3(aRng.next(), aRng.next(), aRng.next()) * 100.0f, random_rotation(aRng), aScale);
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        harness h(options::parse(argc, argv));
+
+        random_source rng(h.config().seed);
+
+        const auto randomVectors = random_vectors(rng);
+        const auto extremeVectors = extreme_vectors();
+
+        const auto normal = [](const auto &aVector) { return aVector.normal(); };
+        const auto length = [](const auto &aVector) { return aVector.length(); };
+
+        check(h, "normal", randomVectors, extremeVectors, comparison::components, normal);
+        check(h, "length", randomVectors, extremeVectors, comparison::components, length);
+
+        {
+            std::vector<std::tuple<quat, quat, float>> random(RANDOM_INPUTS), adversarial;
+
+            for (auto &input : random) input = {random_rotation(rng), random_rotation(rng), (rng.next() + 1) / 2};
+
+            // near parallel, where slerp hands over to nlerp; near opposite, where it flips one
+            // end; and the end points of t
+            for (std::size_t i = 0; i < RANDOM_INPUTS / 4; ++i) {
+                const auto a = random_rotation(rng);
+                const auto nudge = quat::from_angle_axis(rng.next() * 1e-3f, vec3(rng.next(), 1, rng.next()).normal());
+                const auto t = (rng.next() + 1) / 2;
+
+                adversarial.emplace_back(a, nudge * a, t);
+                adversarial.emplace_back(a, -(nudge * a), t);
+                adversarial.emplace_back(a, random_rotation(rng), 0.0f);
+                adversarial.emplace_back(a, random_rotation(rng), 1.0f);
+            }
+
+            const auto interpolate = [](const auto &a, const auto &b, const auto t) { return slerp(a, b, t); };
+
+            check(h, "slerp", random, adversarial, comparison::rotation, interpolate);
+        }
+
+        {
+            std::vector<std::tuple<mat4>> random(RANDOM_INPUTS), adversarial;
+
+            for (auto &input : random) input = transform(rng,
+                vec3(rng.next(), rng.next(), rng.next()) * 2.0f + vec3(2.5f * (rng.next() < 0 ? -1.0f : 1.0f)));
+
+            // near singular: tiny or very lopsided scales. Mirrored: one negative scale.
+            for (std::size_t i = 0; i < RANDOM_INPUTS / 4; ++i) {
+                adversarial.emplace_back(transform(rng, vec3(1e-3f)));
+                adversarial.emplace_back(transform(rng, vec3(1, 1, 1e-5f)));
+                adversarial.emplace_back(transform(rng, vec3(1e4f, 1, 1e-3f)));
+                adversarial.emplace_back(transform(rng, vec3(-1, 1, 1)));
+            }
+
+            const auto inverse = [](const auto &aMatrix) { return aMatrix.inversed(); };
+            const auto rotation = [](const auto &aMatrix) { return aMatrix.rotation(); };
+
+            check(h, "inverse", random, adversarial, comparison::components, inverse);
+
+            // rotation() reads a pure rotation; the random set's scale is taken out first
+            std::vector<std::tuple<mat4>> rotations(RANDOM_INPUTS), adversarialRotations;
+
+            for (auto &input : rotations) input = transform(rng, vec3::one);
+
+            // half turns, where the trace is near -1 and the largest diagonal must be picked
+            for (std::size_t i = 0; i < RANDOM_INPUTS / 4; ++i) {
+                const auto axis = vec3(rng.next(), rng.next(), rng.next()).normal();
+                const auto angle = std::nextafter(numbers::pi_f, 0.0f) - std::fabs(rng.next()) * 1e-3f;
+
+                mat4 m;
+                m.set_rotation_and_scale(quat::from_angle_axis(angle, axis), vec3::one);
+
+                adversarialRotations.emplace_back(m);
+            }
+
+            check(h, "rotation", rotations, adversarialRotations, comparison::rotation, rotation);
+        }
+
+        {
+            std::vector<std::tuple<quat>> random(RANDOM_INPUTS), adversarial(RANDOM_INPUTS);
+
+            for (auto &input : random) input = random_rotation(rng);
+            for (auto &input : adversarial) input = quat::from_euler(near_gimbal_lock(rng));
+
+            const auto toEuler = [](const auto &aRotation) { return aRotation.to_euler(); };
+
+            check(h, "to_euler", random, adversarial, comparison::angles, toEuler);
+        }
+
+        {
+            std::vector<std::tuple<vec3>> random(RANDOM_INPUTS), adversarial;
+
+            for (auto &input : random) input = vec3(rng.next(), rng.next(), rng.next()) * numbers::pi_f;
+
+            // the poles, and angles large enough that the argument reduction of sin and cos matters
+            for (std::size_t i = 0; i < RANDOM_INPUTS / 2; ++i) {
+                adversarial.emplace_back(near_gimbal_lock(rng));
+                adversarial.emplace_back(vec3(rng.next(), rng.next(), rng.next()) * 1e4f);
+            }
+
+            const auto fromEuler = [](const auto &aAngles) {
+                return quaternion<std::decay_t<decltype(aAngles.x)>>::from_euler(aAngles);
+            };
+
+            check(h, "from_euler", random, adversarial, comparison::rotation, fromEuler);
+        }
+
+        h.write();
+
+        if (h.regressions()) return 1;
+    }
+    catch (const std::exception &e) {
+        std::fprintf(stderr, "gdkmath accuracy: %s\n", e.what());
+
+        return 1;
+    }
+
+    return 0;
+}
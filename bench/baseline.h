@@ -0,0 +1,306 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_BENCH_BASELINE_H
+#define GDK_MATH_BENCH_BASELINE_H
+
+/// \file the results of an earlier run, read back from its JSON output, to gate a run against.
+///
+/// Benchmarks are matched by suite, name and mode. A result has regressed when its fastest sample is
+/// slower than the baseline's fastest by more than the threshold plus the noise of both runs, where a
+/// run's noise is how far its median sits above its fastest sample. The fastest sample is the
+/// estimate least disturbed by the rest of the machine; the noise term stops a jittery benchmark from
+/// failing a run on jitter alone.
+
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace gdk {
+    namespace bench {
+        //! just enough JSON to read the harness's own output back: any value, \u escapes in the basic
+        /// multilingual plane only
+        class json_value final {
+        public:
+            enum class kind { null, boolean, number, string, array, object };
+
+            kind type = kind::null;
+            bool boolean = false;
+            double number = 0;
+            std::string text;
+
+            //! the elements of an array, or the values of an object's members
+            std::vector<json_value> items;
+
+            //! the names of an object's members, parallel to items
+            std::vector<std::string> keys;
+
+            //! the member named aKey, or null when this is not an object or has no such member
+            [[nodiscard]] const json_value *find(const std::string &aKey) const {
+                for (std::size_t i = 0; i < keys.size(); ++i) if (keys[i] == aKey) return &items[i];
+
+                return nullptr;
+            }
+
+            //! parse a whole document. Throws std::runtime_error at the first thing that is not JSON.
+            static json_value parse(const std::string &aText) {
+                std::size_t position = 0;
+
+                auto value = parse_value(aText, position);
+
+                skip_space(aText, position);
+
+                if (position != aText.size()) fail(position, "trailing characters");
+
+                return value;
+            }
+
+        private:
+            [[noreturn]] static void fail(const std::size_t aPosition, const std::string &aWhat) {
+                throw std::runtime_error("JSON: " + aWhat + " at offset " + std::to_string(aPosition));
+            }
+
+            static void skip_space(const std::string &aText, std::size_t &aPosition) {
+                while (aPosition < aText.size() && std::isspace(static_cast<unsigned char>(aText[aPosition])))
+                    ++aPosition;
+            }
+
+            static bool consume(const std::string &aText, std::size_t &aPosition, const char *const aWord) {
+                const std::string word(aWord);
+
+                if (aText.compare(aPosition, word.size(), word) != 0) return false;
+
+                aPosition += word.size();
+
+                return true;
+            }
+
+            static json_value parse_value(const std::string &aText, std::size_t &aPosition) {
+                skip_space(aText, aPosition);
+
+                if (aPosition >= aText.size()) fail(aPosition, "unexpected end");
+
+                json_value value;
+
+                switch (aText[aPosition]) {
+                    case '{': {
+                        value.type = kind::object;
+                        ++aPosition;
+
+                        skip_space(aText, aPosition);
+
+                        if (consume(aText, aPosition, "}")) return value;
+
+                        do {
+                            skip_space(aText, aPosition);
+
+                            value.keys.push_back(parse_string(aText, aPosition));
+
+                            skip_space(aText, aPosition);
+
+                            if (!consume(aText, aPosition, ":")) fail(aPosition, "expected :");
+
+                            value.items.push_back(parse_value(aText, aPosition));
+
+                            skip_space(aText, aPosition);
+                        } while (consume(aText, aPosition, ","));
+
+                        if (!consume(aText, aPosition, "}")) fail(aPosition, "expected , or }");
+
+                        return value;
+                    }
+                    case '[': {
+                        value.type = kind::array;
+                        ++aPosition;
+
+                        skip_space(aText, aPosition);
+
+                        if (consume(aText, aPosition, "]")) return value;
+
+                        do {
+                            value.items.push_back(parse_value(aText, aPosition));
+
+                            skip_space(aText, aPosition);
+                        } while (consume(aText, aPosition, ","));
+
+                        if (!consume(aText, aPosition, "]")) fail(aPosition, "expected , or ]");
+
+                        return value;
+                    }
+                    case '"':
+                        value.type = kind::string;
+                        value.text = parse_string(aText, aPosition);
+
+                        return value;
+                }
+
+                if (consume(aText, aPosition, "null")) return value;
+
+                if (consume(aText, aPosition, "true")) {
+                    value.type = kind::boolean;
+                    value.boolean = true;
+
+                    return value;
+                }
+
+                if (consume(aText, aPosition, "false")) {
+                    value.type = kind::boolean;
+
+                    return value;
+                }
+
+                const char *const begin = aText.c_str() + aPosition;
+                char *end = nullptr;
+
+                value.type = kind::number;
+                value.number = std::strtod(begin, &end);
+
+                if (end == begin) fail(aPosition, "unexpected character");
+
+                aPosition += static_cast<std::size_t>(end - begin);
+
+                return value;
+            }
+
+            static std::string parse_string(const std::string &aText, std::size_t &aPosition) {
+                if (!consume(aText, aPosition, "\"")) fail(aPosition, "expected a string");
+
+                std::string out;
+
+                while (aPosition < aText.size() && aText[aPosition] != '"') {
+                    const char c = aText[aPosition++];
+
+                    if (c != '\\') {
+                        out += c;
+
+                        continue;
+                    }
+
+                    if (aPosition >= aText.size()) break;
+
+                    switch (const char escaped = aText[aPosition++]) {
+                        case 'b': out += '\b'; break;
+                        case 'f': out += '\f'; break;
+                        case 'n': out += '\n'; break;
+                        case 'r': out += '\r'; break;
+                        case 't': out += '\t'; break;
+                        case 'u': {
+                            if (aPosition + 4 > aText.size()) fail(aPosition, "short \\u escape");
+
+                            const auto code = std::stoul(aText.substr(aPosition, 4), nullptr, 16);
+                            aPosition += 4;
+
+                            if (code < 0x80) out += static_cast<char>(code);
+                            else if (code < 0x800) {
+                                out += static_cast<char>(0xc0 | (code >> 6));
+                                out += static_cast<char>(0x80 | (code & 0x3f));
+                            }
+                            else {
+                                out += static_cast<char>(0xe0 | (code >> 12));
+                                out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                                out += static_cast<char>(0x80 | (code & 0x3f));
+                            }
+
+                            break;
+                        }
+                        default: out += escaped; break;
+                    }
+                }
+
+                if (!consume(aText, aPosition, "\"")) fail(aPosition, "unterminated string");
+
+                return out;
+            }
+        };
+
+        class baseline final {
+        public:
+            //! a baseline result's nanoseconds per operation
+            struct timing final {
+                double min, median;
+            };
+
+            //! how a result compares to its baseline
+            struct verdict final {
+                //! the baseline's fastest sample
+                double baseline;
+
+                //! the relative change in the fastest sample: 0.1 is 10% slower
+                double change;
+
+                //! the change allowed before the result counts as regressed
+                double allowance;
+
+                [[nodiscard]] bool regressed() const { return change > allowance; }
+            };
+
+            //! read a file written by --format=json. Throws when it cannot be read or is not one.
+            static baseline load(const std::string &aPath) {
+                std::ifstream file(aPath, std::ios::binary);
+
+                if (!file) throw std::runtime_error("cannot open baseline " + aPath);
+
+                const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+                const auto document = json_value::parse(text);
+                const auto *const results = document.find("results");
+
+                if (!results || results->type != json_value::kind::array)
+                    throw std::runtime_error(aPath + " has no results: is it the output of --format=json?");
+
+                baseline b;
+
+                for (const auto &r : results->items) {
+                    const auto *const suite = r.find("suite");
+                    const auto *const name = r.find("name");
+                    const auto *const mode = r.find("mode");
+                    const auto *const ns = r.find("ns");
+                    const auto *const min = ns ? ns->find("min") : nullptr;
+                    const auto *const median = ns ? ns->find("median") : nullptr;
+
+                    if (!suite || !name || !mode || !min || !median)
+                        throw std::runtime_error(aPath + " has a result without suite, name, mode or ns");
+
+                    b.m_Timings[std::make_tuple(suite->text, name->text, mode->text)] = {min->number, median->number};
+                }
+
+                return b;
+            }
+
+            //! the baseline's timing of a benchmark, or null when the baseline did not run it
+            [[nodiscard]] const timing *find(const std::string &aSuite, const std::string &aName,
+                const std::string &aMode) const {
+                const auto found = m_Timings.find(std::make_tuple(aSuite, aName, aMode));
+
+                return found == m_Timings.end() ? nullptr : &found->second;
+            }
+
+            //! compare a result's fastest and median samples to aBaseline, allowing aThreshold (0.05 is 5%)
+            /// on top of the noise of both runs
+            [[nodiscard]] static verdict compare(const timing &aBaseline, const double aMin, const double aMedian,
+                const double aThreshold) {
+                const auto noise = [](const double aFastest, const double aTypical) {
+                    return aFastest > 0 ? (aTypical - aFastest) / aFastest : 0;
+                };
+
+                verdict v;
+                v.baseline = aBaseline.min;
+                v.change = aBaseline.min > 0 ? aMin / aBaseline.min - 1 : 0;
+                v.allowance = aThreshold + noise(aBaseline.min, aBaseline.median) + noise(aMin, aMedian);
+
+                return v;
+            }
+
+        private:
+            std::map<std::tuple<std::string, std::string, std::string>, timing> m_Timings;
+        };
+    }
+}
+
+#endif
@@ -1,22 +1,31 @@
 // © Joseph Cameron - All Rights Reserved
 
 /// \file used to compare the performance of different implementations
+///
+/// Every operation is measured twice. Throughput runs independent operations over arrays, so the
+/// cost is that of one among many in flight. Latency feeds each result into the next operation's
+/// input, so the cost is that of one waiting on the last. Where the result is not of the input's
+/// type, it is carried into the next input by carry(), whose own cost is reported as
+/// "harness/carry" and is included in those latencies.
+///
+/// usage: gdkmath_bench_<backend> [--format=text|json|csv] [--output=PATH] [--filter=S]
+///     [--samples=N] [--seed=N] [--label=S] [--counters=on|off]
+///     [--baseline=PATH] [--threshold=PERCENT] [--retries=N]
+///
+/// As a regression gate: save a run with --format=json --output=baseline.json, then run again with
+/// --baseline=baseline.json. The exit status is 1 if any benchmark regressed.
+
+#include "harness.h"
 
 #include <gdk/math.h>
 
-#include <algorithm>
-#include <chrono>
 #include <cstddef>
 #include <cstdio>
-#include <cstdlib>
-#include <string>
+#include <exception>
 #include <vector>
 
-#ifndef GDK_MATH_BENCH_BACKEND
-#define GDK_MATH_BENCH_BACKEND "unknown"
-#endif
-
 using namespace gdk;
+using namespace gdk::bench;
 
 namespace {
     using vec3 = vector3<float>;
@@ -25,212 +34,274 @@ namespace {
     using mat3 = matrix3x3<float>;
     using mat4 = matrix4x4<float>;
 
-    inline void clobber() { asm volatile("" : : : "memory"); }
+    //! one component of a result, for the checksum and for carry()
+    float first(const float aValue) { return aValue; }
+    float first(const vec3 &aValue) { return aValue.x; }
+    float first(const vec4 &aValue) { return aValue.x; }
+    float first(const quat &aValue) { return aValue.w; }
+    float first(const mat3 &aValue) { return aValue.get(0, 0); }
+    float first(const mat4 &aValue) { return aValue.get(0, 0); }
+
+    //! aInput, made to depend on aResult at the cost of a multiply and an add: times zero cannot be
+    /// folded away, as aResult could be infinite or NaN
+    vec3 carry(vec3 aInput, const float aResult) { aInput.x += aResult * 0.0f; return aInput; }
+    quat carry(quat aInput, const float aResult) { aInput.w += aResult * 0.0f; return aInput; }
+    mat4 carry(mat4 aInput, const float aResult) { aInput.get(3, 0) += aResult * 0.0f; return aInput; }
+
+    struct data final {
+        std::size_t count;
+        std::vector<vec3> a3, b3;
+        std::vector<vec4> a4;
+        std::vector<quat> aq, bq;
+        std::vector<mat4> am, bm;
+        std::vector<mat3> a33, b33;
+
+        //! am carries non-uniform scale; bm and b33 are rotation and translation only, so chains of
+        /// them stay bounded
+        data(const std::size_t aCount, const std::uint32_t aSeed)
+        : count(aCount), a3(aCount), b3(aCount), a4(aCount), aq(aCount), bq(aCount), am(aCount), bm(aCount),
+        a33(aCount), b33(aCount) {
+            random_source rng(aSeed);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                a3[i] = vec3(rng.next(), rng.next(), rng.next());
+                b3[i] = vec3(rng.next(), rng.next(), rng.next());
+                a4[i] = vec4(rng.next(), rng.next(), rng.next(), rng.next() + 2.0f);
+
+                aq[i] = quat::from_euler(vec3(rng.next(), rng.next(), rng.next()));
+                bq[i] = quat::from_euler(vec3(rng.next(), rng.next(), rng.next()));
+
+                am[i].set_to_identity();
+                am[i].set_rotation_and_scale(aq[i], vec3(1 + std::abs(rng.next()), 1, 1));
+                am[i].set_translation(a3[i]);
+
+                bm[i].set_to_identity();
+                bm[i].set_rotation_and_scale(bq[i], vec3::one);
+                bm[i].set_translation(b3[i]);
+
+                a33[i] = upper_left(am[i]);
+                b33[i] = upper_left(bm[i]);
+            }
+        }
+    };
 
-    template <typename value_type>
-    inline void escape(value_type &aValue) { asm volatile("" : : "g"(&aValue) : "memory"); }
+    //! out[i] = aOperation(i) for every i, each result independent of the others. Results go to an
+    /// array, as a batch's would, rather than being forced out one by one.
+    template<typename operation_type>
+    void throughput(harness &aHarness, const char *const aSuite, const char *const aName, const std::size_t aCount,
+        operation_type &&aOperation) {
+        std::vector<decltype(aOperation(std::size_t()))> out(aCount);
 
-    struct random_source final {
-        std::uint32_t state;
+        aHarness.measure(aSuite, aName, mode::throughput, aCount, 0, [&] {
+            for (std::size_t i = 0; i < aCount; ++i) out[i] = aOperation(i);
 
-        explicit random_source(const std::uint32_t aSeed) : state(aSeed) {}
+            escape(out);
+            aHarness.sink += static_cast<double>(first(out.back()));
+        });
+    }
 
-        float next() {
-            state = state * 1664525u + 1013904223u;
+    //! r = aStep(r, i) for every i, starting from aInitial: each operation waits on the one before
+    template<typename state_type, typename step_type>
+    void latency(harness &aHarness, const char *const aSuite, const char *const aName, const std::size_t aCount,
+        const state_type &aInitial, step_type &&aStep) {
+        aHarness.measure(aSuite, aName, mode::latency, aCount, 0, [&] {
+            auto r = aInitial;
 
-            return static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f;
-        }
-    };
+            for (std::size_t i = 0; i < aCount; ++i) r = aStep(r, i);
 
-    template <typename body_type>
-    double ns_per_op(const std::size_t aCount, const std::size_t aPasses, body_type &&aBody) {
-        double best = 1e30;
+            escape(r);
+            aHarness.sink += static_cast<double>(first(r));
+        });
+    }
 
-        for (std::size_t pass = 0; pass < aPasses; ++pass) {
-            const auto start = std::chrono::steady_clock::now();
+    void vector3_suite(harness &h, const data &d) {
+        const auto n = d.count;
+        const char *const suite = "vector3";
 
-            aBody();
+        throughput(h, suite, "operator+", n, [&](auto i) { return d.a3[i] + d.b3[i]; });
+        latency(h, suite, "operator+", n, vec3::zero, [&](const vec3 &r, auto i) { return r + d.a3[i]; });
 
-            clobber();
+        throughput(h, suite, "operator-", n, [&](auto i) { return d.a3[i] - d.b3[i]; });
+        latency(h, suite, "operator-", n, vec3::zero, [&](const vec3 &r, auto i) { return r - d.a3[i]; });
 
-            const auto elapsed = std::chrono::duration<double, std::nano>(
-                std::chrono::steady_clock::now() - start).count();
+        throughput(h, suite, "operator* scalar", n, [&](auto i) { return d.a3[i] * d.b3[i].x; });
+        latency(h, suite, "operator* scalar", n, vec3::zero, [&](const vec3 &r, auto i) {
+            return carry(d.a3[i], r.x) * d.b3[i].x; });
 
-            best = std::min(best, elapsed / static_cast<double>(aCount));
-        }
+        throughput(h, suite, "dot_product", n, [&](auto i) { return d.a3[i].dot_product(d.b3[i]); });
+        latency(h, suite, "dot_product", n, 0.0f, [&](float r, auto i) {
+            return carry(d.a3[i], r).dot_product(d.b3[i]); });
 
-        return best;
-    }
+        throughput(h, suite, "cross_product", n, [&](auto i) { return d.a3[i].cross_product(d.b3[i]); });
+        latency(h, suite, "cross_product", n, vec3::zero, [&](const vec3 &r, auto i) {
+            return carry(d.a3[i], r.x).cross_product(d.b3[i]); });
 
-    double g_checksum = 0;
+        throughput(h, suite, "length_squared", n, [&](auto i) { return d.a3[i].length_squared(); });
+        latency(h, suite, "length_squared", n, 0.0f, [&](float r, auto i) { return carry(d.a3[i], r).length_squared(); });
 
-    void report(const char *aName, const double aNanoseconds) {
-        std::printf("  %-34s %8.2f ns\n", aName, aNanoseconds);
+        throughput(h, suite, "length (sqrt)", n, [&](auto i) { return d.a3[i].length(); });
+        latency(h, suite, "length (sqrt)", n, 0.0f, [&](float r, auto i) { return carry(d.a3[i], r).length(); });
+
+        throughput(h, suite, "normal (sqrt)", n, [&](auto i) { return d.a3[i].normal(); });
+        latency(h, suite, "normal (sqrt)", n, vec3::zero, [&](const vec3 &r, auto i) {
+            return carry(d.a3[i], r.x).normal(); });
+
+        throughput(h, suite, "lerp", n, [&](auto i) { return lerp(d.a3[i], d.b3[i], 0.35f); });
+        latency(h, suite, "lerp", n, vec3::zero, [&](const vec3 &r, auto i) { return lerp(r, d.b3[i], 0.35f); });
     }
-}
 
-int main(int argc, char **argv) {
-    const std::uint32_t seed = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 12345u;
+    void quaternion_suite(harness &h, const data &d) {
+        const auto n = d.count;
+        const char *const suite = "quaternion";
 
-    constexpr std::size_t COUNT = 1u << 16;
-    constexpr std::size_t PASSES = 7;
+        throughput(h, suite, "operator* (compose)", n, [&](auto i) { return d.aq[i] * d.bq[i]; });
+        latency(h, suite, "operator* (compose)", n, quat::identity, [&](const quat &r, auto i) { return r * d.bq[i]; });
 
-    random_source rng(seed);
+        throughput(h, suite, "operator* vector3 (rotate)", n, [&](auto i) { return d.aq[i] * d.a3[i]; });
+        latency(h, suite, "operator* vector3 (rotate)", n, vec3::one, [&](const vec3 &r, auto i) {
+            return d.aq[i] * r; });
 
-    std::vector<vec3> a3(COUNT), b3(COUNT);
-    std::vector<vec4> a4(COUNT);
-    std::vector<quat> aq(COUNT), bq(COUNT);
-    std::vector<mat4> am(COUNT), bm(COUNT);
-    std::vector<mat3> a33(COUNT);
+        throughput(h, suite, "slerp (acos, sin)", n, [&](auto i) { return slerp(d.aq[i], d.bq[i], 0.35f); });
+        latency(h, suite, "slerp (acos, sin)", n, quat::identity, [&](const quat &r, auto i) {
+            return slerp(r, d.bq[i], 0.35f); });
 
-    for (std::size_t i = 0; i < COUNT; ++i) {
-        a3[i] = vec3(rng.next(), rng.next(), rng.next());
-        b3[i] = vec3(rng.next(), rng.next(), rng.next());
-        a4[i] = vec4(rng.next(), rng.next(), rng.next(), rng.next() + 2.0f);
+        throughput(h, suite, "nlerp (sqrt)", n, [&](auto i) { return nlerp(d.aq[i], d.bq[i], 0.35f); });
+        latency(h, suite, "nlerp (sqrt)", n, quat::identity, [&](const quat &r, auto i) {
+            return nlerp(r, d.bq[i], 0.35f); });
 
-        aq[i] = quat::from_euler(vec3(rng.next(), rng.next(), rng.next()));
-        bq[i] = quat::from_euler(vec3(rng.next(), rng.next(), rng.next()));
+        throughput(h, suite, "normalized", n, [&](auto i) { return d.aq[i].normalized(); });
+        latency(h, suite, "normalized", n, quat::identity, [&](const quat &r, auto i) {
+            return carry(d.aq[i], r.w).normalized(); });
 
-        am[i].set_to_identity();
-        am[i].set_rotation_and_scale(aq[i], vec3(1 + std::abs(rng.next()), 1, 1));
-        am[i].set_translation(a3[i]);
+        throughput(h, suite, "inverse", n, [&](auto i) { return d.aq[i].inverse(); });
+        latency(h, suite, "inverse", n, d.aq[0], [&](const quat &r, auto) { return r.inverse(); });
 
-        bm[i].set_to_identity();
-        bm[i].set_rotation_and_scale(bq[i], vec3::one);
-        bm[i].set_translation(b3[i]);
+        throughput(h, suite, "from_euler (3 sincos)", n, [&](auto i) { return quat::from_euler(d.a3[i]); });
+        latency(h, suite, "from_euler (3 sincos)", n, quat::identity, [&](const quat &r, auto i) {
+            return quat::from_euler(carry(d.a3[i], r.w)); });
 
-        a33[i] = upper_left(am[i]);
+        throughput(h, suite, "to_euler (atan2, asin)", n, [&](auto i) { return d.aq[i].to_euler(); });
+        latency(h, suite, "to_euler (atan2, asin)", n, vec3::zero, [&](const vec3 &r, auto i) {
+            return carry(d.aq[i], r.x).to_euler(); });
     }
 
-    std::printf("gdk-math bench   backend=%s   count=%zu   passes=%zu   seed=%u\n\n",
-        GDK_MATH_BENCH_BACKEND, COUNT, PASSES, seed);
-
-    double sink = 0;
-
-    std::puts("vector3");
-    report("operator+", ns_per_op(COUNT, PASSES, [&]{
-        vec3 acc;
-        for (std::size_t i = 0; i < COUNT; ++i) acc = acc + a3[i];
-        sink += acc.x + acc.y + acc.z;
-    }));
-    report("dot_product", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) acc += a3[i].dot_product(b3[i]);
-        sink += acc;
-    }));
-    report("cross_product", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = a3[i].cross_product(b3[i]); escape(r); acc += r.x; }
-        sink += acc;
-    }));
-    report("length  (sqrt)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) acc += a3[i].length();
-        sink += acc;
-    }));
-    report("normal  (sqrt)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = a3[i].normal(); escape(r); acc += r.x; }
-        sink += acc;
-    }));
-
-    std::puts("\nquaternion");
-    report("operator* (compose)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = aq[i] * bq[i]; escape(r); acc += r.w; }
-        sink += acc;
-    }));
-    report("operator* vector3 (rotate)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = aq[i] * a3[i]; escape(r); acc += r.x; }
-        sink += acc;
-    }));
-    report("slerp   (acos, sin)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = slerp(aq[i], bq[i], 0.35f); escape(r); acc += r.w; }
-        sink += acc;
-    }));
-    report("nlerp   (sqrt)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = nlerp(aq[i], bq[i], 0.35f); escape(r); acc += r.w; }
-        sink += acc;
-    }));
-
-    std::puts("\nmatrix4x4");
-    report("operator* (compose)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = am[i] * bm[i]; escape(r); acc += r.get(3, 0); }
-        sink += acc;
-    }));
-    report("operator* vector3 (point)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = am[i] * a3[i]; escape(r); acc += r.x; }
-        sink += acc;
-    }));
-    report("operator* vector4", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = am[i] * a4[i]; escape(r); acc += r.x; }
-        sink += acc;
-    }));
-    report("set_rotation_and_scale", ns_per_op(COUNT, PASSES, [&]{
-        mat4 m;
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) {
-            m.set_rotation_and_scale(aq[i], vec3::one);
-            acc += m.get(0, 0);
-        }
-        sink += acc;
-    }));
-    report("inversed", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = am[i].inversed(); escape(r); acc += r.get(3, 0); }
-        sink += acc;
-    }));
-    report("rotation  (4 sqrt + 9 div)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = am[i].rotation(); escape(r); acc += r.w; }
-        sink += acc;
-    }));
-    report("scale     (3 sqrt)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = am[i].scale(); escape(r); acc += r.x; }
-        sink += acc;
-    }));
-
-    std::puts("\nmatrix3x3");
-    report("operator* (compose)", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = a33[i] * a33[i]; escape(r); acc += r.get(0, 0); }
-        sink += acc;
-    }));
-    report("inversed", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = a33[i].inversed(); escape(r); acc += r.get(0, 0); }
-        sink += acc;
-    }));
-    report("normal_matrix", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = normal_matrix(am[i]); escape(r); acc += r.get(0, 0); }
-        sink += acc;
-    }));
-
-    std::puts("\nbatch: one matrix over many points");
-    const mat4 single = am[0];
-    report("transform N points, per point", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = single * a3[i]; escape(r); acc += r.x; }
-        sink += acc;
-    }));
-    report("transform N directions, per one", ns_per_op(COUNT, PASSES, [&]{
-        float acc = 0;
+    void matrix4x4_suite(harness &h, const data &d) {
+        const auto n = d.count;
+        const char *const suite = "matrix4x4";
+
+        throughput(h, suite, "operator* (compose)", n, [&](auto i) { return d.am[i] * d.bm[i]; });
+        latency(h, suite, "operator* (compose)", n, mat4::identity, [&](const mat4 &r, auto i) { return r * d.bm[i]; });
+
+        throughput(h, suite, "operator* vector3 (point)", n, [&](auto i) { return d.am[i] * d.a3[i]; });
+        latency(h, suite, "operator* vector3 (point)", n, vec3::zero, [&](const vec3 &r, auto i) {
+            return d.bm[i] * r; });
+
+        throughput(h, suite, "operator* vector4", n, [&](auto i) { return d.am[i] * d.a4[i]; });
+        latency(h, suite, "operator* vector4", n, vec4(0, 0, 0, 1), [&](const vec4 &r, auto i) {
+            return d.bm[i] * r; });
+
+        throughput(h, suite, "set_rotation_and_scale", n, [&](auto i) {
+            mat4 m;
+            m.set_rotation_and_scale(d.aq[i], vec3::one);
+            return m;
+        });
+        latency(h, suite, "set_rotation_and_scale", n, mat4::identity, [&](const mat4 &r, auto i) {
+            mat4 m;
+            m.set_rotation_and_scale(carry(d.aq[i], r.get(0, 0)), vec3::one);
+            return m;
+        });
+
+        throughput(h, suite, "inversed", n, [&](auto i) { return d.am[i].inversed(); });
+        latency(h, suite, "inversed", n, d.am[0], [&](const mat4 &r, auto) { return r.inversed(); });
+
+        throughput(h, suite, "inverse_affine", n, [&](auto i) {
+            auto m = d.am[i];
+            m.inverse_affine();
+            return m;
+        });
+        latency(h, suite, "inverse_affine", n, d.am[0], [&](mat4 r, auto) {
+            r.inverse_affine();
+            return r;
+        });
+
+        throughput(h, suite, "transposed", n, [&](auto i) { return d.am[i].transposed(); });
+        latency(h, suite, "transposed", n, d.am[0], [&](const mat4 &r, auto) { return r.transposed(); });
+
+        throughput(h, suite, "determinant", n, [&](auto i) { return d.am[i].determinant(); });
+        latency(h, suite, "determinant", n, 0.0f, [&](float r, auto i) { return carry(d.am[i], r).determinant(); });
+
+        throughput(h, suite, "rotation (4 sqrt + 9 div)", n, [&](auto i) { return d.am[i].rotation(); });
+        latency(h, suite, "rotation (4 sqrt + 9 div)", n, quat::identity, [&](const quat &r, auto i) {
+            return carry(d.am[i], r.w).rotation(); });
+
+        throughput(h, suite, "scale (3 sqrt)", n, [&](auto i) { return d.am[i].scale(); });
+        latency(h, suite, "scale (3 sqrt)", n, vec3::zero, [&](const vec3 &r, auto i) {
+            return carry(d.am[i], r.x).scale(); });
+    }
+
+    void matrix3x3_suite(harness &h, const data &d) {
+        const auto n = d.count;
+        const char *const suite = "matrix3x3";
+
+        throughput(h, suite, "operator* (compose)", n, [&](auto i) { return d.a33[i] * d.b33[i]; });
+        latency(h, suite, "operator* (compose)", n, mat3::identity, [&](const mat3 &r, auto i) {
+            return r * d.b33[i]; });
+
+        throughput(h, suite, "operator* vector3", n, [&](auto i) { return d.a33[i] * d.a3[i]; });
+        latency(h, suite, "operator* vector3", n, vec3::one, [&](const vec3 &r, auto i) { return d.b33[i] * r; });
+
+        throughput(h, suite, "inversed", n, [&](auto i) { return d.a33[i].inversed(); });
+        latency(h, suite, "inversed", n, d.a33[0], [&](const mat3 &r, auto) { return r.inversed(); });
+
+        throughput(h, suite, "determinant", n, [&](auto i) { return d.a33[i].determinant(); });
+        latency(h, suite, "determinant", n, 0.0f, [&](float r, auto i) {
+            auto m = d.a33[i];
+            m.get(0, 0) += r * 0.0f;
+            return m.determinant();
+        });
+
+        throughput(h, suite, "normal_matrix", n, [&](auto i) { return normal_matrix(d.am[i]); });
+        latency(h, suite, "normal_matrix", n, mat3::identity, [&](const mat3 &r, auto i) {
+            return normal_matrix(carry(d.am[i], r.get(0, 0))); });
+    }
+
+    void batch_suite(harness &h, const data &d) {
+        const auto n = d.count;
+        const char *const suite = "batch: one matrix over many points";
+
+        const mat4 single = d.am[0];
         const auto linear = upper_left(single);
-        for (std::size_t i = 0; i < COUNT; ++i) { auto r = linear * a3[i]; escape(r); acc += r.x; }
-        sink += acc;
-    }));
 
-    g_checksum = sink;
+        throughput(h, suite, "transform N points, per point", n, [&](auto i) { return single * d.a3[i]; });
+        throughput(h, suite, "transform N directions, per one", n, [&](auto i) { return linear * d.a3[i]; });
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        harness h(options::parse(argc, argv));
+
+        constexpr std::size_t COUNT = 1u << 16;
+
+        const data d(COUNT, h.config().seed);
+
+        latency(h, "harness", "carry", COUNT, 0.0f, [&](float r, auto i) { return carry(d.a3[i], r).x; });
+
+        vector3_suite(h, d);
+        quaternion_suite(h, d);
+        matrix4x4_suite(h, d);
+        matrix3x3_suite(h, d);
+        batch_suite(h, d);
 
-    std::printf("\nchecksum %.6f   (must differ for a different seed argument)\n", g_checksum);
+        h.write();
+
+        if (h.regressions()) return 1;
+    }
+    catch (const std::exception &e) {
+        std::fprintf(stderr, "gdkmath bench: %s\n", e.what());
+
+        return 1;
+    }
 
     return 0;
 }
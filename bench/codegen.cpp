@@ -0,0 +1,41 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file the hot kernels whose generated code is inspected by codegen_check.cmake.
+///
+/// Each is wrapped in an extern "C" function of its own, so its disassembly can be found by name.
+/// Operands are passed by pointer, so the wrappers add nothing to the kernel but a load and a store.
+
+#include <gdk/math.h>
+
+#include <cstddef>
+
+using namespace gdk;
+
+extern "C" {
+    void gdkmath_codegen_matrix4x4_multiply(const matrix4x4<float> *const a, const matrix4x4<float> *const b,
+        matrix4x4<float> *const aOut) {
+        *aOut = *a * *b;
+    }
+
+    void gdkmath_codegen_matrix4x4_vector4(const matrix4x4<float> *const aMatrix, const vector4<float> *const aVector,
+        vector4<float> *const aOut) {
+        *aOut = *aMatrix * *aVector;
+    }
+
+    void gdkmath_codegen_quaternion_multiply(const quaternion<float> *const a, const quaternion<float> *const b,
+        quaternion<float> *const aOut) {
+        *aOut = *a * *b;
+    }
+
+    void gdkmath_codegen_vector3_normal(const vector3<float> *const aVector, vector3<float> *const aOut) {
+        *aOut = aVector->normal();
+    }
+
+    std::size_t gdkmath_codegen_closest_points_on_aabbs(const vector3<float> *const aPoint,
+        const float *const aMinX, const float *const aMinY, const float *const aMinZ,
+        const float *const aMaxX, const float *const aMaxY, const float *const aMaxZ, const std::size_t aCount,
+        float *const aX, float *const aY, float *const aZ, float *const aDistancesSquared) {
+        return closest_points_on_aabbs(*aPoint, {aMinX, aMinY, aMinZ}, {aMaxX, aMaxY, aMaxZ}, aCount,
+            {aX, aY, aZ}, aDistancesSquared);
+    }
+}
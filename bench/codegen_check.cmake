@@ -0,0 +1,160 @@
+# © Joseph Cameron - All Rights Reserved
+
+# Disassembles an object built from codegen.cpp and checks each kernel's code against the expectations
+# below: at most so many instructions, packed SIMD arithmetic where the kernel should be vectorized,
+# and no calls but those listed. A call that throws is never allowed. Each kernel's disassembly is
+# written to OUTPUT_DIRECTORY/LABEL/<kernel>.s, for reading or diffing across changes.
+#
+# cmake -DOBJDUMP=<objdump> -DOBJECT=<codegen object> -DLEVEL=<O2|O3> -DLABEL=<backend>_<level>
+#     -DOUTPUT_DIRECTORY=<directory> -P codegen_check.cmake
+
+cmake_minimum_required(VERSION 3.9 FATAL_ERROR)
+
+foreach(GDK_MATH_REQUIRED OBJDUMP OBJECT LEVEL LABEL OUTPUT_DIRECTORY)
+    if (NOT DEFINED ${GDK_MATH_REQUIRED})
+        message(FATAL_ERROR "codegen_check.cmake: ${GDK_MATH_REQUIRED} is not set")
+    endif()
+endforeach()
+
+# the instruction limits leave room for a compiler's ordinary variation, not for a lost vectorization.
+# _PACKED lists the levels at which a kernel must be vectorized: the batch loop is left to -O3.
+# normal's sqrtf is the errno path of sqrtss, taken only for a negative length squared.
+set(GDK_MATH_CODEGEN_KERNELS
+    matrix4x4_multiply
+    matrix4x4_vector4
+    quaternion_multiply
+    vector3_normal
+    closest_points_on_aabbs)
+
+set(matrix4x4_multiply_MAX_INSTRUCTIONS 96)
+set(matrix4x4_multiply_PACKED O2 O3)
+set(matrix4x4_multiply_CALLS "")
+
+set(matrix4x4_vector4_MAX_INSTRUCTIONS 40)
+set(matrix4x4_vector4_PACKED O2 O3)
+set(matrix4x4_vector4_CALLS "")
+
+set(quaternion_multiply_MAX_INSTRUCTIONS 80)
+set(quaternion_multiply_PACKED "")
+set(quaternion_multiply_CALLS "")
+
+set(vector3_normal_MAX_INSTRUCTIONS 64)
+set(vector3_normal_PACKED "")
+set(vector3_normal_CALLS sqrtf)
+
+set(closest_points_on_aabbs_MAX_INSTRUCTIONS 400)
+set(closest_points_on_aabbs_PACKED O3)
+set(closest_points_on_aabbs_CALLS "")
+
+# arithmetic on 4 floats at once: SSE and AVX on x86, NEON on AArch64
+set(GDK_MATH_PACKED_PATTERN
+    "\t(v?(add|sub|mul|div|min|max)ps|vfn?m(add|sub)[0-9]+ps|(fadd|fsub|fmul|fdiv|fmla|fmls|fmin|fmax)\tv[0-9]+\\.4s)")
+
+# the relocations of calls and tail calls out of the object
+set(GDK_MATH_CALL_PATTERN "R_[A-Z0-9_]*(PLT32|CALL26|JUMP26)\t[A-Za-z_.$][A-Za-z0-9_.$@]*")
+
+set(GDK_MATH_THROW_PATTERN "__cxa_throw|__cxa_allocate_exception|__throw_")
+
+execute_process(
+    COMMAND "${OBJDUMP}" -dr --no-show-raw-insn "${OBJECT}"
+    OUTPUT_VARIABLE GDK_MATH_DISASSEMBLY
+    RESULT_VARIABLE GDK_MATH_OBJDUMP_RESULT)
+
+if (NOT GDK_MATH_OBJDUMP_RESULT EQUAL 0)
+    message(FATAL_ERROR "codegen_check.cmake: ${OBJDUMP} could not disassemble ${OBJECT}")
+endif()
+
+# semicolons only appear in comments, and would split the lists below
+string(REPLACE ";" "" GDK_MATH_DISASSEMBLY "${GDK_MATH_DISASSEMBLY}")
+
+file(MAKE_DIRECTORY "${OUTPUT_DIRECTORY}/${LABEL}")
+
+set(GDK_MATH_FAILURES "")
+
+foreach(GDK_MATH_KERNEL ${GDK_MATH_CODEGEN_KERNELS})
+    set(GDK_MATH_SYMBOL "gdkmath_codegen_${GDK_MATH_KERNEL}")
+
+    # a function runs from its label to the blank line before the next
+    string(FIND "${GDK_MATH_DISASSEMBLY}" "<${GDK_MATH_SYMBOL}>:\n" GDK_MATH_BEGIN)
+
+    if (GDK_MATH_BEGIN EQUAL -1)
+        list(APPEND GDK_MATH_FAILURES "${GDK_MATH_KERNEL}: not found in ${OBJECT}")
+
+        continue()
+    endif()
+
+    string(SUBSTRING "${GDK_MATH_DISASSEMBLY}" ${GDK_MATH_BEGIN} -1 GDK_MATH_CODE)
+    string(FIND "${GDK_MATH_CODE}" "\n\n" GDK_MATH_END)
+    string(SUBSTRING "${GDK_MATH_CODE}" 0 ${GDK_MATH_END} GDK_MATH_CODE)
+
+    # and on into the cold part the compiler splits off, where the throwing paths usually go
+    string(FIND "${GDK_MATH_DISASSEMBLY}" "<${GDK_MATH_SYMBOL}.cold>:\n" GDK_MATH_COLD_BEGIN)
+
+    if (NOT GDK_MATH_COLD_BEGIN EQUAL -1)
+        string(SUBSTRING "${GDK_MATH_DISASSEMBLY}" ${GDK_MATH_COLD_BEGIN} -1 GDK_MATH_COLD)
+        string(FIND "${GDK_MATH_COLD}" "\n\n" GDK_MATH_END)
+        string(SUBSTRING "${GDK_MATH_COLD}" 0 ${GDK_MATH_END} GDK_MATH_COLD)
+
+        string(APPEND GDK_MATH_CODE "\n\n${GDK_MATH_COLD}")
+    endif()
+
+    file(WRITE "${OUTPUT_DIRECTORY}/${LABEL}/${GDK_MATH_KERNEL}.s" "${GDK_MATH_CODE}\n")
+
+    string(REGEX MATCHALL "\n *[0-9a-f]+:\t" GDK_MATH_INSTRUCTIONS "${GDK_MATH_CODE}")
+    list(LENGTH GDK_MATH_INSTRUCTIONS GDK_MATH_INSTRUCTION_COUNT)
+
+    string(REGEX MATCH "${GDK_MATH_PACKED_PATTERN}" GDK_MATH_PACKED "${GDK_MATH_CODE}")
+
+    string(REGEX MATCHALL "${GDK_MATH_CALL_PATTERN}" GDK_MATH_CALL_RELOCATIONS "${GDK_MATH_CODE}")
+
+    set(GDK_MATH_CALLS "")
+
+    foreach(GDK_MATH_RELOCATION ${GDK_MATH_CALL_RELOCATIONS})
+        string(REGEX REPLACE "^.*\t" "" GDK_MATH_CALLEE "${GDK_MATH_RELOCATION}")
+        string(REGEX REPLACE "@.*$" "" GDK_MATH_CALLEE "${GDK_MATH_CALLEE}")
+
+        list(APPEND GDK_MATH_CALLS "${GDK_MATH_CALLEE}")
+    endforeach()
+
+    if (GDK_MATH_CALLS)
+        list(REMOVE_DUPLICATES GDK_MATH_CALLS)
+        string(REPLACE ";" ", " GDK_MATH_CALL_SUMMARY "${GDK_MATH_CALLS}")
+    else()
+        set(GDK_MATH_CALL_SUMMARY "none")
+    endif()
+
+    if (GDK_MATH_PACKED)
+        set(GDK_MATH_PACKED_SUMMARY "packed")
+    else()
+        set(GDK_MATH_PACKED_SUMMARY "scalar")
+    endif()
+
+    message(STATUS "${LABEL} ${GDK_MATH_KERNEL}: ${GDK_MATH_INSTRUCTION_COUNT} instructions, "
+        "${GDK_MATH_PACKED_SUMMARY}, calls: ${GDK_MATH_CALL_SUMMARY}")
+
+    if (GDK_MATH_INSTRUCTION_COUNT GREATER ${GDK_MATH_KERNEL}_MAX_INSTRUCTIONS)
+        list(APPEND GDK_MATH_FAILURES "${GDK_MATH_KERNEL}: ${GDK_MATH_INSTRUCTION_COUNT} instructions, "
+            "more than ${${GDK_MATH_KERNEL}_MAX_INSTRUCTIONS}")
+    endif()
+
+    list(FIND ${GDK_MATH_KERNEL}_PACKED "${LEVEL}" GDK_MATH_PACKED_EXPECTED)
+
+    if (NOT GDK_MATH_PACKED_EXPECTED EQUAL -1 AND NOT GDK_MATH_PACKED)
+        list(APPEND GDK_MATH_FAILURES "${GDK_MATH_KERNEL}: no packed SIMD arithmetic: no longer vectorized")
+    endif()
+
+    foreach(GDK_MATH_CALLEE ${GDK_MATH_CALLS})
+        if (GDK_MATH_CALLEE MATCHES "${GDK_MATH_THROW_PATTERN}")
+            list(APPEND GDK_MATH_FAILURES "${GDK_MATH_KERNEL}: has a throwing path, through ${GDK_MATH_CALLEE}")
+        elseif (NOT GDK_MATH_CALLEE IN_LIST ${GDK_MATH_KERNEL}_CALLS)
+            list(APPEND GDK_MATH_FAILURES "${GDK_MATH_KERNEL}: calls ${GDK_MATH_CALLEE}")
+        endif()
+    endforeach()
+endforeach()
+
+if (GDK_MATH_FAILURES)
+    string(REPLACE ";" "\n  " GDK_MATH_FAILURES "${GDK_MATH_FAILURES}")
+
+    message(FATAL_ERROR "gdk-math codegen ${LABEL}: the generated code no longer meets expectations\n"
+        "  ${GDK_MATH_FAILURES}\nsee ${OUTPUT_DIRECTORY}/${LABEL}/")
+endif()
@@ -0,0 +1,191 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file what including and instantiating the headers costs a build
+///
+/// Every header is included alone in a generated translation unit, which is preprocessed and then
+/// compiled; each type is then explicitly instantiated for float and for double, which compiles every
+/// member, and the cost over including its header alone is reported beside the total. Last, a
+/// translation unit that uses the common types as a game's would is compiled twice: instantiating
+/// everything itself, and with GDK_MATH_EXTERN_TEMPLATES, as a consumer of gdkmath_templates would.
+/// The two are expected to be within noise of each other: see gdk/extern_templates.h.
+///
+/// Each timing is of one run of the compiler this bench was built with, at -O2, so it includes the
+/// compiler's start up. Every row also carries the time in ms, and the preprocess rows the lines the
+/// preprocessor produced. The default 15 samples take some minutes; --samples=3 gives a quick look.
+///
+/// usage: gdkmath_compile_time_<backend> and any option of the bench
+
+#include "harness.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace gdk::bench;
+
+#ifndef GDK_MATH_BENCH_COMPILER
+#error GDK_MATH_BENCH_COMPILER must name the compiler to time
+#endif
+
+namespace {
+    //! the flags of every compile: the standard, the level, and the include directories
+    const std::string FLAGS = std::string("-std=c++17 -O2 -I\"") + GDK_MATH_BENCH_INCLUDE_DIRECTORY
+        + "\" -I\"" + GDK_MATH_BENCH_BACKEND_DIRECTORY + "\"";
+
+    //! the class templates, each declared in the header of the same name
+    const char *const TYPES[] = {
+        "aabb", "matrix3x3", "matrix4x4", "obb", "quaternion", "sphere",
+        "spatial_hash_grid", "sweep_and_prune", "vector2", "vector3", "vector4"
+    };
+
+    //! a translation unit that uses the common types for float, as a game's source file might
+    const char *const TYPICAL_SOURCE = R"(#include <gdk/math.h>
+
+float typical(const float aTime) {
+    using namespace gdk;
+
+    const auto rotation = quaternion<float>::from_angle_axis(aTime, vector3<float>::up);
+
+    matrix4x4<float> model;
+    model.set_rotation_and_scale(slerp(quaternion<float>::identity, rotation, 0.5f), vector3<float>::one);
+    model.set_translation({1, 2, 3});
+
+    auto view = model;
+    view.inverse_affine();
+
+    const auto point = view * (model * vector3<float>(aTime, 0, 0));
+    const auto bounds = aabb<float>::from_center(point, vector3<float>::one).merged(vector3<float>::zero);
+
+    return point.normal().length() + bounds.surface_area() + rotation.to_euler().y + model.rotation().w;
+}
+)";
+
+    //! a file in the work directory, named for a benchmark
+    std::string path(const std::string &aSuite, const std::string &aName, const char *const aExtension) {
+        auto name = aSuite + "_" + aName;
+
+        for (auto &c : name) if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.') c = '_';
+
+        return std::string(GDK_MATH_BENCH_WORK_DIRECTORY) + "/" + name + aExtension;
+    }
+
+    void write_file(const std::string &aPath, const std::string &aText) {
+        std::ofstream file(aPath, std::ios::binary);
+
+        if (!(file << aText)) throw std::runtime_error("cannot write " + aPath);
+    }
+
+    //! run the compiler with aArguments, throwing if it fails
+    void compile(const std::string &aArguments) {
+        const auto command = std::string("\"") + GDK_MATH_BENCH_COMPILER + "\" " + FLAGS + " " + aArguments;
+
+        if (std::system(command.c_str()) != 0) throw std::runtime_error("failed: " + command);
+    }
+
+    std::size_t count_lines(const std::string &aPath) {
+        std::ifstream file(aPath, std::ios::binary);
+
+        std::size_t lines = 0;
+
+        for (std::string line; std::getline(file, line);) ++lines;
+
+        return lines;
+    }
+
+    //! aSource, compiled to an object, once per sample; null when filtered out
+    result *time_compile(harness &aHarness, const std::string &aSuite, const std::string &aName,
+        const std::string &aSource, const std::string &aDefines = "") {
+        const auto source = path(aSuite, aName, ".cpp");
+        const auto object = path(aSuite, aName, ".o");
+
+        write_file(source, aSource);
+
+        auto *const r = aHarness.measure(aSuite, aName, mode::latency, 1, 0, [&] {
+            compile(aDefines + "-c \"" + source + "\" -o \"" + object + "\"");
+        });
+
+        if (r) r->metrics.emplace_back("ms", r->nanoseconds.median / 1e6);
+
+        return r;
+    }
+
+    std::vector<std::string> split(const std::string &aList) {
+        std::vector<std::string> items;
+
+        for (std::size_t begin = 0; begin <= aList.size();) {
+            const auto end = std::min(aList.find(',', begin), aList.size());
+
+            if (end > begin) items.push_back(aList.substr(begin, end - begin));
+
+            begin = end + 1;
+        }
+
+        return items;
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        harness h(options::parse(argc, argv));
+
+        const auto headers = split(GDK_MATH_BENCH_HEADERS);
+
+        for (const auto &header : headers) {
+            const auto source = path("preprocess", header, ".cpp");
+            const auto output = path("preprocess", header, ".i");
+
+            write_file(source, "#include <gdk/" + header + ">\n");
+
+            if (auto *const r = h.measure("preprocess", header, mode::latency, 1, 0, [&] {
+                compile("-E \"" + source + "\" -o \"" + output + "\"");
+            })) {
+                r->metrics.emplace_back("ms", r->nanoseconds.median / 1e6);
+                r->metrics.emplace_back("lines", static_cast<double>(count_lines(output)));
+            }
+        }
+
+        // the median compile of each header alone, to take from its instantiations
+        std::map<std::string, double> includeTimes;
+
+        for (const auto &header : headers)
+            if (auto *const r = time_compile(h, "include", header, "#include <gdk/" + header + ">\n"))
+                includeTimes[header] = r->nanoseconds.median;
+
+        for (const auto type : TYPES) {
+            const std::string header = std::string(type) + ".h";
+
+            for (const auto component : {"float", "double"}) {
+                const auto name = std::string(type) + "<" + component + ">";
+
+                auto *const r = time_compile(h, "instantiate", name, "#include <gdk/" + header + ">\n\n"
+                    "GDK_MATH_BEGIN_NAMESPACE\n    template class " + name + ";\nGDK_MATH_END_NAMESPACE\n");
+
+                const auto included = includeTimes.find(header);
+
+                if (r && included != includeTimes.end())
+                    r->metrics.emplace_back("over_include_ms", (r->nanoseconds.median - included->second) / 1e6);
+            }
+        }
+
+        time_compile(h, "typical translation unit", "instantiated", TYPICAL_SOURCE);
+        time_compile(h, "typical translation unit", "extern templates", TYPICAL_SOURCE,
+            "-DGDK_MATH_EXTERN_TEMPLATES ");
+
+        h.write();
+
+        if (h.regressions()) return 1;
+    }
+    catch (const std::exception &e) {
+        std::fprintf(stderr, "gdkmath compile_time: %s\n", e.what());
+
+        return 1;
+    }
+}
@@ -0,0 +1,379 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file differential testing of every backend against impl/std, with the timing of each.
+///
+/// Every backend linked in (one object per impl/ directory, see differential_backend.cpp) is fed the
+/// same inputs: a random set per kernel and the edge cases where backends tend to part ways, such as
+/// zero and tiny vectors, near singular and mirrored matrices, near parallel and opposite quaternions,
+/// and gimbal lock. Each output is compared to impl/std's output for the same input. A row reports
+/// the backend's time per element, the number of outputs outside TOLERANCE and the largest relative
+/// difference seen. Each disagreement is written to stderr with its input, and the exit status is 1
+/// if there were any.
+///
+/// usage: gdkmath_differential [seed] with any option of the bench
+
+#include "differential.h"
+#include "harness.h"
+
+#include <gdk/math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace gdk;
+using namespace gdk::bench;
+
+namespace {
+    using vec3 = vector3<float>;
+    using quat = quaternion<float>;
+    using mat4 = matrix4x4<float>;
+
+    //! the backend every other is compared against
+    constexpr const char *REFERENCE = "std";
+
+    //! size of the random input set of every kernel
+    constexpr std::size_t RANDOM_INPUTS = std::size_t(1) << 14;
+
+    //! largest difference, relative to the magnitude of the reference output (or absolute below 1),
+    /// that counts as agreement
+    constexpr double TOLERANCE = 1e-4;
+
+    //! at most this many disagreements are written out per kernel and backend
+    constexpr std::size_t REPORTED_MISMATCHES = 8;
+
+    template<typename value_type>
+    void append(std::vector<float> &aOut, const value_type &aValue) {
+        const auto components = to_components(aValue);
+
+        aOut.insert(aOut.end(), components.begin(), components.end());
+    }
+
+    void append(std::vector<float> &aOut, const float aValue) { aOut.push_back(aValue); }
+
+    //! one element of a kernel's input
+    template<typename... value_types>
+    void element(std::vector<float> &aOut, const value_types &...aValues) { (append(aOut, aValues), ...); }
+
+    class inputs final {
+    public:
+        explicit inputs(const std::uint32_t aSeed) : m_Rng(aSeed) {}
+
+        float next() { return m_Rng.next(); }
+
+        vec3 vector() { return vec3(next(), next(), next()) * 100.0f; }
+
+        quat rotation() { return quat::from_euler(vec3(next(), next(), next()) * numbers::pi_f); }
+
+        //! an affine transform; an uneven scale leaves it near singular, a negative one mirrors it
+        mat4 transform(const vec3 &aScale) { return mat4(vector(), rotation(), aScale); }
+
+        mat4 transform() {
+            return transform(vec3(next(), next(), next()) * 2.0f + vec3(2.5f * (next() < 0 ? -1.0f : 1.0f)));
+        }
+
+        //! the edge cases of vectors: zero, either side of the effectively zero length, huge
+        std::vector<vec3> extreme_vectors() {
+            std::vector<vec3> out = {vec3::zero, vec3(1e-30f), vec3(1e-20f, 0, 0), vec3(0, 1e-3f, 0),
+                vec3(0, 0, -1e3f), vec3(1e18f), vec3(-1e20f, 1, 1)};
+
+            for (int i = 0; i < 64; ++i) out.push_back(vector() * 1e-6f);
+
+            return out;
+        }
+
+        //! transforms that are near singular, mirrored, or both
+        std::vector<mat4> extreme_transforms() {
+            std::vector<mat4> out;
+
+            for (int i = 0; i < 64; ++i) {
+                out.push_back(transform(vec3(1e-3f)));
+                out.push_back(transform(vec3(1, 1, 1e-5f)));
+                out.push_back(transform(vec3(1e4f, 1, 1e-3f)));
+                out.push_back(transform(vec3(-1, 1, 1)));
+                out.push_back(transform(vec3(1, -1e-3f, 1)));
+            }
+
+            return out;
+        }
+
+        //! pairs either side of slerp's hand over to linear interpolation, and near opposite pairs
+        std::vector<std::pair<quat, quat>> extreme_pairs() {
+            std::vector<std::pair<quat, quat>> out;
+
+            for (int i = 0; i < 64; ++i) {
+                const auto a = rotation();
+                const auto axis = vec3(next(), 1, next()).normal();
+
+                for (const auto angle : {0.0f, 1e-6f, 0.0632f, 0.0633f, 1e-2f}) {
+                    const auto b = quat::from_angle_axis(angle, axis) * a;
+
+                    out.emplace_back(a, b);
+                    out.emplace_back(a, -b);
+                }
+            }
+
+            return out;
+        }
+
+        //! euler angles a few ulps from the poles
+        vec3 near_gimbal_lock() {
+            auto pitch = numbers::pi_f / 2;
+
+            for (auto steps = static_cast<int>((next() + 1) * 8); steps > 0; --steps)
+                pitch = std::nextafter(pitch, 0.0f);
+
+            return vec3(next() < 0 ? -pitch : pitch, next() * numbers::pi_f, next() * numbers::pi_f);
+        }
+
+    private:
+        random_source m_Rng;
+    };
+
+    //! the inputs of each kernel, flattened
+    std::map<std::string, std::function<std::vector<float>(inputs &)>> generators() {
+        const auto vectors = [](inputs &aInputs) {
+            std::vector<float> out;
+
+            for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.vector());
+            for (const auto &v : aInputs.extreme_vectors()) element(out, v);
+
+            return out;
+        };
+
+        const auto transforms = [](inputs &aInputs) {
+            std::vector<float> out;
+
+            for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.transform());
+            for (const auto &m : aInputs.extreme_transforms()) element(out, m);
+
+            return out;
+        };
+
+        const auto interpolations = [](inputs &aInputs) {
+            std::vector<float> out;
+
+            for (std::size_t i = 0; i < RANDOM_INPUTS; ++i)
+                element(out, aInputs.rotation(), aInputs.rotation(), (aInputs.next() + 1) / 2);
+
+            for (const auto &pair : aInputs.extreme_pairs())
+                for (const auto t : {0.0f, 0.5f, 1.0f}) element(out, pair.first, pair.second, t);
+
+            return out;
+        };
+
+        return {
+            {"normal", vectors},
+            {"length", vectors},
+            {"transform point", [](inputs &aInputs) {
+                std::vector<float> out;
+
+                for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.transform(), aInputs.vector());
+                for (const auto &m : aInputs.extreme_transforms()) element(out, m, aInputs.vector());
+
+                return out;
+            }},
+            {"matrix4x4 compose", [](inputs &aInputs) {
+                std::vector<float> out;
+
+                for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.transform(), aInputs.transform());
+                for (const auto &m : aInputs.extreme_transforms()) element(out, m, aInputs.transform());
+
+                return out;
+            }},
+            {"inverse", transforms},
+            {"inverse_affine", transforms},
+            {"rotation", [](inputs &aInputs) {
+                std::vector<float> out;
+
+                for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.transform(vec3::one));
+
+                // half turns, where the trace is near -1
+                for (int i = 0; i < 256; ++i) {
+                    mat4 m;
+                    m.set_rotation_and_scale(quat::from_angle_axis(numbers::pi_f - std::fabs(aInputs.next()) * 1e-3f,
+                        vec3(aInputs.next(), aInputs.next(), aInputs.next()).normal()), vec3::one);
+
+                    element(out, m);
+                }
+
+                return out;
+            }},
+            {"slerp", interpolations},
+            {"nlerp", interpolations},
+            {"from_euler", [](inputs &aInputs) {
+                std::vector<float> out;
+
+                for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.vector() * 0.01f * numbers::pi_f);
+                for (int i = 0; i < 256; ++i) element(out, aInputs.near_gimbal_lock());
+
+                return out;
+            }},
+            {"to_euler", [](inputs &aInputs) {
+                std::vector<float> out;
+
+                for (std::size_t i = 0; i < RANDOM_INPUTS; ++i) element(out, aInputs.rotation());
+                for (int i = 0; i < 256; ++i) element(out, quat::from_euler(aInputs.near_gimbal_lock()));
+
+                return out;
+            }}};
+    }
+
+    //! the difference between two outputs of one element, relative to the reference's magnitude, or
+    /// absolute below 1. Non-finite outputs agree only where both are non-finite.
+    double difference(const float *const aOutput, const float *const aReference, const std::size_t aSize,
+        const comparison aComparison) {
+        const auto measure = [&](const float aSign) {
+            double error = 0, magnitude = 0;
+
+            for (std::size_t i = 0; i < aSize; ++i) {
+                const double a = aSign * aOutput[i], b = aReference[i];
+
+                if (!std::isfinite(a) || !std::isfinite(b)) {
+                    if (std::isfinite(a) != std::isfinite(b)) return HUGE_VAL;
+
+                    continue;
+                }
+
+                auto d = a - b;
+
+                if (aComparison == comparison::angles) d = std::remainder(d, 2 * numbers::pi);
+
+                error += d * d;
+                magnitude += b * b;
+            }
+
+            return std::sqrt(error) / std::max(1.0, std::sqrt(magnitude));
+        };
+
+        return aComparison == comparison::rotation ? std::min(measure(1), measure(-1)) : measure(1);
+    }
+
+    void report_mismatch(const backend &aBackend, const kernel &aKernel, const float *const aInput,
+        const float *const aOutput, const float *const aReference) {
+        const auto list = [](const float *const aValues, const std::size_t aSize) {
+            std::string out;
+
+            for (std::size_t i = 0; i < aSize; ++i) {
+                char value[32];
+                std::snprintf(value, sizeof(value), "%s%.9g", i ? " " : "", aValues[i]);
+
+                out += value;
+            }
+
+            return out;
+        };
+
+        std::fprintf(stderr, "%s %s disagrees with %s\n  input     %s\n  output    %s\n  reference %s\n",
+            aBackend.name.c_str(), aKernel.name, REFERENCE, list(aInput, aKernel.inputs).c_str(),
+            list(aOutput, aKernel.outputs).c_str(), list(aReference, aKernel.outputs).c_str());
+    }
+
+    const kernel *find(const backend &aBackend, const std::string &aName) {
+        for (const auto &k : aBackend.kernels) if (aName == k.name) return &k;
+
+        return nullptr;
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        harness h(options::parse(argc, argv));
+
+        const auto &all = backends();
+
+        const auto reference = std::find_if(all.begin(), all.end(),
+            [](const backend &b) { return b.name == REFERENCE; });
+
+        if (reference == all.end())
+            throw std::runtime_error(std::string("the reference backend is not linked in: ") + REFERENCE);
+
+        std::size_t mismatches = 0;
+
+        for (const auto &[name, generate] : generators()) {
+            const auto *const referenceKernel = find(*reference, name);
+
+            if (!referenceKernel) throw std::runtime_error("the reference backend has no kernel " + name);
+
+            inputs source(h.config().seed);
+
+            const auto in = generate(source);
+            const auto count = in.size() / referenceKernel->inputs;
+
+            std::vector<float> expected(count * referenceKernel->outputs);
+            referenceKernel->run(in.data(), expected.data(), count);
+
+            for (const auto &b : all) {
+                const auto *const k = find(b, name);
+
+                if (!k) {
+                    std::fprintf(stderr, "%s has no kernel %s: skipped\n", b.name.c_str(), name.c_str());
+
+                    continue;
+                }
+
+                std::vector<float> out(expected.size());
+
+                auto *const timing = h.measure(name, b.name, mode::throughput, count,
+                    count * (k->inputs + k->outputs) * sizeof(float), [&] {
+                        k->run(in.data(), out.data(), count);
+
+                        escape(out);
+                    });
+
+                // a filtered out kernel is neither timed nor checked
+                if (!timing) continue;
+
+                std::size_t disagreements = 0;
+                double worst = 0;
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto *const output = out.data() + i * k->outputs;
+                    const auto *const wanted = expected.data() + i * k->outputs;
+
+                    const auto d = difference(output, wanted, k->outputs, k->comparison);
+
+                    worst = std::max(worst, d);
+
+                    if (d <= TOLERANCE) continue;
+
+                    if (disagreements++ < REPORTED_MISMATCHES)
+                        report_mismatch(b, *k, in.data() + i * k->inputs, output, wanted);
+                }
+
+                timing->metrics.emplace_back("mismatches", static_cast<double>(disagreements));
+                timing->metrics.emplace_back("max_difference", worst);
+
+                mismatches += disagreements;
+
+                if (std::isfinite(out.front())) h.sink += out.front();
+            }
+        }
+
+        h.write();
+
+        if (mismatches) {
+            std::fprintf(stderr, "gdkmath differential: %zu outputs disagree with %s\n", mismatches, REFERENCE);
+
+            return 1;
+        }
+
+        if (h.regressions()) return 1;
+    }
+    catch (const std::exception &e) {
+        std::fprintf(stderr, "gdkmath differential: %s\n", e.what());
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_BENCH_DIFFERENTIAL_H
+#define GDK_MATH_BENCH_DIFFERENTIAL_H
+
+/// \file the interface between the differential harness and the backends linked into it.
+///
+/// Each backend is compiled into its own object, under its own gdk::backend namespace (see
+/// gdk/backend.h), so two backends' definitions of the same member never meet at link time. Nothing of
+/// gdk crosses between the objects: every kernel reads and writes flat arrays of floats, in the order
+/// of gdk/components.h.
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gdk {
+    namespace bench {
+        //! how two backends' outputs of a kernel are compared
+        enum class comparison {
+            //! component by component
+            components,
+            //! quaternions: q and -q are the same rotation
+            rotation,
+            //! angles in radians: the difference is wrapped to [-pi, pi]
+            angles
+        };
+
+        //! one operation of a backend, over a batch
+        struct kernel final {
+            const char *name;
+
+            //! floats read and written per element, each value in the order of its component_layout
+            std::size_t inputs, outputs;
+
+            bench::comparison comparison;
+
+            //! map aCount elements of aIn to aOut
+            void (*run)(const float *aIn, float *aOut, std::size_t aCount);
+        };
+
+        struct backend final {
+            std::string name;
+            std::vector<kernel> kernels;
+        };
+
+        //! every backend linked into this process, each added by its object's static initializer
+        inline std::vector<backend> &backends() {
+            static std::vector<backend> instance;
+
+            return instance;
+        }
+
+        //! add a backend. Returns true, to initialize a static with.
+        inline bool register_backend(backend aBackend) {
+            auto &all = backends();
+
+            all.push_back(std::move(aBackend));
+
+            // static initialization order across objects is unspecified; sort so runs are repeatable
+            std::sort(all.begin(), all.end(), [](const backend &a, const backend &b) { return a.name < b.name; });
+
+            return true;
+        }
+    }
+}
+
+#endif
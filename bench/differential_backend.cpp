@@ -0,0 +1,101 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file one backend's kernels for the differential harness.
+///
+/// Compiled once per backend, with that backend's impl/ directory on the include path and
+/// GDK_MATH_BACKEND_NAMESPACE naming it (see gdk/backend.h), so each backend's instantiations are
+/// distinct symbols rather than one definition silently chosen by the linker for all of them.
+
+#include "differential.h"
+
+#ifndef GDK_MATH_BACKEND_NAMESPACE
+#error "GDK_MATH_BACKEND_NAMESPACE must name a namespace for this backend"
+#endif
+
+#ifndef GDK_MATH_BENCH_BACKEND
+#error "GDK_MATH_BENCH_BACKEND must name this backend"
+#endif
+
+#include <gdk/math.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace {
+    namespace backend = gdk::backend::GDK_MATH_BACKEND_NAMESPACE;
+
+    using vec3 = backend::vector3<float>;
+    using quat = backend::quaternion<float>;
+    using mat4 = backend::matrix4x4<float>;
+
+    template<typename value_type>
+    value_type load(const float *const aIn) {
+        std::array<float, backend::component_layout<value_type>::size> components;
+        std::copy_n(aIn, components.size(), components.begin());
+
+        return backend::from_components<value_type>(components);
+    }
+
+    template<typename value_type>
+    void store(const value_type &aValue, float *const aOut) {
+        const auto components = backend::to_components(aValue);
+
+        std::copy(components.begin(), components.end(), aOut);
+    }
+
+    void normal(const float *const aIn, float *const aOut) { store(load<vec3>(aIn).normal(), aOut); }
+
+    void length(const float *const aIn, float *const aOut) { aOut[0] = load<vec3>(aIn).length(); }
+
+    void transform_point(const float *const aIn, float *const aOut) {
+        store(load<mat4>(aIn) * load<vec3>(aIn + 16), aOut);
+    }
+
+    void compose(const float *const aIn, float *const aOut) {
+        store(load<mat4>(aIn) * load<mat4>(aIn + 16), aOut);
+    }
+
+    void inverse(const float *const aIn, float *const aOut) { store(load<mat4>(aIn).inversed(), aOut); }
+
+    void inverse_affine(const float *const aIn, float *const aOut) {
+        auto m = load<mat4>(aIn);
+        m.inverse_affine();
+
+        store(m, aOut);
+    }
+
+    void rotation(const float *const aIn, float *const aOut) { store(load<mat4>(aIn).rotation(), aOut); }
+
+    void slerp(const float *const aIn, float *const aOut) {
+        store(backend::slerp(load<quat>(aIn), load<quat>(aIn + 4), aIn[8]), aOut);
+    }
+
+    void nlerp(const float *const aIn, float *const aOut) {
+        store(backend::nlerp(load<quat>(aIn), load<quat>(aIn + 4), aIn[8]), aOut);
+    }
+
+    void from_euler(const float *const aIn, float *const aOut) { store(quat::from_euler(load<vec3>(aIn)), aOut); }
+
+    void to_euler(const float *const aIn, float *const aOut) { store(load<quat>(aIn).to_euler(), aOut); }
+
+    template<void (*element)(const float *, float *), std::size_t inputs, std::size_t outputs>
+    void batch(const float *const aIn, float *const aOut, const std::size_t aCount) {
+        for (std::size_t i = 0; i < aCount; ++i) element(aIn + i * inputs, aOut + i * outputs);
+    }
+
+    using gdk::bench::comparison;
+
+    [[maybe_unused]] const bool registered = gdk::bench::register_backend({GDK_MATH_BENCH_BACKEND, {
+        {"normal", 3, 3, comparison::components, batch<normal, 3, 3>},
+        {"length", 3, 1, comparison::components, batch<length, 3, 1>},
+        {"transform point", 19, 3, comparison::components, batch<transform_point, 19, 3>},
+        {"matrix4x4 compose", 32, 16, comparison::components, batch<compose, 32, 16>},
+        {"inverse", 16, 16, comparison::components, batch<inverse, 16, 16>},
+        {"inverse_affine", 16, 16, comparison::components, batch<inverse_affine, 16, 16>},
+        {"rotation", 16, 4, comparison::rotation, batch<rotation, 16, 4>},
+        {"slerp", 9, 4, comparison::rotation, batch<slerp, 9, 4>},
+        {"nlerp", 9, 4, comparison::rotation, batch<nlerp, 9, 4>},
+        {"from_euler", 3, 4, comparison::rotation, batch<from_euler, 3, 4>},
+        {"to_euler", 4, 3, comparison::angles, batch<to_euler, 4, 3>}}});
+}
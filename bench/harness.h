@@ -0,0 +1,542 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_BENCH_HARNESS_H
+#define GDK_MATH_BENCH_HARNESS_H
+
+/// \file the measuring, statistics and reporting shared by the bench executables.
+///
+/// A benchmark is a body that performs a known number of operations. The harness runs it once to
+/// warm up, then times it once per sample, and reports nanoseconds per operation as min, median,
+/// mean and high percentiles. Where hardware counters can be read, each result also carries cycles,
+/// instructions, cache and branch misses per operation, and instructions per cycle. Results print
+/// as a table, or as JSON or CSV for comparing runs. Given the JSON of an earlier run as a
+/// --baseline, each result is compared to it, and regressions fail the run (see baseline.h).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "baseline.h"
+#include "perf_counters.h"
+#include "../test/random_source.h"
+
+#include <memory>
+
+#ifndef GDK_MATH_BENCH_BACKEND
+#define GDK_MATH_BENCH_BACKEND "unknown"
+#endif
+
+namespace gdk {
+    namespace bench {
+        //! forces every prior write to memory to happen
+        inline void clobber() { asm volatile("" : : : "memory"); }
+
+        //! makes aValue observable, so the work that produced it cannot be discarded
+        template<typename value_type>
+        inline void escape(value_type &aValue) { asm volatile("" : : "g"(&aValue) : "memory"); }
+
+        using testing::random_source;
+
+        //! how a benchmark's operations depend on one another
+        enum class mode {
+            //! independent operations, free to overlap in the pipeline: the cost of one in a batch
+            throughput,
+            //! each operation consumes the result of the one before: the cost of one on its own
+            latency
+        };
+
+        inline const char *to_string(const mode aMode) {
+            return aMode == mode::throughput ? "throughput" : "latency";
+        }
+
+        //! a distribution of nanoseconds per operation, one value per sample
+        struct statistics final {
+            double min = 0, median = 0, mean = 0, p90 = 0, p99 = 0;
+
+            //! nearest-rank percentiles of aSamples, which is sorted in place
+            static statistics of(std::vector<double> &aSamples) {
+                statistics s;
+
+                if (aSamples.empty()) return s;
+
+                std::sort(aSamples.begin(), aSamples.end());
+
+                const auto rank = [&](const double aPercentile) {
+                    const auto index = static_cast<std::size_t>(std::ceil(aPercentile * aSamples.size()));
+
+                    return aSamples[std::min(aSamples.size(), std::max<std::size_t>(index, 1)) - 1];
+                };
+
+                s.min = aSamples.front();
+                s.median = rank(0.5);
+                s.p90 = rank(0.9);
+                s.p99 = rank(0.99);
+
+                for (const auto sample : aSamples) s.mean += sample;
+
+                s.mean /= static_cast<double>(aSamples.size());
+
+                return s;
+            }
+        };
+
+        struct result final {
+            std::string suite;
+            std::string name;
+            bench::mode mode = mode::throughput;
+
+            //! operations performed by one sample
+            std::size_t operations = 0;
+
+            //! bytes one sample reads and writes, or zero when that is not the point of the benchmark
+            std::size_t bytes = 0;
+
+            std::size_t samples = 0;
+
+            //! nanoseconds per operation
+            statistics nanoseconds;
+
+            //! further named measurements that some benchmarks add, each reported as its own column
+            std::vector<std::pair<std::string, double>> metrics;
+        };
+
+        enum class format { text, json, csv };
+
+        struct options final {
+            std::uint32_t seed = 12345u;
+
+            //! timed runs per benchmark, after one untimed warm up
+            std::size_t samples = 15;
+
+            //! only benchmarks whose "suite/name" contains this run
+            std::string filter;
+
+            format output_format = format::text;
+
+            //! where results go; stdout when empty
+            std::string output_path;
+
+            //! recorded with the results, to tell runs apart: a commit, a machine, a compiler flag
+            std::string label;
+
+            //! read hardware counters where the machine allows it
+            bool counters = true;
+
+            //! the smallest and largest working sets of the benchmarks that sweep across sizes
+            std::size_t min_bytes = std::size_t(1) << 10;
+            std::size_t max_bytes = std::size_t(1) << 30;
+
+            //! the JSON output of an earlier run to compare against; none when empty
+            std::string baseline_path;
+
+            //! the slowdown a result may show against the baseline, beyond noise, before it fails: 0.05 is 5%
+            double threshold = 0.05;
+
+            //! how many more times a benchmark that looks regressed is measured before it is believed
+            std::size_t retries = 2;
+
+            //! the most threads a benchmark that scales across threads uses; zero for one per hardware thread
+            std::size_t threads = 0;
+
+            //! --seed=N --samples=N --filter=S --format=text|json|csv --output=PATH --label=S
+            /// --counters=on|off --min-bytes=N --max-bytes=N --baseline=PATH --threshold=PERCENT
+            /// --retries=N --threads=N, where a byte count N may end in k, m or g. A bare number is taken
+            /// as the seed, as the bench has always accepted. Throws on anything else.
+            static options parse(const int argc, const char *const *const argv) {
+                options o;
+
+                for (int i = 1; i < argc; ++i) {
+                    const std::string argument(argv[i]);
+                    const auto split = argument.find('=');
+                    const auto flag = argument.substr(0, split);
+                    const auto value = split == std::string::npos ? std::string() : argument.substr(split + 1);
+
+                    if (flag == "--seed") o.seed = static_cast<std::uint32_t>(std::stoul(value));
+                    else if (flag == "--samples") o.samples = std::max<std::size_t>(1, std::stoul(value));
+                    else if (flag == "--filter") o.filter = value;
+                    else if (flag == "--output") o.output_path = value;
+                    else if (flag == "--label") o.label = value;
+                    else if (flag == "--min-bytes") o.min_bytes = parse_bytes(value);
+                    else if (flag == "--max-bytes") o.max_bytes = parse_bytes(value);
+                    else if (flag == "--baseline") o.baseline_path = value;
+                    else if (flag == "--threshold") o.threshold = std::stod(value) / 100;
+                    else if (flag == "--retries") o.retries = std::stoul(value);
+                    else if (flag == "--threads") o.threads = std::stoul(value);
+                    else if (flag == "--counters") {
+                        if (value == "on") o.counters = true;
+                        else if (value == "off") o.counters = false;
+                        else throw std::invalid_argument("--counters takes on or off, not " + value);
+                    }
+                    else if (flag == "--format") {
+                        if (value == "text") o.output_format = format::text;
+                        else if (value == "json") o.output_format = format::json;
+                        else if (value == "csv") o.output_format = format::csv;
+                        else throw std::invalid_argument("unknown format: " + value);
+                    }
+                    else if (!argument.empty() && argument.find_first_not_of("0123456789") == std::string::npos)
+                        o.seed = static_cast<std::uint32_t>(std::stoul(argument));
+                    else throw std::invalid_argument("unknown argument: " + argument);
+                }
+
+                return o;
+            }
+
+            //! a count of bytes, with an optional binary k, m or g suffix
+            static std::size_t parse_bytes(const std::string &aText) {
+                std::size_t end = 0;
+                const auto number = std::stoull(aText, &end);
+
+                if (end == aText.size()) return static_cast<std::size_t>(number);
+
+                if (end + 1 == aText.size()) switch (aText[end]) {
+                    case 'k': case 'K': return static_cast<std::size_t>(number << 10);
+                    case 'm': case 'M': return static_cast<std::size_t>(number << 20);
+                    case 'g': case 'G': return static_cast<std::size_t>(number << 30);
+                }
+
+                throw std::invalid_argument("not a byte count: " + aText);
+            }
+        };
+
+        class harness final {
+        public:
+            //! accumulates results, so that no benchmark's work can be discarded as unused
+            double sink = 0;
+
+            //! throws if a baseline is given that cannot be read
+            explicit harness(options aOptions)
+            : m_Options(std::move(aOptions)) {
+                if (!m_Options.baseline_path.empty())
+                    m_Baseline = std::make_unique<baseline>(baseline::load(m_Options.baseline_path));
+
+                if (m_Options.counters) {
+                    m_Counters = std::make_unique<perf_counters>();
+
+                    if (!m_Counters->available()) m_Counters.reset();
+                }
+            }
+
+            //! whether results carry hardware counters
+            [[nodiscard]] bool counting() const { return m_Counters != nullptr; }
+
+            [[nodiscard]] const bench::options &config() const { return m_Options; }
+
+            [[nodiscard]] const std::vector<result> &results() const { return m_Results; }
+
+            //! whether a benchmark passes the filter
+            [[nodiscard]] bool enabled(const std::string &aSuite, const std::string &aName) const {
+                return m_Options.filter.empty() || (aSuite + "/" + aName).find(m_Options.filter) != std::string::npos;
+            }
+
+            //! time aBody, which performs aOperations operations each call, and record the result. A
+            /// result that looks regressed against the baseline is measured again, up to retries times,
+            /// and the fastest attempt kept.
+            template<typename body_type>
+            result *measure(const std::string &aSuite, const std::string &aName, const mode aMode,
+                const std::size_t aOperations, const std::size_t aBytes, body_type &&aBody) {
+                if (!enabled(aSuite, aName)) return nullptr;
+
+                aBody();
+                clobber();
+
+                auto r = sample(aSuite, aName, aMode, aOperations, aBytes, aBody);
+
+                for (std::size_t retry = 0; retry < m_Options.retries && judge(r).regressed(); ++retry) {
+                    auto again = sample(aSuite, aName, aMode, aOperations, aBytes, aBody);
+
+                    if (again.nanoseconds.min < r.nanoseconds.min) r = std::move(again);
+                }
+
+                m_Results.push_back(std::move(r));
+
+                return &m_Results.back();
+            }
+
+            //! record a result measured elsewhere
+            void add(result aResult) { m_Results.push_back(std::move(aResult)); }
+
+            //! how many results regressed against the baseline, as of the last write()
+            [[nodiscard]] std::size_t regressions() const { return m_Regressions; }
+
+            //! compare every result to the baseline, if there is one, then write every result in the
+            /// chosen format and list the regressions on stderr. Throws if the output file cannot be opened.
+            void write() {
+                if (m_Baseline) compare_to_baseline();
+
+                std::FILE *const file = m_Options.output_path.empty()
+                    ? stdout : std::fopen(m_Options.output_path.c_str(), "w");
+
+                if (!file) throw std::runtime_error("cannot open " + m_Options.output_path);
+
+                switch (m_Options.output_format) {
+                    case format::text: write_text(file); break;
+                    case format::json: write_json(file); break;
+                    case format::csv: write_csv(file); break;
+                }
+
+                if (file != stdout) std::fclose(file);
+
+                if (m_Baseline) std::fprintf(stderr, "gdk-math bench: %zu of %zu results regressed against %s\n",
+                    m_Regressions, m_Results.size(), m_Options.baseline_path.c_str());
+            }
+
+        private:
+            bench::options m_Options;
+            std::vector<result> m_Results;
+            std::unique_ptr<perf_counters> m_Counters;
+            std::unique_ptr<baseline> m_Baseline;
+            std::size_t m_Regressions = 0;
+
+            //! one timed run of every sample
+            template<typename body_type>
+            result sample(const std::string &aSuite, const std::string &aName, const mode aMode,
+                const std::size_t aOperations, const std::size_t aBytes, body_type &aBody) {
+                std::vector<double> samples;
+                samples.reserve(m_Options.samples);
+
+                if (m_Counters) m_Counters->reset();
+
+                // the counters start before the clock and stop after it, so their system calls are
+                // not timed
+                for (std::size_t s = 0; s < m_Options.samples; ++s) {
+                    if (m_Counters) m_Counters->start();
+
+                    const auto start = std::chrono::steady_clock::now();
+
+                    aBody();
+                    clobber();
+
+                    const auto elapsed = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start).count();
+
+                    if (m_Counters) m_Counters->stop();
+
+                    samples.push_back(elapsed / static_cast<double>(aOperations));
+                }
+
+                result r;
+                r.suite = aSuite;
+                r.name = aName;
+                r.mode = aMode;
+                r.operations = aOperations;
+                r.bytes = aBytes;
+                r.samples = samples.size();
+                r.nanoseconds = statistics::of(samples);
+
+                if (m_Counters) add_counters(r);
+
+                return r;
+            }
+
+            //! how aResult compares to the baseline; never regressed without one, or for a benchmark the
+            /// baseline did not run
+            baseline::verdict judge(const result &aResult) const {
+                const auto *const timing = m_Baseline
+                    ? m_Baseline->find(aResult.suite, aResult.name, to_string(aResult.mode)) : nullptr;
+
+                if (!timing) return {0, 0, 0};
+
+                return baseline::compare(*timing, aResult.nanoseconds.min, aResult.nanoseconds.median,
+                    m_Options.threshold);
+            }
+
+            //! add each result's change against the baseline as metrics, print each regression, and count them
+            void compare_to_baseline() {
+                m_Regressions = 0;
+
+                for (auto &r : m_Results) {
+                    if (!m_Baseline->find(r.suite, r.name, to_string(r.mode))) continue;
+
+                    const auto v = judge(r);
+
+                    r.metrics.emplace_back("baseline_ns", v.baseline);
+                    r.metrics.emplace_back("change_pct", v.change * 100);
+                    r.metrics.emplace_back("allowed_pct", v.allowance * 100);
+
+                    if (!v.regressed()) continue;
+
+                    ++m_Regressions;
+
+                    std::fprintf(stderr, "regressed: %s/%s (%s) %.2f ns, was %.2f ns: %+.1f%%, allowed %.1f%%\n",
+                        r.suite.c_str(), r.name.c_str(), to_string(r.mode), r.nanoseconds.min, v.baseline,
+                        v.change * 100, v.allowance * 100);
+                }
+            }
+
+            //! the counter totals, per operation, and instructions per cycle when both were counted
+            void add_counters(result &aResult) const {
+                const auto operations = static_cast<double>(aResult.operations * aResult.samples);
+
+                double cycles = 0, instructions = 0;
+
+                for (const auto &reading : m_Counters->totals()) {
+                    aResult.metrics.emplace_back(reading.name, reading.value / operations);
+
+                    if (reading.name == "cycles") cycles = reading.value;
+                    if (reading.name == "instructions") instructions = reading.value;
+                }
+
+                if (cycles > 0 && instructions > 0) aResult.metrics.emplace_back("ipc", instructions / cycles);
+            }
+
+            //! every metric name used by any result, in order of first appearance
+            std::vector<std::string> metric_names() const {
+                std::vector<std::string> names;
+
+                for (const auto &r : m_Results) for (const auto &metric : r.metrics)
+                    if (std::find(names.begin(), names.end(), metric.first) == names.end())
+                        names.push_back(metric.first);
+
+                return names;
+            }
+
+            //! the counters being read, comma separated, or why there are none
+            std::string counter_names() const {
+                if (!m_Counters) return m_Options.counters ? "unavailable" : "off";
+
+                std::string names;
+
+                for (const auto &reading : m_Counters->totals()) names += (names.empty() ? "" : ",") + reading.name;
+
+                return names;
+            }
+
+            static const double *find_metric(const result &aResult, const std::string &aName) {
+                for (const auto &metric : aResult.metrics) if (metric.first == aName) return &metric.second;
+
+                return nullptr;
+            }
+
+            static double gigabytes_per_second(const result &aResult) {
+                return static_cast<double>(aResult.bytes)
+                    / (aResult.nanoseconds.median * static_cast<double>(aResult.operations));
+            }
+
+            static std::string quoted(const std::string &aText) {
+                std::string out("\"");
+
+                for (const auto c : aText) {
+                    if (c == '"' || c == '\\') out += '\\';
+                    out += c;
+                }
+
+                return out + "\"";
+            }
+
+            //! as is, unless a comma or quote means it must be quoted
+            static std::string csv_field(const std::string &aText) {
+                if (aText.find_first_of(",\"\n") == std::string::npos) return aText;
+
+                std::string out("\"");
+
+                for (const auto c : aText) {
+                    if (c == '"') out += '"';
+                    out += c;
+                }
+
+                return out + "\"";
+            }
+
+            void write_text(std::FILE *const aFile) const {
+                std::fprintf(aFile, "gdk-math bench   backend=%s   samples=%zu   seed=%u   counters=%s%s%s\n",
+                    GDK_MATH_BENCH_BACKEND, m_Options.samples, m_Options.seed, counter_names().c_str(),
+                    m_Options.label.empty() ? "" : "   label=", m_Options.label.c_str());
+
+                std::string suite;
+
+                for (const auto &r : m_Results) {
+                    if (r.suite != suite) {
+                        suite = r.suite;
+
+                        std::fprintf(aFile, "\n%s\n  %-36s %-10s %9s %9s %9s %9s\n", suite.c_str(), "",
+                            "mode", "median", "min", "p90", "p99");
+                    }
+
+                    std::fprintf(aFile, "  %-36s %-10s %9.2f %9.2f %9.2f %9.2f", r.name.c_str(), to_string(r.mode),
+                        r.nanoseconds.median, r.nanoseconds.min, r.nanoseconds.p90, r.nanoseconds.p99);
+
+                    if (r.bytes) std::fprintf(aFile, "   %7.2f GB/s", gigabytes_per_second(r));
+
+                    for (const auto &metric : r.metrics)
+                        std::fprintf(aFile, "   %s=%.3g", metric.first.c_str(), metric.second);
+
+                    std::fputc('\n', aFile);
+                }
+
+                std::fprintf(aFile, "\nns per operation. checksum %.6f   (must differ for a different seed)\n", sink);
+            }
+
+            void write_json(std::FILE *const aFile) const {
+                std::fprintf(aFile, "{\n  \"backend\": %s,\n  \"label\": %s,\n  \"seed\": %u,\n  \"samples\": %zu,\n"
+                    "  \"counters\": %s,\n  \"results\": [", quoted(GDK_MATH_BENCH_BACKEND).c_str(),
+                    quoted(m_Options.label).c_str(), m_Options.seed, m_Options.samples, quoted(counter_names()).c_str());
+
+                for (std::size_t i = 0; i < m_Results.size(); ++i) {
+                    const auto &r = m_Results[i];
+                    const auto &ns = r.nanoseconds;
+
+                    std::fprintf(aFile, "%s\n    {\"suite\": %s, \"name\": %s, \"mode\": \"%s\", \"operations\": %zu, "
+                        "\"bytes\": %zu, \"samples\": %zu, \"ns\": {\"min\": %.4f, \"median\": %.4f, \"mean\": %.4f, "
+                        "\"p90\": %.4f, \"p99\": %.4f}",
+                        i ? "," : "", quoted(r.suite).c_str(), quoted(r.name).c_str(), to_string(r.mode), r.operations,
+                        r.bytes, r.samples, ns.min, ns.median, ns.mean, ns.p90, ns.p99);
+
+                    if (!r.metrics.empty()) {
+                        std::fputs(", \"metrics\": {", aFile);
+
+                        // JSON has no infinity or NaN
+                        for (std::size_t m = 0; m < r.metrics.size(); ++m) {
+                            std::fprintf(aFile, "%s%s: ", m ? ", " : "", quoted(r.metrics[m].first).c_str());
+
+                            if (std::isfinite(r.metrics[m].second)) std::fprintf(aFile, "%.6g", r.metrics[m].second);
+                            else std::fputs("null", aFile);
+                        }
+
+                        std::fputc('}', aFile);
+                    }
+
+                    std::fputc('}', aFile);
+                }
+
+                std::fputs("\n  ]\n}\n", aFile);
+            }
+
+            void write_csv(std::FILE *const aFile) const {
+                const auto names = metric_names();
+
+                std::fputs("backend,label,suite,name,mode,operations,bytes,samples,"
+                    "min_ns,median_ns,mean_ns,p90_ns,p99_ns", aFile);
+
+                for (const auto &name : names) std::fprintf(aFile, ",%s", csv_field(name).c_str());
+
+                std::fputc('\n', aFile);
+
+                for (const auto &r : m_Results) {
+                    const auto &ns = r.nanoseconds;
+
+                    std::fprintf(aFile, "%s,%s,%s,%s,%s,%zu,%zu,%zu,%.4f,%.4f,%.4f,%.4f,%.4f",
+                        csv_field(GDK_MATH_BENCH_BACKEND).c_str(), csv_field(m_Options.label).c_str(),
+                        csv_field(r.suite).c_str(), csv_field(r.name).c_str(),
+                        to_string(r.mode), r.operations, r.bytes, r.samples, ns.min, ns.median, ns.mean, ns.p90, ns.p99);
+
+                    // a metric this result lacks is left empty
+                    for (const auto &name : names) {
+                        if (const auto value = find_metric(r, name)) std::fprintf(aFile, ",%.6g", *value);
+                        else std::fputc(',', aFile);
+                    }
+
+                    std::fputc('\n', aFile);
+                }
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,154 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_BENCH_PERF_COUNTERS_H
+#define GDK_MATH_BENCH_PERF_COUNTERS_H
+
+/// \file hardware performance counters through Linux perf_event_open.
+///
+/// Each counter is opened on its own rather than as a group, so one the machine lacks does not take
+/// the others with it. Counters that will not open are left out; where none open at all (another
+/// OS, a container without perf access, perf_event_paranoid too high) the bench runs on time alone.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fstream>
+#endif
+
+namespace gdk {
+    namespace bench {
+        class perf_counters final {
+        public:
+            //! a counter's total over every interval between start() and stop()
+            struct reading final {
+                std::string name;
+                double value;
+            };
+
+            //! try to open every counter. Check available() after.
+            perf_counters() {
+#if defined(__linux__)
+                add("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+                add("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+                add("branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+                add("l1d_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                    | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+                add("llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+
+                // floating point arithmetic has no generic event, only model specific raw ones: every
+                // umask of FP_ARITH_INST_RETIRED on Intel since Skylake, and of RETIRED_SSE_AVX_FLOPS
+                // on AMD since Zen. Intel counts instructions, AMD counts flops.
+                const auto vendor = cpu_vendor();
+
+                if (vendor == "GenuineIntel") add("fp_arith", PERF_TYPE_RAW, 0xffc7);
+                else if (vendor == "AuthenticAMD") add("fp_arith", PERF_TYPE_RAW, 0xff03);
+#endif
+            }
+
+            ~perf_counters() {
+#if defined(__linux__)
+                for (const auto &c : m_Counters) close(c.fd);
+#endif
+            }
+
+            perf_counters(const perf_counters &) = delete;
+            perf_counters &operator=(const perf_counters &) = delete;
+
+            //! whether any counter opened
+            [[nodiscard]] bool available() const { return !m_Counters.empty(); }
+
+            //! zero the totals
+            void reset() {
+                for (auto &c : m_Counters) c.total = 0;
+            }
+
+            void start() {
+#if defined(__linux__)
+                for (const auto &c : m_Counters) {
+                    ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+#endif
+            }
+
+            //! stop counting and add this interval to the totals. A counter the kernel multiplexed with
+            /// others is scaled up by the share of the interval it was actually counting.
+            void stop() {
+#if defined(__linux__)
+                for (auto &c : m_Counters) ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+
+                for (auto &c : m_Counters) {
+                    std::uint64_t values[3] = {};
+
+                    if (read(c.fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || !values[2])
+                        continue;
+
+                    c.total += static_cast<double>(values[0]) * static_cast<double>(values[1])
+                        / static_cast<double>(values[2]);
+                }
+#endif
+            }
+
+            [[nodiscard]] std::vector<reading> totals() const {
+                std::vector<reading> out;
+
+                for (const auto &c : m_Counters) out.push_back({c.name, c.total});
+
+                return out;
+            }
+
+        private:
+            struct counter final {
+                std::string name;
+                int fd;
+                double total;
+            };
+
+            std::vector<counter> m_Counters;
+
+#if defined(__linux__)
+            void add(const char *const aName, const std::uint32_t aType, const std::uint64_t aConfig) {
+                perf_event_attr attributes;
+                std::memset(&attributes, 0, sizeof(attributes));
+
+                attributes.size = sizeof(attributes);
+                attributes.type = aType;
+                attributes.config = aConfig;
+                attributes.disabled = 1;
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                const auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+
+                if (fd >= 0) m_Counters.push_back({aName, fd, 0});
+            }
+
+            static std::string cpu_vendor() {
+                std::ifstream cpuinfo("/proc/cpuinfo");
+
+                for (std::string line; std::getline(cpuinfo, line);) {
+                    if (line.compare(0, 9, "vendor_id") != 0) continue;
+
+                    const auto value = line.find_first_not_of(" \t", line.find(':') + 1);
+
+                    return value == std::string::npos ? std::string() : line.substr(value);
+                }
+
+                return {};
+            }
+#endif
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,516 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file whole frame workloads, built the way a game would build them from the public API
+///
+/// Four scenarios, each a frame of work repeated once per sample:
+///   - a transform hierarchy of 10k nodes: animate each local rotation, rebuild its matrix, and
+///     compose it with its parent's world matrix, one tree level at a time
+///   - linear blend skinning of 100k vertices, each weighted to 4 of 64 bones: pose the bones, then
+///     skin every position and normal
+///   - culling 1M bounding spheres against the 6 planes of a turning camera's frustum
+///   - integrating 1M particles under gravity, bouncing off the ground
+///
+/// Each scenario runs with 1 thread, then doubling counts up to --threads (one per hardware thread by
+/// default). A persistent pool splits each parallel step into one contiguous chunk per thread. The
+/// operation is the frame: the timings are ns per frame, and each row carries frames per second at
+/// the median and the total time of its timed frames. Where the fps stops rising with threads, the
+/// scenario has run out of parallel work or out of memory bandwidth.
+///
+/// usage: gdkmath_scenario_<backend> [--threads=N] and any option of the bench
+
+#include "harness.h"
+
+#include <gdk/math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace gdk;
+using namespace gdk::bench;
+
+namespace {
+    using vec3 = vector3<float>;
+    using quat = quaternion<float>;
+    using mat4 = matrix4x4<float>;
+
+    //! seconds per frame, for everything that moves
+    constexpr float TIME_STEP = 1.0f / 60.0f;
+
+    //! threads that wait between frames, rather than being started for each
+    class thread_pool final {
+    public:
+        explicit thread_pool(const std::size_t aThreads)
+        : m_Threads(aThreads) {
+            for (std::size_t thread = 1; thread < aThreads; ++thread)
+                m_Workers.emplace_back([this, thread]() { work(thread); });
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                m_Stopping = true;
+                ++m_Generation;
+            }
+
+            m_Start.notify_all();
+
+            for (auto &worker : m_Workers) worker.join();
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        [[nodiscard]] std::size_t size() const { return m_Threads; }
+
+        //! call aBody(begin, end, thread) for one contiguous, near-equal piece of [0, aCount) per thread,
+        /// the first on the calling thread, and return once every piece is done
+        template<typename body_type>
+        void run(const std::size_t aCount, body_type &&aBody) {
+            if (m_Threads == 1) {
+                aBody(std::size_t(0), aCount, std::size_t(0));
+
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                m_Count = aCount;
+                m_Body = &aBody;
+                m_Invoke = [](void *const aErased, const std::size_t aBegin, const std::size_t aEnd,
+                    const std::size_t aThread) {
+                    (*static_cast<std::remove_reference_t<body_type> *>(aErased))(aBegin, aEnd, aThread);
+                };
+                m_Pending = m_Threads - 1;
+                ++m_Generation;
+            }
+
+            m_Start.notify_all();
+
+            aBody(std::size_t(0), begin(1), std::size_t(0));
+
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_Done.wait(lock, [this]() { return m_Pending == 0; });
+        }
+
+    private:
+        std::size_t m_Threads;
+        std::vector<std::thread> m_Workers;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Start, m_Done;
+
+        std::uint64_t m_Generation = 0;
+        std::size_t m_Pending = 0;
+        bool m_Stopping = false;
+
+        std::size_t m_Count = 0;
+        void *m_Body = nullptr;
+        void (*m_Invoke)(void *, std::size_t, std::size_t, std::size_t) = nullptr;
+
+        std::size_t begin(const std::size_t aThread) const { return m_Count * aThread / m_Threads; }
+
+        void work(const std::size_t aThread) {
+            std::uint64_t seen = 0;
+
+            for (;;) {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+
+                m_Start.wait(lock, [&]() { return m_Generation != seen; });
+
+                seen = m_Generation;
+
+                if (m_Stopping) return;
+
+                lock.unlock();
+
+                m_Invoke(m_Body, begin(aThread), begin(aThread + 1), aThread);
+
+                lock.lock();
+
+                if (--m_Pending == 0) m_Done.notify_one();
+            }
+        }
+    };
+
+    //! a count per thread, each on its own cache line so the threads do not contend for one
+    struct alignas(64) tally final {
+        std::size_t value = 0;
+    };
+
+    vec3 random_vector(random_source &aRandom) { return vec3(aRandom.next(), aRandom.next(), aRandom.next()); }
+
+    //! a random unit axis, never the zero vector
+    vec3 random_axis(random_source &aRandom) {
+        const auto axis = random_vector(aRandom);
+
+        return axis.is_effectively_zero() ? vec3::up : axis.normal();
+    }
+
+    //! a node's transform relative to its parent, and how fast it turns
+    struct node final {
+        vec3 position, scale;
+        quat rotation;
+        quat spin;
+    };
+
+    //! nodes are in breadth first order, each with 4 children, so a node's parent comes before it and
+    /// each level of the tree is a contiguous range that can be updated in parallel
+    class hierarchy final {
+    public:
+        static constexpr std::size_t CHILDREN = 4;
+
+        hierarchy(const std::size_t aCount, random_source &aRandom)
+        : m_Nodes(aCount)
+        , m_World(aCount) {
+            for (auto &n : m_Nodes) {
+                n.position = random_vector(aRandom) * 2.0f;
+                n.scale = vec3::one * (1.0f + aRandom.next() * 0.1f);
+                n.rotation = quat::from_angle_axis(aRandom.next() * 3.0f, random_axis(aRandom));
+                n.spin = quat::from_angle_axis(aRandom.next() * TIME_STEP, random_axis(aRandom));
+            }
+
+            for (std::size_t begin = 0, width = 1; begin < aCount; begin += width, width *= CHILDREN)
+                m_Levels.push_back(begin);
+
+            m_Levels.push_back(aCount);
+        }
+
+        void frame(thread_pool &aPool) {
+            for (std::size_t level = 0; level + 1 < m_Levels.size(); ++level) {
+                const auto first = m_Levels[level];
+
+                aPool.run(m_Levels[level + 1] - first, [&](const std::size_t aBegin, const std::size_t aEnd,
+                    std::size_t) {
+                    for (std::size_t i = first + aBegin; i < first + aEnd; ++i) {
+                        auto &n = m_Nodes[i];
+
+                        n.rotation = (n.spin * n.rotation).normalized();
+
+                        mat4 local;
+                        local.set_rotation_and_scale(n.rotation, n.scale);
+                        local.set_translation(n.position);
+
+                        m_World[i] = i ? m_World[(i - 1) / CHILDREN] * local : local;
+                    }
+                });
+            }
+        }
+
+        [[nodiscard]] float checksum() const { return m_World.back().get(3, 0); }
+
+    private:
+        std::vector<node> m_Nodes;
+        std::vector<mat4> m_World;
+
+        //! the first node of each level, then the node count
+        std::vector<std::size_t> m_Levels;
+    };
+
+    class skinning final {
+    public:
+        static constexpr std::size_t BONES = 64;
+        static constexpr std::size_t INFLUENCES = 4;
+
+        skinning(const std::size_t aCount, random_source &aRandom)
+        : m_Positions(aCount)
+        , m_Normals(aCount)
+        , m_Bones(aCount * INFLUENCES)
+        , m_Weights(aCount * INFLUENCES)
+        , m_SkinnedPositions(aCount)
+        , m_SkinnedNormals(aCount)
+        , m_Axes(BONES)
+        , m_Offsets(BONES)
+        , m_Palette(BONES)
+        , m_Rotations(BONES) {
+            for (std::size_t v = 0; v < aCount; ++v) {
+                m_Positions[v] = random_vector(aRandom);
+                m_Normals[v] = random_axis(aRandom);
+
+                // neighbouring bones, as a mesh's vertices are weighted to nearby joints
+                const auto bone = static_cast<std::size_t>((aRandom.next() + 1.0f) * 0.5f * (BONES - INFLUENCES));
+
+                float total = 0;
+
+                for (std::size_t k = 0; k < INFLUENCES; ++k) {
+                    m_Bones[v * INFLUENCES + k] = static_cast<std::uint8_t>(bone + k);
+                    m_Weights[v * INFLUENCES + k] = aRandom.next() + 1.5f;
+
+                    total += m_Weights[v * INFLUENCES + k];
+                }
+
+                for (std::size_t k = 0; k < INFLUENCES; ++k) m_Weights[v * INFLUENCES + k] /= total;
+            }
+
+            for (std::size_t b = 0; b < BONES; ++b) {
+                m_Axes[b] = random_axis(aRandom);
+                m_Offsets[b] = random_vector(aRandom) * 0.1f;
+            }
+        }
+
+        void frame(thread_pool &aPool) {
+            const auto time = static_cast<float>(++m_Frame) * TIME_STEP;
+
+            // the pose: too little work to be worth a thread
+            for (std::size_t b = 0; b < BONES; ++b) {
+                m_Rotations[b] = quat::from_angle_axis(std::sin(time + static_cast<float>(b)), m_Axes[b]);
+
+                m_Palette[b].set_rotation_and_scale(m_Rotations[b], vec3::one);
+                m_Palette[b].set_translation(m_Offsets[b]);
+            }
+
+            aPool.run(m_Positions.size(), [&](const std::size_t aBegin, const std::size_t aEnd, std::size_t) {
+                for (std::size_t v = aBegin; v < aEnd; ++v) {
+                    auto position = vec3::zero, normal = vec3::zero;
+
+                    for (std::size_t k = 0; k < INFLUENCES; ++k) {
+                        const auto bone = m_Bones[v * INFLUENCES + k];
+                        const auto weight = m_Weights[v * INFLUENCES + k];
+
+                        position += (m_Palette[bone] * m_Positions[v]) * weight;
+                        normal += (m_Rotations[bone] * m_Normals[v]) * weight;
+                    }
+
+                    m_SkinnedPositions[v] = position;
+                    m_SkinnedNormals[v] = normal.normal();
+                }
+            });
+        }
+
+        [[nodiscard]] float checksum() const { return m_SkinnedPositions.back().x + m_SkinnedNormals.back().y; }
+
+    private:
+        std::vector<vec3> m_Positions, m_Normals;
+        std::vector<std::uint8_t> m_Bones;
+        std::vector<float> m_Weights;
+        std::vector<vec3> m_SkinnedPositions, m_SkinnedNormals;
+
+        std::vector<vec3> m_Axes, m_Offsets;
+        std::vector<mat4> m_Palette;
+        std::vector<quat> m_Rotations;
+
+        std::size_t m_Frame = 0;
+    };
+
+    //! a plane whose normal points into the frustum: a point is inside when its signed distance is positive
+    struct plane final {
+        vec3 normal;
+        float distance;
+
+        [[nodiscard]] float signed_distance(const vec3 &aPoint) const { return normal.dot_product(aPoint) + distance; }
+    };
+
+    class culling final {
+    public:
+        static constexpr float EXTENT = 500.0f;
+
+        culling(const std::size_t aCount, const std::size_t aThreads, random_source &aRandom)
+        : m_Spheres(aCount)
+        , m_Visible(aCount)
+        , m_Counts(aThreads) {
+            for (auto &s : m_Spheres) s = sphere<float>(random_vector(aRandom) * EXTENT, 1.5f + aRandom.next());
+        }
+
+        void frame(thread_pool &aPool) {
+            const auto planes = frustum(static_cast<float>(++m_Frame) * TIME_STEP);
+
+            aPool.run(m_Spheres.size(), [&](const std::size_t aBegin, const std::size_t aEnd,
+                const std::size_t aThread) {
+                std::size_t visible = 0;
+
+                for (std::size_t i = aBegin; i < aEnd; ++i) {
+                    const auto &s = m_Spheres[i];
+
+                    bool inside = true;
+
+                    for (const auto &p : planes) inside &= p.signed_distance(s.center) >= -s.radius;
+
+                    m_Visible[i] = inside;
+                    visible += inside;
+                }
+
+                m_Counts[aThread].value = visible;
+            });
+
+            m_VisibleCount = 0;
+
+            for (std::size_t thread = 0; thread < aPool.size(); ++thread) m_VisibleCount += m_Counts[thread].value;
+        }
+
+        [[nodiscard]] float checksum() const { return static_cast<float>(m_VisibleCount); }
+
+    private:
+        std::vector<sphere<float>> m_Spheres;
+        std::vector<std::uint8_t> m_Visible;
+        std::vector<tally> m_Counts;
+
+        std::size_t m_Frame = 0;
+        std::size_t m_VisibleCount = 0;
+
+        //! a 90 degree, 16:9 camera at the origin, turning about the vertical
+        static std::vector<plane> frustum(const float aTime) {
+            constexpr float CLOSEST = 0.1f, FARTHEST = 400.0f, TAN_VERTICAL = 1.0f, ASPECT = 16.0f / 9.0f;
+
+            const auto rotation = quat::from_angle_axis(aTime * 0.5f, vec3::up);
+            const auto forward = rotation * vec3::forward, right = rotation * vec3::right, up = rotation * vec3::up;
+
+            // each side plane holds the camera and one edge of the view
+            const auto side = [&](const vec3 &aEdge, const vec3 &aAlong) {
+                auto normal = aEdge.cross_product(aAlong).normal();
+
+                if (normal.dot_product(forward) < 0) normal = -normal;
+
+                return plane{normal, 0};
+            };
+
+            return {
+                plane{forward, -CLOSEST},
+                plane{-forward, FARTHEST},
+                side(forward + right * (TAN_VERTICAL * ASPECT), up),
+                side(forward - right * (TAN_VERTICAL * ASPECT), up),
+                side(forward + up * TAN_VERTICAL, right),
+                side(forward - up * TAN_VERTICAL, right)
+            };
+        }
+    };
+
+    class particles final {
+    public:
+        particles(const std::size_t aCount, random_source &aRandom)
+        : m_Positions(aCount)
+        , m_Velocities(aCount) {
+            for (std::size_t i = 0; i < aCount; ++i) {
+                m_Positions[i] = random_vector(aRandom) * 50.0f + vec3::up * 60.0f;
+                m_Velocities[i] = random_vector(aRandom) * 5.0f;
+            }
+        }
+
+        void frame(thread_pool &aPool) {
+            const auto gravity = vec3::down * (9.8f * TIME_STEP);
+
+            aPool.run(m_Positions.size(), [&](const std::size_t aBegin, const std::size_t aEnd, std::size_t) {
+                for (std::size_t i = aBegin; i < aEnd; ++i) {
+                    auto &position = m_Positions[i];
+                    auto &velocity = m_Velocities[i];
+
+                    velocity += gravity;
+                    position += velocity * TIME_STEP;
+
+                    // the ground at y = 0 returns most of the speed
+                    if (position.y < 0) {
+                        position.y = -position.y;
+                        velocity = velocity.reflect(vec3::up) * 0.8f;
+                    }
+                }
+            });
+        }
+
+        [[nodiscard]] float checksum() const { return m_Positions.back().y; }
+
+    private:
+        std::vector<vec3> m_Positions, m_Velocities;
+    };
+
+    //! 1, 2, 4 ... up to and including aMaximum
+    std::vector<std::size_t> thread_counts(const std::size_t aMaximum) {
+        std::vector<std::size_t> counts;
+
+        for (std::size_t count = 1; count < aMaximum; count *= 2) counts.push_back(count);
+
+        counts.push_back(aMaximum);
+
+        return counts;
+    }
+
+    std::string row_name(const thread_pool &aPool) {
+        return std::to_string(aPool.size()) + (aPool.size() == 1 ? " thread" : " threads");
+    }
+
+    //! whether any row of a scenario passes the filter
+    bool enabled(const harness &aHarness, const std::string &aSuite,
+        const std::vector<std::unique_ptr<thread_pool>> &aPools) {
+        for (const auto &pool : aPools) if (aHarness.enabled(aSuite, row_name(*pool))) return true;
+
+        return false;
+    }
+
+    //! time aScenario's frame once for each pool, and add frames per second and the total time
+    template<typename scenario_type>
+    void run(harness &aHarness, const std::string &aSuite, scenario_type &aScenario,
+        const std::vector<std::unique_ptr<thread_pool>> &aPools) {
+        for (const auto &pool : aPools) {
+            auto *const r = aHarness.measure(aSuite, row_name(*pool), mode::throughput, 1, 0,
+                [&] { aScenario.frame(*pool); });
+
+            if (!r) continue;
+
+            r->metrics.emplace_back("fps", 1e9 / r->nanoseconds.median);
+            r->metrics.emplace_back("total_ms", r->nanoseconds.mean * static_cast<double>(r->samples) / 1e6);
+
+            aHarness.sink += static_cast<double>(aScenario.checksum());
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        harness h(options::parse(argc, argv));
+
+        random_source rng(h.config().seed);
+
+        const auto threads = h.config().threads
+            ? h.config().threads
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        std::vector<std::unique_ptr<thread_pool>> pools;
+
+        for (const auto count : thread_counts(threads)) pools.push_back(std::make_unique<thread_pool>(count));
+
+        // each scenario is built only if it will run, as the larger ones take a while to set up
+        if (enabled(h, "hierarchy 10k nodes", pools)) {
+            hierarchy scenario(10000, rng);
+
+            run(h, "hierarchy 10k nodes", scenario, pools);
+        }
+
+        if (enabled(h, "skinning 100k vertices", pools)) {
+            skinning scenario(100000, rng);
+
+            run(h, "skinning 100k vertices", scenario, pools);
+        }
+
+        if (enabled(h, "cull 1M spheres", pools)) {
+            culling scenario(1000000, threads, rng);
+
+            run(h, "cull 1M spheres", scenario, pools);
+        }
+
+        if (enabled(h, "particles 1M", pools)) {
+            particles scenario(1000000, rng);
+
+            run(h, "particles 1M", scenario, pools);
+        }
+
+        h.write();
+
+        if (h.regressions()) return 1;
+    }
+    catch (const std::exception &e) {
+        std::fprintf(stderr, "gdkmath scenario: %s\n", e.what());
+
+        return 1;
+    }
+}
@@ -0,0 +1,152 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file batch kernels over a geometric sweep of working set sizes
+///
+/// Each kernel streams from input arrays to an output array. The working set, every array the
+/// kernel reads or writes, doubles from --min-bytes (1 KiB) to --max-bytes (1 GiB). Small sets are
+/// run several times per sample, so every sample does at least MINIMUM_OPERATIONS. Reports ns per
+/// element and GB/s: where GB/s flattens as the size grows, the kernel has become memory bound.
+///
+/// usage: gdkmath_sweep_<backend> [--min-bytes=N] [--max-bytes=N] and any option of the bench
+
+#include "harness.h"
+
+#include <gdk/math.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace gdk;
+using namespace gdk::bench;
+
+namespace {
+    using vec3 = vector3<float>;
+    using quat = quaternion<float>;
+    using mat4 = matrix4x4<float>;
+
+    //! enough work per sample that the clock's resolution does not matter
+    constexpr std::size_t MINIMUM_OPERATIONS = std::size_t(1) << 16;
+
+    //! inputs are drawn from a pool of this many values, to keep setting up a gigabyte quick
+    constexpr std::size_t POOL_SIZE = 1021;
+
+    //! one component of an output, for the checksum
+    float first(const vec3 &aValue) { return aValue.x; }
+    float first(const quat &aValue) { return aValue.w; }
+    float first(const mat4 &aValue) { return aValue.get(0, 0); }
+
+    std::string size_name(const std::size_t aBytes) {
+        const char *const units[] = {"B", "KiB", "MiB", "GiB"};
+
+        std::size_t unit = 0, value = aBytes;
+
+        while (unit + 1 < sizeof(units) / sizeof(units[0]) && value >= 1024 && value % 1024 == 0) {
+            value /= 1024;
+            ++unit;
+        }
+
+        return std::to_string(value) + " " + units[unit];
+    }
+
+    //! aCount values drawn from aPool with a stride, so neighbouring elements differ
+    template<typename value_type>
+    std::vector<value_type> fill(const std::vector<value_type> &aPool, const std::size_t aCount) {
+        std::vector<value_type> out(aCount);
+
+        for (std::size_t i = 0; i < aCount; ++i) out[i] = aPool[(i * 7) % aPool.size()];
+
+        return out;
+    }
+
+    //! run aKernel(in..., out, count) over every working set size. aBytesPerElement counts the
+    /// inputs and the output.
+    template<typename output_type, typename kernel_type, typename... input_types>
+    void sweep(harness &aHarness, const char *const aSuite, const std::size_t aBytesPerElement,
+        kernel_type &&aKernel, const std::vector<input_types> &...aPools) {
+        for (std::size_t bytes = aHarness.config().min_bytes; bytes <= aHarness.config().max_bytes; bytes *= 2) {
+            const auto count = bytes / aBytesPerElement;
+
+            if (count == 0) continue;
+
+            const auto name = size_name(bytes);
+
+            if (!aHarness.enabled(aSuite, name)) continue;
+
+            const auto inputs = std::make_tuple(fill(aPools, count)...);
+            std::vector<output_type> out(count);
+
+            const auto repeats = (MINIMUM_OPERATIONS + count - 1) / count;
+
+            aHarness.measure(aSuite, name, mode::throughput, count * repeats, aBytesPerElement * count * repeats, [&] {
+                for (std::size_t r = 0; r < repeats; ++r) {
+                    std::apply([&](const auto &...aInputs) { aKernel(aInputs.data()..., out.data(), count); }, inputs);
+
+                    escape(out);
+                }
+            });
+
+            aHarness.sink += static_cast<double>(first(out.back()));
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        harness h(options::parse(argc, argv));
+
+        random_source rng(h.config().seed);
+
+        std::vector<vec3> points(POOL_SIZE);
+        std::vector<quat> rotations(POOL_SIZE);
+        std::vector<mat4> transforms(POOL_SIZE);
+
+        for (std::size_t i = 0; i < POOL_SIZE; ++i) {
+            points[i] = vec3(rng.next(), rng.next(), rng.next());
+            rotations[i] = quat::from_euler(vec3(rng.next(), rng.next(), rng.next()));
+
+            transforms[i].set_rotation_and_scale(rotations[i], vec3::one);
+            transforms[i].set_translation(points[i]);
+        }
+
+        // second operands, so that no pair is an operation on a value with itself
+        const std::vector<quat> otherRotations(rotations.rbegin(), rotations.rend());
+        const std::vector<mat4> otherTransforms(transforms.rbegin(), transforms.rend());
+
+        const auto single = transforms[0];
+
+        sweep<vec3>(h, "transform points", sizeof(vec3) * 2,
+            [&](const vec3 *const aIn, vec3 *const aOut, const std::size_t aCount) {
+                for (std::size_t i = 0; i < aCount; ++i) aOut[i] = single * aIn[i];
+            }, points);
+
+        sweep<mat4>(h, "matrix4x4 compose", sizeof(mat4) * 3,
+            [](const mat4 *const aA, const mat4 *const aB, mat4 *const aOut, const std::size_t aCount) {
+                for (std::size_t i = 0; i < aCount; ++i) aOut[i] = aA[i] * aB[i];
+            }, transforms, otherTransforms);
+
+        sweep<quat>(h, "slerp", sizeof(quat) * 3,
+            [](const quat *const aA, const quat *const aB, quat *const aOut, const std::size_t aCount) {
+                for (std::size_t i = 0; i < aCount; ++i) aOut[i] = slerp(aA[i], aB[i], 0.35f);
+            }, rotations, otherRotations);
+
+        sweep<vec3>(h, "normalize", sizeof(vec3) * 2,
+            [](const vec3 *const aIn, vec3 *const aOut, const std::size_t aCount) {
+                for (std::size_t i = 0; i < aCount; ++i) aOut[i] = aIn[i].normal();
+            }, points);
+
+        h.write();
+
+        if (h.regressions()) return 1;
+    }
+    catch (const std::exception &e) {
+        std::fprintf(stderr, "gdkmath sweep: %s\n", e.what());
+
+        return 1;
+    }
+
+    return 0;
+}
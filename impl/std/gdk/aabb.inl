@@ -0,0 +1,129 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_AABB_INL
+#define GDK_MATH_IMPL_STD_AABB_INL
+
+GDK_MATH_BEGIN_NAMESPACE
+    template<typename component_type>
+    constexpr aabb<component_type>::aabb(const vector3_type &aMin, const vector3_type &aMax)
+    : min(aMin)
+    , max(aMax)
+    {}
+
+    template<typename component_type>
+    constexpr aabb<component_type> aabb<component_type>::from_points(const vector3_type *const aPoints,
+        const std::size_t aCount) {
+        constexpr auto INFINITE = std::numeric_limits<component_type>::infinity();
+
+        aabb result(vector3_type(INFINITE), vector3_type(-INFINITE));
+
+        for (std::size_t i = 0; i < aCount; ++i) {
+            result.min = vector3_type::min(result.min, aPoints[i]);
+            result.max = vector3_type::max(result.max, aPoints[i]);
+        }
+
+        return result;
+    }
+
+    template<typename component_type>
+    aabb<component_type> aabb<component_type>::from_points(const strided_span<const vector3_type> aPoints) {
+        if (aPoints.is_contiguous()) return from_points(aPoints.data(), aPoints.size());
+
+        aabb result = empty;
+
+        for (const auto &point : aPoints) {
+            result.min = vector3_type::min(result.min, point);
+            result.max = vector3_type::max(result.max, point);
+        }
+
+        return result;
+    }
+
+    template<typename component_type>
+    constexpr aabb<component_type> aabb<component_type>::from_center(const vector3_type &aCenter,
+        const vector3_type &aHalfExtents) {
+        return {aCenter - aHalfExtents, aCenter + aHalfExtents};
+    }
+
+    template<typename component_type>
+    constexpr bool aabb<component_type>::is_empty() const {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    template<typename component_type>
+    constexpr typename aabb<component_type>::vector3_type aabb<component_type>::center() const {
+        return (min + max) * static_cast<component_type>(0.5);
+    }
+
+    template<typename component_type>
+    constexpr typename aabb<component_type>::vector3_type aabb<component_type>::half_extents() const {
+        return (max - min) * static_cast<component_type>(0.5);
+    }
+
+    template<typename component_type>
+    constexpr typename aabb<component_type>::vector3_type aabb<component_type>::size() const {
+        return max - min;
+    }
+
+    template<typename component_type>
+    constexpr component_type aabb<component_type>::surface_area() const {
+        const auto d = size();
+
+        return static_cast<component_type>(2) * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    template<typename component_type>
+    constexpr bool aabb<component_type>::contains(const vector3_type &aPoint) const {
+        return aPoint.x >= min.x && aPoint.x <= max.x
+            && aPoint.y >= min.y && aPoint.y <= max.y
+            && aPoint.z >= min.z && aPoint.z <= max.z;
+    }
+
+    template<typename component_type>
+    constexpr bool aabb<component_type>::contains(const aabb<component_type> &aOther) const {
+        return aOther.min.x >= min.x && aOther.max.x <= max.x
+            && aOther.min.y >= min.y && aOther.max.y <= max.y
+            && aOther.min.z >= min.z && aOther.max.z <= max.z;
+    }
+
+    template<typename component_type>
+    constexpr bool aabb<component_type>::overlaps(const aabb<component_type> &aOther) const {
+        return min.x <= aOther.max.x && aOther.min.x <= max.x
+            && min.y <= aOther.max.y && aOther.min.y <= max.y
+            && min.z <= aOther.max.z && aOther.min.z <= max.z;
+    }
+
+    template<typename component_type>
+    constexpr aabb<component_type> aabb<component_type>::merged(const aabb<component_type> &aOther) const {
+        return {vector3_type::min(min, aOther.min), vector3_type::max(max, aOther.max)};
+    }
+
+    template<typename component_type>
+    constexpr aabb<component_type> aabb<component_type>::merged(const vector3_type &aPoint) const {
+        return {vector3_type::min(min, aPoint), vector3_type::max(max, aPoint)};
+    }
+
+    template<typename component_type>
+    constexpr aabb<component_type> aabb<component_type>::expanded(const component_type aMargin) const {
+        const vector3_type margin(aMargin);
+
+        return {min - margin, max + margin};
+    }
+
+    template<typename component_type>
+    constexpr bool aabb<component_type>::operator==(const aabb<component_type> &aOther) const {
+        return min == aOther.min && max == aOther.max;
+    }
+
+    template<typename component_type>
+    constexpr bool aabb<component_type>::operator!=(const aabb<component_type> &aOther) const {
+        return !(*this == aOther);
+    }
+
+    template<typename component_type>
+    const aabb<component_type> aabb<component_type>::empty = {
+        vector3<component_type>(std::numeric_limits<component_type>::infinity()),
+        vector3<component_type>(-std::numeric_limits<component_type>::infinity())};
+GDK_MATH_END_NAMESPACE
+
+#endif
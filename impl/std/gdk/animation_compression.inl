@@ -0,0 +1,341 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_ANIMATION_COMPRESSION_INL
+#define GDK_MATH_IMPL_STD_ANIMATION_COMPRESSION_INL
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! what compression and sampling need of a track's sample type
+        template<typename value_type>
+        struct animation_track_traits;
+
+        template<typename component_type>
+        struct animation_track_traits<vector3<component_type>> final {
+            static constexpr std::size_t component_count = 3;
+
+            static std::array<component_type, 3> components(const vector3<component_type> &aValue) {
+                return {aValue.x, aValue.y, aValue.z};
+            }
+
+            static vector3<component_type> from_components(const std::array<component_type, 3> &aComponents) {
+                return {aComponents[0], aComponents[1], aComponents[2]};
+            }
+
+            static void make_continuous(std::vector<vector3<component_type>> &) {}
+
+            static vector3<component_type> key(const vector3<component_type> &aValue) {
+                return aValue;
+            }
+
+            static vector3<component_type> interpolate(const vector3<component_type> &a,
+                const vector3<component_type> &b, const component_type t) {
+                return lerp(a, b, t);
+            }
+
+            static component_type error(const vector3<component_type> &a, const vector3<component_type> &b) {
+                return (a - b).length();
+            }
+        };
+
+        template<typename component_type>
+        struct animation_track_traits<quaternion<component_type>> final {
+            static constexpr std::size_t component_count = 4;
+
+            static std::array<component_type, 4> components(const quaternion<component_type> &aValue) {
+                return {aValue.x, aValue.y, aValue.z, aValue.w};
+            }
+
+            static quaternion<component_type> from_components(const std::array<component_type, 4> &aComponents) {
+                return {aComponents[0], aComponents[1], aComponents[2], aComponents[3]};
+            }
+
+            //! each rotation on the same side as the one before, so none is interpolated the long way round
+            static void make_continuous(std::vector<quaternion<component_type>> &aSamples) {
+                for (std::size_t i = 1; i < aSamples.size(); ++i)
+                    if (aSamples[i].dot_product(aSamples[i - 1]) < 0) aSamples[i] = -aSamples[i];
+            }
+
+            //! quantized components are no longer unit length
+            static quaternion<component_type> key(const quaternion<component_type> &aValue) {
+                return aValue.normalized();
+            }
+
+            static quaternion<component_type> interpolate(const quaternion<component_type> &a,
+                const quaternion<component_type> &b, const component_type t) {
+                return nlerp(a, b, t);
+            }
+
+            //! the angle between two rotations, from the chord between them, which unlike the dot product's
+            /// arccosine resolves small angles in float
+            static component_type error(const quaternion<component_type> &a, const quaternion<component_type> &b) {
+                const auto difference = a.dot_product(b) < 0 ? a + b : a + -b;
+
+                return 4 * std::asin(std::min(static_cast<component_type>(1),
+                    std::sqrt(difference.dot_product(difference)) / 2));
+            }
+        };
+
+        constexpr std::uint32_t ANIMATION_QUANTIZATION_STEPS = 65535;
+
+        //! the key aIndex of a compressed track: its quantized components, widened over the track's range
+        template<typename value_type, typename track_type>
+        value_type decompress_key(const track_type &aTrack, const std::size_t aIndex) {
+            using traits = animation_track_traits<value_type>;
+            using component_type = typename value_type::component_type;
+
+            const auto minimum = traits::components(aTrack.minimum);
+            const auto step = traits::components(aTrack.step);
+            const auto *const values = aTrack.values.data() + aIndex * traits::component_count;
+
+            std::array<component_type, traits::component_count> components;
+
+            for (std::size_t c = 0; c < traits::component_count; ++c)
+                components[c] = minimum[c] + static_cast<component_type>(values[c]) * step[c];
+
+            return traits::key(traits::from_components(components));
+        }
+
+        //! aSamples is a pointer or a strided_span iterator
+        template<typename iterator_type, typename track_type>
+        void compress_track(const iterator_type aSamples, const std::size_t aFrameCount,
+            const typename std::iterator_traits<iterator_type>::value_type::component_type aTolerance,
+            track_type &aOut) {
+            using value_type = typename std::iterator_traits<iterator_type>::value_type;
+            using traits = animation_track_traits<value_type>;
+            using component_type = typename value_type::component_type;
+            constexpr auto COMPONENTS = traits::component_count;
+
+            aOut.frame_count = aFrameCount;
+            aOut.frames.clear();
+            aOut.values.clear();
+
+            if (aFrameCount == 0) return;
+
+            std::vector<value_type> source(aSamples, aSamples + aFrameCount);
+            traits::make_continuous(source);
+
+            auto minimum = traits::components(source[0]), maximum = minimum;
+
+            for (const auto &sample : source) {
+                const auto components = traits::components(sample);
+
+                for (std::size_t c = 0; c < COMPONENTS; ++c) {
+                    minimum[c] = std::min(minimum[c], components[c]);
+                    maximum[c] = std::max(maximum[c], components[c]);
+                }
+            }
+
+            std::array<component_type, COMPONENTS> step;
+
+            for (std::size_t c = 0; c < COMPONENTS; ++c)
+                step[c] = (maximum[c] - minimum[c]) / static_cast<component_type>(ANIMATION_QUANTIZATION_STEPS);
+
+            aOut.minimum = traits::from_components(minimum);
+            aOut.step = traits::from_components(step);
+
+            // every frame quantized and widened back, to measure interpolation between them
+            std::vector<std::uint16_t> quantized(aFrameCount * COMPONENTS);
+            std::vector<value_type> keys(aFrameCount);
+
+            for (std::size_t i = 0; i < aFrameCount; ++i) {
+                const auto components = traits::components(source[i]);
+
+                std::array<component_type, COMPONENTS> widened;
+
+                for (std::size_t c = 0; c < COMPONENTS; ++c) {
+                    const auto steps = step[c] > 0 ? (components[c] - minimum[c]) / step[c] : component_type(0);
+                    const auto value = static_cast<std::uint16_t>(std::min<component_type>(
+                        static_cast<component_type>(ANIMATION_QUANTIZATION_STEPS), steps + component_type(0.5)));
+
+                    quantized[i * COMPONENTS + c] = value;
+                    widened[c] = minimum[c] + static_cast<component_type>(value) * step[c];
+                }
+
+                keys[i] = traits::key(traits::from_components(widened));
+            }
+
+            const auto fits = [&](const std::size_t aFrom, const std::size_t aTo) {
+                const auto span = static_cast<component_type>(aTo - aFrom);
+
+                for (std::size_t k = aFrom + 1; k < aTo; ++k) {
+                    const auto t = static_cast<component_type>(k - aFrom) / span;
+
+                    if (traits::error(traits::interpolate(keys[aFrom], keys[aTo], t), source[k]) > aTolerance)
+                        return false;
+                }
+
+                return true;
+            };
+
+            const auto keep = [&](const std::size_t aFrame) {
+                aOut.frames.push_back(static_cast<std::uint32_t>(aFrame));
+                aOut.values.insert(aOut.values.end(), quantized.begin() + aFrame * COMPONENTS,
+                    quantized.begin() + (aFrame + 1) * COMPONENTS);
+            };
+
+            keep(0);
+
+            const auto last = aFrameCount - 1;
+
+            // each test costs the length of its segment, so rather than growing the segment a frame at a
+            // time, which makes a long one cost the square of its length, its reach doubles while it fits...
+            for (std::size_t from = 0; from < last;) {
+                std::size_t good = from + 1, bad = aFrameCount;
+
+                for (std::size_t reach = 2; good < last; reach *= 2) {
+                    const auto to = std::min(from + reach, last);
+
+                    if (!fits(from, to)) {
+                        bad = to;
+                        break;
+                    }
+
+                    good = to;
+                }
+
+                // ...and is then bisected between the furthest that fit and the nearest that did not
+                while (bad - good > 1) {
+                    const auto middle = good + (bad - good) / 2;
+
+                    if (fits(from, middle)) good = middle;
+                    else bad = middle;
+                }
+
+                keep(good);
+                from = good;
+            }
+        }
+
+        template<typename value_type, typename track_type>
+        value_type sample_track(const track_type &aTrack, const typename value_type::component_type aFrame) {
+            using traits = animation_track_traits<value_type>;
+            using component_type = typename value_type::component_type;
+
+            const auto &frames = aTrack.frames;
+
+            if (!(aFrame > static_cast<component_type>(frames.front())))
+                return decompress_key<value_type>(aTrack, 0);
+
+            if (!(aFrame < static_cast<component_type>(frames.back())))
+                return decompress_key<value_type>(aTrack, frames.size() - 1);
+
+            // the last key at or before aFrame; the one after it exists, as aFrame is before the last
+            const auto next = static_cast<std::size_t>(std::upper_bound(frames.begin(), frames.end(), aFrame,
+                [](const component_type aValue, const std::uint32_t aKeyFrame) {
+                    return aValue < static_cast<component_type>(aKeyFrame);
+                }) - frames.begin());
+
+            const auto from = static_cast<component_type>(frames[next - 1]);
+            const auto t = (aFrame - from) / (static_cast<component_type>(frames[next]) - from);
+
+            return traits::interpolate(decompress_key<value_type>(aTrack, next - 1),
+                decompress_key<value_type>(aTrack, next), t);
+        }
+    }
+
+    template<typename component_type>
+    compressed_vector3_track<component_type> compress(const vector3<component_type> *const aSamples,
+        const std::size_t aFrameCount, const component_type aTolerance) {
+        compressed_vector3_track<component_type> track;
+
+        detail::compress_track(aSamples, aFrameCount, aTolerance, track);
+
+        return track;
+    }
+
+    template<typename component_type>
+    compressed_quaternion_track<component_type> compress(const quaternion<component_type> *const aSamples,
+        const std::size_t aFrameCount, const component_type aTolerance) {
+        compressed_quaternion_track<component_type> track;
+
+        detail::compress_track(aSamples, aFrameCount, aTolerance, track);
+
+        return track;
+    }
+
+    template<typename component_type>
+    compressed_vector3_track<component_type> compress(const strided_span<const vector3<component_type>> aSamples,
+        const component_type aTolerance) {
+        compressed_vector3_track<component_type> track;
+
+        detail::compress_track(aSamples.begin(), aSamples.size(), aTolerance, track);
+
+        return track;
+    }
+
+    template<typename component_type>
+    compressed_quaternion_track<component_type> compress(
+        const strided_span<const quaternion<component_type>> aSamples, const component_type aTolerance) {
+        compressed_quaternion_track<component_type> track;
+
+        detail::compress_track(aSamples.begin(), aSamples.size(), aTolerance, track);
+
+        return track;
+    }
+
+    template<typename component_type>
+    void compress(const vector3<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_vector3_track<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aTrackCount; ++i)
+            detail::compress_track(aTracks[i], aFrameCount, aTolerance, aOut[i]);
+    }
+
+    template<typename component_type>
+    void compress(const quaternion<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_quaternion_track<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aTrackCount; ++i)
+            detail::compress_track(aTracks[i], aFrameCount, aTolerance, aOut[i]);
+    }
+
+    template<typename component_type>
+    vector3<component_type> sample(const compressed_vector3_track<component_type> &aTrack,
+        const component_type aFrame) {
+        return detail::sample_track<vector3<component_type>>(aTrack, aFrame);
+    }
+
+    template<typename component_type>
+    quaternion<component_type> sample(const compressed_quaternion_track<component_type> &aTrack,
+        const component_type aFrame) {
+        return detail::sample_track<quaternion<component_type>>(aTrack, aFrame);
+    }
+
+    template<typename component_type>
+    void sample(const compressed_vector3_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, vector3<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = sample(aTracks[i], aFrame);
+    }
+
+    template<typename component_type>
+    void sample(const compressed_quaternion_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = sample(aTracks[i], aFrame);
+    }
+
+    template<typename component_type>
+    void sample(const compressed_vector3_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, const strided_span<vector3<component_type>> aOut) {
+        if (aOut.size() < aCount)
+            throw std::invalid_argument("animation_compression: the output is smaller than the track count");
+
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = sample(aTracks[i], aFrame);
+    }
+
+    template<typename component_type>
+    void sample(const compressed_quaternion_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, const strided_span<quaternion<component_type>> aOut) {
+        if (aOut.size() < aCount)
+            throw std::invalid_argument("animation_compression: the output is smaller than the track count");
+
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = sample(aTracks[i], aFrame);
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
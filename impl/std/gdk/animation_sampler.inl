@@ -0,0 +1,273 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_ANIMATION_SAMPLER_INL
+#define GDK_MATH_IMPL_STD_ANIMATION_SAMPLER_INL
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! how many tracks are gathered and blended at once: enough for the blend loop to run long, few
+        /// enough that the gathered keys stay in L1
+        constexpr std::size_t ANIMATION_SAMPLE_BLOCK = 64;
+
+        //! how far a cursor walks forward before a binary search is cheaper
+        constexpr std::size_t ANIMATION_CURSOR_WALK = 4;
+
+        //! the last key at or before aTime, or the first key if none is, starting from aCursor and
+        /// leaving it there
+        template<typename component_type>
+        std::size_t find_key(const component_type *const aTimes, const std::size_t aCount,
+            const component_type aTime, std::size_t &aCursor) {
+            auto key = aCursor < aCount ? aCursor : 0;
+
+            // behind the cursor, after a loop or in reverse: search the keys before it
+            if (aTime < aTimes[key]) {
+                const auto after = static_cast<std::size_t>(std::upper_bound(aTimes, aTimes + key, aTime) - aTimes);
+
+                return aCursor = after ? after - 1 : 0;
+            }
+
+            for (std::size_t walked = 0; key + 1 < aCount && !(aTime < aTimes[key + 1]); ++key) {
+                // far ahead, after a jump or a long frame: search the keys after it
+                if (++walked > ANIMATION_CURSOR_WALK) return aCursor = static_cast<std::size_t>(
+                    std::upper_bound(aTimes + key + 1, aTimes + aCount, aTime) - aTimes) - 1;
+            }
+
+            return aCursor = key;
+        }
+
+        //! the keys either side of aTime in each of aCount tracks, and how far between them it is
+        template<typename value_type>
+        void gather_keys(const keyframe_track<value_type> *const aTracks, const std::size_t aCount,
+            const typename value_type::component_type aTime, std::size_t *const aCursors,
+            value_type *const aFrom, value_type *const aTo, typename value_type::component_type *const aT) {
+            using component_type = typename value_type::component_type;
+
+            for (std::size_t i = 0; i < aCount; ++i) {
+                const auto &track = aTracks[i];
+
+                const auto key = find_key(track.times, track.count, aTime, aCursors[i]);
+                const auto next = key + 1 < track.count ? key + 1 : key;
+
+                aFrom[i] = track.values[key];
+                aTo[i] = track.values[next];
+
+                const auto span = track.times[next] - track.times[key];
+                const auto t = span > 0 ? (aTime - track.times[key]) / span : component_type(0);
+
+                aT[i] = std::min(component_type(1), std::max(component_type(0), t));
+            }
+        }
+
+        template<typename component_type>
+        void lerp_block(const vector3<component_type> *const aFrom, const vector3<component_type> *const aTo,
+            const component_type *const aT, const std::size_t aCount, vector3<component_type> *const aOut) {
+            for (std::size_t i = 0; i < aCount; ++i) aOut[i] = lerp(aFrom[i], aTo[i], aT[i]);
+        }
+
+        //! nlerp, written out so that the loop has no branch but the square root's: the shorter arc's sign
+        /// is multiplied in rather than selected, and the length is never zero between unit keys
+        template<typename component_type>
+        void nlerp_block(const quaternion<component_type> *const aFrom, const quaternion<component_type> *const aTo,
+            const component_type *const aT, const std::size_t aCount, quaternion<component_type> *const aOut) {
+            for (std::size_t i = 0; i < aCount; ++i) {
+                const auto &a = aFrom[i], &b = aTo[i];
+                const auto t = aT[i];
+
+                const auto sign = std::copysign(component_type(1), a.dot_product(b));
+                const auto s = 1 - t, u = t * sign;
+
+                const auto x = a.x * s + b.x * u, y = a.y * s + b.y * u, z = a.z * s + b.z * u, w = a.w * s + b.w * u;
+                const auto scale = 1 / std::sqrt(x * x + y * y + z * z + w * w);
+
+                aOut[i] = {x * scale, y * scale, z * scale, w * scale};
+            }
+        }
+
+        template<typename component_type>
+        void slerp_block(const quaternion<component_type> *const aFrom, const quaternion<component_type> *const aTo,
+            const component_type *const aT, const std::size_t aCount, quaternion<component_type> *const aOut) {
+            for (std::size_t i = 0; i < aCount; ++i) aOut[i] = slerp(aFrom[i], aTo[i], aT[i]);
+        }
+
+        template<typename component_type>
+        void sample_block(const keyframe_track<vector3<component_type>> *const aTracks, const std::size_t aCount,
+            const component_type aTime, std::size_t *const aCursors, vector3<component_type> *const aOut) {
+            vector3<component_type> from[ANIMATION_SAMPLE_BLOCK], to[ANIMATION_SAMPLE_BLOCK];
+            component_type t[ANIMATION_SAMPLE_BLOCK];
+
+            gather_keys(aTracks, aCount, aTime, aCursors, from, to, t);
+            lerp_block(from, to, t, aCount, aOut);
+        }
+
+        template<typename component_type>
+        void sample_block(const keyframe_track<quaternion<component_type>> *const aTracks, const std::size_t aCount,
+            const component_type aTime, std::size_t *const aCursors, quaternion<component_type> *const aOut,
+            const rotation_interpolation aInterpolation) {
+            quaternion<component_type> from[ANIMATION_SAMPLE_BLOCK], to[ANIMATION_SAMPLE_BLOCK];
+            component_type t[ANIMATION_SAMPLE_BLOCK];
+
+            gather_keys(aTracks, aCount, aTime, aCursors, from, to, t);
+
+            if (aInterpolation == rotation_interpolation::slerp) slerp_block(from, to, t, aCount, aOut);
+            else nlerp_block(from, to, t, aCount, aOut);
+        }
+
+        //! call aSampleBlock(begin, count) for each block of aCount tracks, once the cursor holds aCursorCount
+        template<typename block_type>
+        void for_each_sample_block(const std::size_t aCount, const std::size_t aCursorCount,
+            animation_cursor &aCursor, block_type &&aSampleBlock) {
+            if (aCursor.keys.size() < aCursorCount) aCursor.keys.resize(aCursorCount, 0);
+
+            for (std::size_t begin = 0; begin < aCount; begin += ANIMATION_SAMPLE_BLOCK)
+                aSampleBlock(begin, std::min(ANIMATION_SAMPLE_BLOCK, aCount - begin));
+        }
+
+        //! throw if a view written by sampling cannot take aCount values
+        template<typename value_type>
+        void check_sample_output(const strided_span<value_type> aOut, const std::size_t aCount) {
+            if (aOut.size() < aCount)
+                throw std::invalid_argument("animation sampling: the output is smaller than the track count");
+        }
+
+        //! a pose, a block of bones at a time, handed to aWrite(bone, translation, rotation, scale)
+        template<typename component_type, typename write_type>
+        void sample_pose(const keyframe_track<vector3<component_type>> *const aTranslations,
+            const keyframe_track<quaternion<component_type>> *const aRotations,
+            const keyframe_track<vector3<component_type>> *const aScales, const std::size_t aCount,
+            const component_type aTime, animation_cursor &aCursor, const rotation_interpolation aInterpolation,
+            write_type &&aWrite) {
+            for_each_sample_block(aCount, 3 * aCount, aCursor, [&](const std::size_t aBegin, const std::size_t aN) {
+                auto *const cursors = aCursor.keys.data();
+
+                vector3<component_type> translations[ANIMATION_SAMPLE_BLOCK], scales[ANIMATION_SAMPLE_BLOCK];
+                quaternion<component_type> rotations[ANIMATION_SAMPLE_BLOCK];
+
+                sample_block(aTranslations + aBegin, aN, aTime, cursors + aBegin, translations);
+                sample_block(aRotations + aBegin, aN, aTime, cursors + aCount + aBegin, rotations, aInterpolation);
+
+                if (aScales) sample_block(aScales + aBegin, aN, aTime, cursors + 2 * aCount + aBegin, scales);
+                else std::fill(scales, scales + aN, vector3<component_type>(1));
+
+                for (std::size_t i = 0; i < aN; ++i) aWrite(aBegin + i, translations[i], rotations[i], scales[i]);
+            });
+        }
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, vector3<component_type> *const aOut) {
+        detail::for_each_sample_block(aCount, aCount, aCursor, [&](const std::size_t aBegin, const std::size_t aN) {
+            detail::sample_block(aTracks + aBegin, aN, aTime, aCursor.keys.data() + aBegin, aOut + aBegin);
+        });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<quaternion<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, quaternion<component_type> *const aOut,
+        const rotation_interpolation aInterpolation) {
+        detail::for_each_sample_block(aCount, aCount, aCursor, [&](const std::size_t aBegin, const std::size_t aN) {
+            detail::sample_block(aTracks + aBegin, aN, aTime, aCursor.keys.data() + aBegin, aOut + aBegin,
+                aInterpolation);
+        });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        bone_transform<component_type> *const aOut,
+        const rotation_interpolation aInterpolation) {
+        detail::sample_pose(aTranslations, aRotations, aScales, aCount, aTime, aCursor, aInterpolation,
+            [&](const std::size_t aBone, const vector3<component_type> &aTranslation,
+                const quaternion<component_type> &aRotation, const vector3<component_type> &aScale) {
+                aOut[aBone] = {aTranslation, aRotation, aScale};
+            });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        matrix4x4<component_type> *const aOut,
+        const rotation_interpolation aInterpolation) {
+        detail::sample_pose(aTranslations, aRotations, aScales, aCount, aTime, aCursor, aInterpolation,
+            [&](const std::size_t aBone, const vector3<component_type> &aTranslation,
+                const quaternion<component_type> &aRotation, const vector3<component_type> &aScale) {
+                aOut[aBone] = matrix4x4<component_type>(aTranslation, aRotation, aScale);
+            });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, const strided_span<vector3<component_type>> aOut) {
+        detail::check_sample_output(aOut, aCount);
+
+        if (aOut.is_contiguous()) return sample(aTracks, aCount, aTime, aCursor, aOut.data());
+
+        // blended into a block, then scattered: the blend loop stays a straight line
+        detail::for_each_sample_block(aCount, aCount, aCursor, [&](const std::size_t aBegin, const std::size_t aN) {
+            vector3<component_type> values[detail::ANIMATION_SAMPLE_BLOCK];
+
+            detail::sample_block(aTracks + aBegin, aN, aTime, aCursor.keys.data() + aBegin, values);
+
+            for (std::size_t i = 0; i < aN; ++i) aOut[aBegin + i] = values[i];
+        });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<quaternion<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, const strided_span<quaternion<component_type>> aOut,
+        const rotation_interpolation aInterpolation) {
+        detail::check_sample_output(aOut, aCount);
+
+        if (aOut.is_contiguous()) return sample(aTracks, aCount, aTime, aCursor, aOut.data(), aInterpolation);
+
+        detail::for_each_sample_block(aCount, aCount, aCursor, [&](const std::size_t aBegin, const std::size_t aN) {
+            quaternion<component_type> values[detail::ANIMATION_SAMPLE_BLOCK];
+
+            detail::sample_block(aTracks + aBegin, aN, aTime, aCursor.keys.data() + aBegin, values, aInterpolation);
+
+            for (std::size_t i = 0; i < aN; ++i) aOut[aBegin + i] = values[i];
+        });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        const strided_span<bone_transform<component_type>> aOut,
+        const rotation_interpolation aInterpolation) {
+        detail::check_sample_output(aOut, aCount);
+
+        detail::sample_pose(aTranslations, aRotations, aScales, aCount, aTime, aCursor, aInterpolation,
+            [&](const std::size_t aBone, const vector3<component_type> &aTranslation,
+                const quaternion<component_type> &aRotation, const vector3<component_type> &aScale) {
+                aOut[aBone] = {aTranslation, aRotation, aScale};
+            });
+    }
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        const strided_span<matrix4x4<component_type>> aOut,
+        const rotation_interpolation aInterpolation) {
+        detail::check_sample_output(aOut, aCount);
+
+        detail::sample_pose(aTranslations, aRotations, aScales, aCount, aTime, aCursor, aInterpolation,
+            [&](const std::size_t aBone, const vector3<component_type> &aTranslation,
+                const quaternion<component_type> &aRotation, const vector3<component_type> &aScale) {
+                aOut[aBone] = matrix4x4<component_type>(aTranslation, aRotation, aScale);
+            });
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
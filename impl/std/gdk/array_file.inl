@@ -0,0 +1,184 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_ARRAY_FILE_INL
+#define GDK_MATH_IMPL_STD_ARRAY_FILE_INL
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! the element tag of each type an array file can hold; the rest have none
+        template<typename value_type>
+        struct array_file_traits;
+
+        template<typename component_type, array_file_element element_tag>
+        struct array_file_element_traits {
+            static_assert(std::is_same<component_type, float>::value || std::is_same<component_type, double>::value,
+                "array files hold float or double components");
+
+            static constexpr array_file_element element = element_tag;
+            static constexpr array_file_component component = std::is_same<component_type, float>::value
+                ? array_file_component::float32
+                : array_file_component::float64;
+        };
+
+        template<typename component_type>
+        struct array_file_traits<vector2<component_type>> final
+        : array_file_element_traits<component_type, array_file_element::vector2> {};
+
+        template<typename component_type>
+        struct array_file_traits<vector3<component_type>> final
+        : array_file_element_traits<component_type, array_file_element::vector3> {};
+
+        template<typename component_type>
+        struct array_file_traits<vector4<component_type>> final
+        : array_file_element_traits<component_type, array_file_element::vector4> {};
+
+        template<typename component_type>
+        struct array_file_traits<quaternion<component_type>> final
+        : array_file_element_traits<component_type, array_file_element::quaternion> {};
+
+        template<typename component_type>
+        struct array_file_traits<matrix3x3<component_type>> final
+        : array_file_element_traits<component_type, array_file_element::matrix3x3> {};
+
+        template<typename component_type>
+        struct array_file_traits<matrix4x4<component_type>> final
+        : array_file_element_traits<component_type, array_file_element::matrix4x4> {};
+
+        //! the size of one element of each type and component, or zero for a tag this version does not know
+        inline std::size_t array_file_element_size(const array_file_element aElement,
+            const array_file_component aComponent) {
+            std::size_t components = 0;
+
+            switch (aElement) {
+                case array_file_element::vector2: components = 2; break;
+                case array_file_element::vector3: components = 3; break;
+                case array_file_element::vector4: components = 4; break;
+                case array_file_element::quaternion: components = 4; break;
+                case array_file_element::matrix3x3: components = 9; break;
+                case array_file_element::matrix4x4: components = 16; break;
+            }
+
+            switch (aComponent) {
+                case array_file_component::float32: return components * 4;
+                case array_file_component::float64: return components * 8;
+            }
+
+            return 0;
+        }
+
+        [[noreturn]] inline void array_file_error(const std::string &aPath, const char *const aWhat) {
+            throw std::runtime_error("array file \"" + aPath + "\": " + aWhat);
+        }
+    }
+
+    template<typename value_type>
+    void write_array_file(const std::string &aPath, const value_type *const aValues, const std::size_t aCount) {
+        using traits = detail::array_file_traits<value_type>;
+
+        static_assert(std::is_trivially_copyable<value_type>::value, "array file elements are copied as bytes");
+
+        array_file_header header{};
+        std::memcpy(header.magic, "GDKA", 4);
+        header.version = array_file_header::CURRENT_VERSION;
+        header.byte_order = array_file_header::BYTE_ORDER_MARK;
+        header.element = traits::element;
+        header.component = traits::component;
+        header.element_size = static_cast<std::uint32_t>(sizeof(value_type));
+        header.count = aCount;
+        header.payload_offset = sizeof(array_file_header);
+
+        std::FILE *const file = std::fopen(aPath.c_str(), "wb");
+
+        if (!file) detail::array_file_error(aPath, "cannot be opened for writing");
+
+        const auto written = std::fwrite(&header, sizeof header, 1, file) == 1
+            && (aCount == 0 || std::fwrite(aValues, sizeof(value_type), aCount, file) == aCount);
+
+        if (std::fclose(file) != 0 || !written) detail::array_file_error(aPath, "could not be written");
+    }
+
+    inline mapped_array_file::mapped_array_file(const std::string &aPath) {
+        m_Data = detail::map_array_file(aPath, m_Size);
+
+        const auto reject = [&](const char *const aWhat) {
+            unmap();
+            detail::array_file_error(aPath, aWhat);
+        };
+
+        if (m_Size < sizeof(array_file_header)) reject("is too short for a header");
+
+        const auto &h = header();
+
+        if (std::memcmp(h.magic, "GDKA", 4) != 0) reject("is not an array file");
+        if (h.byte_order != array_file_header::BYTE_ORDER_MARK) reject("was written in the other byte order");
+        if (h.version != array_file_header::CURRENT_VERSION) reject("is of an unsupported version");
+
+        const auto elementSize = detail::array_file_element_size(h.element, h.component);
+
+        if (elementSize == 0) reject("holds an unknown element or component type");
+        if (h.element_size != elementSize) reject("has an element size that does not match its type");
+        if (h.payload_offset < sizeof(array_file_header) || h.payload_offset > m_Size)
+            reject("has a payload offset outside the file");
+        if (h.payload_offset % 64 != 0) reject("has a misaligned payload");
+        if (h.count > (m_Size - h.payload_offset) / elementSize) reject("is shorter than its payload");
+    }
+
+    inline mapped_array_file::mapped_array_file(mapped_array_file &&aOther) noexcept
+    : m_Data(std::exchange(aOther.m_Data, nullptr))
+    , m_Size(std::exchange(aOther.m_Size, 0)) {}
+
+    inline mapped_array_file &mapped_array_file::operator=(mapped_array_file &&aOther) noexcept {
+        if (this != &aOther) {
+            unmap();
+
+            m_Data = std::exchange(aOther.m_Data, nullptr);
+            m_Size = std::exchange(aOther.m_Size, 0);
+        }
+
+        return *this;
+    }
+
+    inline mapped_array_file::~mapped_array_file() {
+        unmap();
+    }
+
+    inline void mapped_array_file::unmap() {
+        if (!m_Data) return;
+
+        detail::unmap_array_file(m_Data, m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+    inline const array_file_header &mapped_array_file::header() const {
+        return *reinterpret_cast<const array_file_header *>(m_Data);
+    }
+
+    inline std::size_t mapped_array_file::size() const {
+        return m_Data ? static_cast<std::size_t>(header().count) : 0;
+    }
+
+    template<typename value_type>
+    bool mapped_array_file::holds() const {
+        using traits = detail::array_file_traits<value_type>;
+
+        return m_Data && header().element == traits::element && header().component == traits::component
+            && header().element_size == sizeof(value_type);
+    }
+
+    template<typename value_type>
+    strided_span<const value_type> mapped_array_file::view() const {
+        if (!holds<value_type>()) throw std::runtime_error("array file does not hold the type asked for");
+
+        return {reinterpret_cast<const value_type *>(m_Data + header().payload_offset), size()};
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
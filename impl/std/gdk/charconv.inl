@@ -0,0 +1,279 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_CHARCONV_INL
+#define GDK_MATH_IMPL_STD_CHARCONV_INL
+
+#include <array>
+#include <type_traits>
+
+// libstdc++ before 11 and libc++ before 17 convert integers only
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#endif
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        inline bool is_text_space(const char aCharacter) {
+            return aCharacter == ' ' || aCharacter == '\t' || aCharacter == '\n' || aCharacter == '\r'
+                || aCharacter == '\v' || aCharacter == '\f';
+        }
+
+        inline const char *skip_text_space(const char *aFirst, const char *const aLast) {
+            while (aFirst != aLast && is_text_space(*aFirst)) ++aFirst;
+
+            return aFirst;
+        }
+
+#if !defined(__cpp_lib_to_chars)
+        inline float parse_float(const char *const aText, char **const aEnd, float) {
+            return std::strtof(aText, aEnd);
+        }
+
+        inline double parse_float(const char *const aText, char **const aEnd, double) {
+            return std::strtod(aText, aEnd);
+        }
+
+        inline long double parse_float(const char *const aText, char **const aEnd, long double) {
+            return std::strtold(aText, aEnd);
+        }
+
+        //! the longest a component can be written in, its terminator included
+        constexpr std::size_t TEXT_COMPONENT_BUFFER = 64;
+
+        //! the fewest significant digits that strtod reads back as aValue
+        template<typename component_type>
+        std::to_chars_result format_floating(char *const aFirst, char *const aLast, const component_type aValue) {
+            char text[TEXT_COMPONENT_BUFFER];
+            int length = 0;
+
+            for (int precision = 1; precision <= std::numeric_limits<component_type>::max_digits10; ++precision) {
+                length = std::snprintf(text, sizeof text, "%.*Lg", precision, static_cast<long double>(aValue));
+
+                if (parse_float(text, nullptr, component_type()) == aValue) break;
+            }
+
+            if (length < 0 || aLast - aFirst < length) return {aLast, std::errc::value_too_large};
+
+            std::memcpy(aFirst, text, static_cast<std::size_t>(length));
+
+            return {aFirst + length, std::errc()};
+        }
+
+        //! strtod wants a terminated string, so the component is copied out first, up to what could be in one
+        template<typename component_type>
+        std::from_chars_result parse_floating(const char *const aFirst, const char *const aLast,
+            component_type &aValue) {
+            char text[TEXT_COMPONENT_BUFFER];
+            std::size_t length = 0;
+
+            while (aFirst + length != aLast && length + 1 < sizeof text && !is_text_space(aFirst[length])) {
+                text[length] = aFirst[length];
+                ++length;
+            }
+
+            text[length] = '\0';
+
+            // strtod would skip whitespace, take a leading '+' and read hexadecimal, which from_chars does not
+            if (length == 0 || text[0] == '+' || (length > 1 && (text[1] == 'x' || text[1] == 'X'))
+                || (length > 2 && text[0] == '-' && (text[2] == 'x' || text[2] == 'X')))
+                return {aFirst, std::errc::invalid_argument};
+
+            char *end = nullptr;
+            errno = 0;
+
+            const auto value = parse_float(text, &end, component_type());
+
+            if (end == text) return {aFirst, std::errc::invalid_argument};
+            // strtod also reports subnormals, which from_chars reads
+            if (errno == ERANGE && (std::isinf(value) || value == 0))
+                return {aFirst + (end - text), std::errc::result_out_of_range};
+
+            aValue = value;
+
+            return {aFirst + (end - text), std::errc()};
+        }
+#endif
+
+        template<typename component_type>
+        std::to_chars_result format_component(char *const aFirst, char *const aLast, const component_type aValue) {
+#if !defined(__cpp_lib_to_chars)
+            if constexpr (std::is_floating_point<component_type>::value)
+                return format_floating(aFirst, aLast, aValue);
+            else
+#endif
+            return std::to_chars(aFirst, aLast, aValue);
+        }
+
+        template<typename component_type>
+        std::from_chars_result parse_component(const char *const aFirst, const char *const aLast,
+            component_type &aValue) {
+#if !defined(__cpp_lib_to_chars)
+            if constexpr (std::is_floating_point<component_type>::value)
+                return parse_floating(aFirst, aLast, aValue);
+            else
+#endif
+            return std::from_chars(aFirst, aLast, aValue);
+        }
+
+        template<typename value_type>
+        std::to_chars_result format_value(char *aFirst, char *const aLast, const value_type &aValue) {
+            const auto components = to_components(aValue);
+
+            for (std::size_t i = 0; i < components.size(); ++i) {
+                if (i) {
+                    if (aFirst == aLast) return {aLast, std::errc::value_too_large};
+
+                    *aFirst++ = ' ';
+                }
+
+                const auto result = format_component(aFirst, aLast, components[i]);
+
+                if (result.ec != std::errc()) return result;
+
+                aFirst = result.ptr;
+            }
+
+            return {aFirst, std::errc()};
+        }
+
+        template<typename value_type>
+        std::from_chars_result parse_value(const char *aFirst, const char *const aLast, value_type &aValue) {
+            std::array<typename value_type::component_type, component_layout<value_type>::size> components;
+
+            for (std::size_t i = 0; i < components.size(); ++i) {
+                const auto next = skip_text_space(aFirst, aLast);
+
+                // "1-2-3" is not three components
+                if (i && next == aFirst) return {aFirst, std::errc::invalid_argument};
+
+                aFirst = next;
+
+                const auto result = parse_component(aFirst, aLast, components[i]);
+
+                if (result.ec != std::errc()) return result;
+
+                aFirst = result.ptr;
+            }
+
+            aValue = from_components<value_type>(components);
+
+            return {aFirst, std::errc()};
+        }
+    }
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const vector2<component_type> &aValue) {
+        return detail::format_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const vector3<component_type> &aValue) {
+        return detail::format_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const vector4<component_type> &aValue) {
+        return detail::format_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast,
+        const quaternion<component_type> &aValue) {
+        return detail::format_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast,
+        const matrix3x3<component_type> &aValue) {
+        return detail::format_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast,
+        const matrix4x4<component_type> &aValue) {
+        return detail::format_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        vector2<component_type> &aValue) {
+        return detail::parse_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        vector3<component_type> &aValue) {
+        return detail::parse_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        vector4<component_type> &aValue) {
+        return detail::parse_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        quaternion<component_type> &aValue) {
+        return detail::parse_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        matrix3x3<component_type> &aValue) {
+        return detail::parse_value(aFirst, aLast, aValue);
+    }
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        matrix4x4<component_type> &aValue) {
+        return detail::parse_value(aFirst, aLast, aValue);
+    }
+
+    template<typename value_type>
+    std::to_chars_result to_chars(char *aFirst, char *const aLast, const strided_span<const value_type> aValues) {
+        for (const auto &value : aValues) {
+            const auto result = detail::format_value(aFirst, aLast, value);
+
+            if (result.ec != std::errc()) return result;
+            if (result.ptr == aLast) return {aLast, std::errc::value_too_large};
+
+            aFirst = result.ptr;
+            *aFirst++ = '\n';
+        }
+
+        return {aFirst, std::errc()};
+    }
+
+    template<typename value_type>
+    from_chars_batch_result from_chars(const char *aFirst, const char *const aLast,
+        const strided_span<value_type> aOut) {
+        std::size_t count = 0;
+
+        for (; count < aOut.size(); ++count) {
+            if (detail::skip_text_space(aFirst, aLast) == aLast) break;
+
+            std::remove_cv_t<value_type> value;
+
+            const auto result = detail::parse_value(aFirst, aLast, value);
+
+            if (result.ec != std::errc()) return {result.ptr, result.ec, count};
+
+            // a value must end at whitespace or the end of the text, or "1 2 3.5.5 6 7" would read as two
+            if (result.ptr != aLast && !detail::is_text_space(*result.ptr))
+                return {result.ptr, std::errc::invalid_argument, count};
+
+            aOut[count] = value;
+            aFirst = result.ptr;
+        }
+
+        return {aFirst, std::errc(), count};
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
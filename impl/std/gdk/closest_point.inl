@@ -0,0 +1,291 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_CLOSEST_POINT_INL
+#define GDK_MATH_IMPL_STD_CLOSEST_POINT_INL
+
+#include <algorithm>
+#include <limits>
+
+// promises the batch outputs share no memory with the inputs; without it the vectorizer needs a
+// run-time overlap check per pair of arrays, and gives up past a handful. Undefined again below.
+#ifndef GDK_MATH_DETAIL_RESTRICT
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define GDK_MATH_DETAIL_RESTRICT __restrict
+#else
+#define GDK_MATH_DETAIL_RESTRICT
+#endif
+#endif
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! by value rather than std::clamp's references, which keeps the batch loops free of branches
+        template<typename component_type>
+        constexpr component_type clamp(const component_type aValue, const component_type aMin,
+            const component_type aMax) {
+            const auto raised = aValue < aMin ? aMin : aValue;
+
+            return raised > aMax ? aMax : raised;
+        }
+
+        template<typename component_type>
+        constexpr component_type clamp_unit(const component_type aValue) {
+            return clamp(aValue, static_cast<component_type>(0), static_cast<component_type>(1));
+        }
+
+        template<typename component_type>
+        constexpr vector3<component_type> load(const vector3_soa<const component_type> &aVectors,
+            const std::size_t aIndex) {
+            return {aVectors.x[aIndex], aVectors.y[aIndex], aVectors.z[aIndex]};
+        }
+
+        template<typename component_type>
+        constexpr void store(const vector3_soa<component_type> &aVectors, const std::size_t aIndex,
+            const vector3<component_type> &aValue) {
+            aVectors.x[aIndex] = aValue.x;
+            aVectors.y[aIndex] = aValue.y;
+            aVectors.z[aIndex] = aValue.z;
+        }
+
+        //! index of the smallest of aCount values, or aCount when there are none. A pass of its own,
+        /// so the loops that fill aValues carry no dependency from one element to the next.
+        template<typename component_type>
+        std::size_t index_of_nearest(const component_type *const aValues, const std::size_t aCount) {
+            return static_cast<std::size_t>(std::min_element(aValues, aValues + aCount) - aValues);
+        }
+
+        //! closest_point_on_segment spelled out per component and without branches, so it vectorizes.
+        /// The outputs are restrict parameters rather than fields of a vector3_soa, as compilers only
+        /// trust restrict on parameters.
+        template<typename component_type>
+        void closest_points_on_segments(const component_type aX, const component_type aY, const component_type aZ,
+            const component_type *const aStartX, const component_type *const aStartY,
+            const component_type *const aStartZ, const component_type *const aEndX,
+            const component_type *const aEndY, const component_type *const aEndZ, const std::size_t aCount,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aClosestX,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aClosestY,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aClosestZ,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aDistancesSquared) {
+            for (std::size_t i = 0; i < aCount; ++i) {
+                const auto dx = aEndX[i] - aStartX[i];
+                const auto dy = aEndY[i] - aStartY[i];
+                const auto dz = aEndZ[i] - aStartZ[i];
+
+                const auto lengthSquared = dx * dx + dy * dy + dz * dz;
+                const auto along = (aX - aStartX[i]) * dx + (aY - aStartY[i]) * dy + (aZ - aStartZ[i]) * dz;
+
+                // clamped before the divide, which leaves no constant t for the optimizer to split the
+                // loop on. A zero length segment has along == 0, so raising the divisor off zero gives t = 0.
+                const auto t = clamp(along, static_cast<component_type>(0), lengthSquared)
+                    / std::max(lengthSquared, std::numeric_limits<component_type>::min());
+
+                const auto cx = aStartX[i] + dx * t;
+                const auto cy = aStartY[i] + dy * t;
+                const auto cz = aStartZ[i] + dz * t;
+
+                aClosestX[i] = cx;
+                aClosestY[i] = cy;
+                aClosestZ[i] = cz;
+
+                aDistancesSquared[i] = (aX - cx) * (aX - cx) + (aY - cy) * (aY - cy) + (aZ - cz) * (aZ - cz);
+            }
+        }
+
+        //! closest_point_on_aabb over runs of boxes, as closest_points_on_segments
+        template<typename component_type>
+        void closest_points_on_aabbs(const component_type aX, const component_type aY, const component_type aZ,
+            const component_type *const aMinX, const component_type *const aMinY,
+            const component_type *const aMinZ, const component_type *const aMaxX,
+            const component_type *const aMaxY, const component_type *const aMaxZ, const std::size_t aCount,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aClosestX,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aClosestY,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aClosestZ,
+            component_type *const GDK_MATH_DETAIL_RESTRICT aDistancesSquared) {
+            for (std::size_t i = 0; i < aCount; ++i) {
+                const auto cx = clamp(aX, aMinX[i], aMaxX[i]);
+                const auto cy = clamp(aY, aMinY[i], aMaxY[i]);
+                const auto cz = clamp(aZ, aMinZ[i], aMaxZ[i]);
+
+                aClosestX[i] = cx;
+                aClosestY[i] = cy;
+                aClosestZ[i] = cz;
+
+                aDistancesSquared[i] = (aX - cx) * (aX - cx) + (aY - cy) * (aY - cy) + (aZ - cz) * (aZ - cz);
+            }
+        }
+    }
+
+    template<typename component_type>
+    constexpr vector3<component_type> closest_point_on_segment(const vector3<component_type> &aPoint,
+        const vector3<component_type> &aStart, const vector3<component_type> &aEnd) {
+        const auto direction = aEnd - aStart;
+        const auto lengthSquared = direction.length_squared();
+
+        if (lengthSquared == 0) return aStart;
+
+        return aStart + direction * detail::clamp_unit((aPoint - aStart).dot_product(direction) / lengthSquared);
+    }
+
+    template<typename component_type>
+    constexpr vector3<component_type> closest_point_on_triangle(const vector3<component_type> &aPoint,
+        const vector3<component_type> &aA, const vector3<component_type> &aB, const vector3<component_type> &aC) {
+        const auto ab = aB - aA;
+        const auto ac = aC - aA;
+
+        // a degenerate triangle has no interior, and would divide by zero below
+        if (ab.cross_product(ac).length_squared() == 0) {
+            const vector3<component_type> candidates[3] = {closest_point_on_segment(aPoint, aA, aB),
+                closest_point_on_segment(aPoint, aB, aC), closest_point_on_segment(aPoint, aC, aA)};
+
+            auto nearest = candidates[0];
+
+            for (const auto &candidate : candidates)
+                if ((candidate - aPoint).length_squared() < (nearest - aPoint).length_squared()) nearest = candidate;
+
+            return nearest;
+        }
+
+        // Ericson's Real-Time Collision Detection 5.1.5: find the Voronoi region of aPoint, vertex
+        // regions first, then edges, then the face
+        const auto ap = aPoint - aA;
+        const auto d1 = ab.dot_product(ap);
+        const auto d2 = ac.dot_product(ap);
+
+        if (d1 <= 0 && d2 <= 0) return aA;
+
+        const auto bp = aPoint - aB;
+        const auto d3 = ab.dot_product(bp);
+        const auto d4 = ac.dot_product(bp);
+
+        if (d3 >= 0 && d4 <= d3) return aB;
+
+        const auto vc = d1 * d4 - d3 * d2;
+
+        if (vc <= 0 && d1 >= 0 && d3 <= 0) return aA + ab * (d1 / (d1 - d3));
+
+        const auto cp = aPoint - aC;
+        const auto d5 = ab.dot_product(cp);
+        const auto d6 = ac.dot_product(cp);
+
+        if (d6 >= 0 && d5 <= d6) return aC;
+
+        const auto vb = d5 * d2 - d1 * d6;
+
+        if (vb <= 0 && d2 >= 0 && d6 <= 0) return aA + ac * (d2 / (d2 - d6));
+
+        const auto va = d3 * d6 - d5 * d4;
+
+        if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+            return aB + (aC - aB) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+        const auto denominator = static_cast<component_type>(1) / (va + vb + vc);
+
+        return aA + ab * (vb * denominator) + ac * (vc * denominator);
+    }
+
+    template<typename component_type>
+    constexpr vector3<component_type> closest_point_on_aabb(const vector3<component_type> &aPoint,
+        const aabb<component_type> &aBox) {
+        return {
+            detail::clamp(aPoint.x, aBox.min.x, aBox.max.x),
+            detail::clamp(aPoint.y, aBox.min.y, aBox.max.y),
+            detail::clamp(aPoint.z, aBox.min.z, aBox.max.z)};
+    }
+
+    template<typename component_type>
+    constexpr segment_closest_points<component_type> closest_points_between_segments(
+        const vector3<component_type> &aStart0, const vector3<component_type> &aEnd0,
+        const vector3<component_type> &aStart1, const vector3<component_type> &aEnd1) {
+        const auto d0 = aEnd0 - aStart0;
+        const auto d1 = aEnd1 - aStart1;
+        const auto r = aStart0 - aStart1;
+
+        const auto a = d0.length_squared();
+        const auto e = d1.length_squared();
+        const auto f = d1.dot_product(r);
+
+        component_type s = 0, t = 0;
+
+        if (a == 0) {
+            // the first segment is a point: project it onto the second
+            if (e != 0) t = detail::clamp_unit(f / e);
+        }
+        else {
+            const auto c = d0.dot_product(r);
+
+            if (e == 0) s = detail::clamp_unit(-c / a);
+            else {
+                const auto b = d0.dot_product(d1);
+                const auto denominator = a * e - b * b;
+
+                // parallel segments have no unique pair; start from the first segment's start
+                if (denominator != 0) s = detail::clamp_unit((b * f - c * e) / denominator);
+
+                t = (b * s + f) / e;
+
+                // t fell off the second segment: clamp it, and find s again for the clamped end
+                if (t < 0) {
+                    t = 0;
+                    s = detail::clamp_unit(-c / a);
+                }
+                else if (t > 1) {
+                    t = 1;
+                    s = detail::clamp_unit((b - c) / a);
+                }
+            }
+        }
+
+        return {aStart0 + d0 * s, s, aStart1 + d1 * t, t};
+    }
+
+    template<typename component_type>
+    std::size_t closest_points_on_segments(const vector3<component_type> &aPoint,
+        const soa_input<component_type> aStarts, const soa_input<component_type> aEnds,
+        const std::size_t aCount, const vector3_soa<component_type> aClosest, component_type *const aDistancesSquared) {
+        detail::closest_points_on_segments(aPoint.x, aPoint.y, aPoint.z, aStarts.x, aStarts.y, aStarts.z,
+            aEnds.x, aEnds.y, aEnds.z, aCount, aClosest.x, aClosest.y, aClosest.z, aDistancesSquared);
+
+        return detail::index_of_nearest(aDistancesSquared, aCount);
+    }
+
+    template<typename component_type>
+    std::size_t closest_points_on_triangles(const vector3<component_type> &aPoint,
+        const soa_input<component_type> aA, const soa_input<component_type> aB,
+        const soa_input<component_type> aC, const std::size_t aCount,
+        const vector3_soa<component_type> aClosest, component_type *const aDistancesSquared) {
+        for (std::size_t i = 0; i < aCount; ++i) {
+            const auto closest = closest_point_on_triangle(aPoint, detail::load(aA, i), detail::load(aB, i),
+                detail::load(aC, i));
+
+            detail::store(aClosest, i, closest);
+            aDistancesSquared[i] = (closest - aPoint).length_squared();
+        }
+
+        return detail::index_of_nearest(aDistancesSquared, aCount);
+    }
+
+    template<typename component_type>
+    std::size_t closest_points_on_aabbs(const vector3<component_type> &aPoint,
+        const soa_input<component_type> aMins, const soa_input<component_type> aMaxes,
+        const std::size_t aCount, const vector3_soa<component_type> aClosest, component_type *const aDistancesSquared) {
+        detail::closest_points_on_aabbs(aPoint.x, aPoint.y, aPoint.z, aMins.x, aMins.y, aMins.z,
+            aMaxes.x, aMaxes.y, aMaxes.z, aCount, aClosest.x, aClosest.y, aClosest.z, aDistancesSquared);
+
+        return detail::index_of_nearest(aDistancesSquared, aCount);
+    }
+
+    template<typename component_type>
+    std::size_t distances_squared_between_segments(const vector3<component_type> &aStart,
+        const vector3<component_type> &aEnd, const soa_input<component_type> aStarts,
+        const soa_input<component_type> aEnds, const std::size_t aCount,
+        component_type *const aDistancesSquared) {
+        for (std::size_t i = 0; i < aCount; ++i)
+            aDistancesSquared[i] = closest_points_between_segments(aStart, aEnd, detail::load(aStarts, i),
+                detail::load(aEnds, i)).distance_squared();
+
+        return detail::index_of_nearest(aDistancesSquared, aCount);
+    }
+GDK_MATH_END_NAMESPACE
+
+#undef GDK_MATH_DETAIL_RESTRICT
+
+#endif
@@ -0,0 +1,250 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_GPU_LAYOUT_INL
+#define GDK_MATH_IMPL_STD_GPU_LAYOUT_INL
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// every x86-64 processor has SSE2, so MSVC only says so for 32 bit targets. Undefined again below.
+#if !defined(GDK_MATH_DETAIL_SSE2) \
+    && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GDK_MATH_DETAIL_SSE2
+#endif
+
+#if defined(GDK_MATH_DETAIL_SSE2)
+#include <emmintrin.h>
+#endif
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! the stride of each element type, in components
+        template<typename value_type>
+        struct buffer_layout_traits;
+
+        template<typename component_type>
+        struct buffer_component_check {
+            static_assert(std::is_same<component_type, float>::value || std::is_same<component_type, double>::value,
+                "buffer layouts hold float or double components");
+        };
+
+        template<typename component_type>
+        struct buffer_layout_traits<vector2<component_type>> final : buffer_component_check<component_type> {
+            //! std140 rounds an array element up to 16 bytes, which a dvec2 already is
+            static constexpr std::size_t stride(const buffer_layout aLayout) {
+                constexpr auto PADDED = 16 / sizeof(component_type);
+
+                return aLayout == buffer_layout::std140 && PADDED > 2 ? PADDED : 2;
+            }
+        };
+
+        template<typename component_type>
+        struct buffer_layout_traits<vector3<component_type>> final : buffer_component_check<component_type> {
+            static constexpr std::size_t stride(const buffer_layout) { return 4; }
+        };
+
+        template<typename component_type>
+        struct buffer_layout_traits<vector4<component_type>> final : buffer_component_check<component_type> {
+            static constexpr std::size_t stride(const buffer_layout) { return 4; }
+        };
+
+        template<typename component_type>
+        struct buffer_layout_traits<matrix3x3<component_type>> final : buffer_component_check<component_type> {
+            static constexpr std::size_t stride(const buffer_layout) { return 12; }
+        };
+
+        template<typename component_type>
+        struct buffer_layout_traits<matrix4x4<component_type>> final : buffer_component_check<component_type> {
+            static constexpr std::size_t stride(const buffer_layout) { return 16; }
+        };
+
+#if defined(GDK_MATH_DETAIL_SSE2)
+        //! 16 bytes from aSource to aDestination, past the cache
+        inline void stream_16(float *const aDestination, const float *const aSource) {
+            _mm_stream_ps(aDestination, _mm_loadu_ps(aSource));
+        }
+
+        inline void stream_16(double *const aDestination, const double *const aSource) {
+            _mm_stream_pd(aDestination, _mm_loadu_pd(aSource));
+        }
+#endif
+
+        //! aCount elements of element_components components each to aDestination, the components of each
+        /// put by aElement(index, components) into a scratch element and copied out from there. Streamed 16
+        /// bytes at a time where that is possible, else copied.
+        template<typename component_type, std::size_t element_components, typename element_type>
+        void pack_elements(const std::size_t aCount, void *const aDestination, element_type &&aElement) {
+            constexpr auto ELEMENT_BYTES = element_components * sizeof(component_type);
+
+            auto *const out = static_cast<unsigned char *>(aDestination);
+
+            component_type element[element_components];
+
+#if defined(GDK_MATH_DETAIL_SSE2)
+            if (ELEMENT_BYTES % 16 == 0 && reinterpret_cast<std::uintptr_t>(aDestination) % 16 == 0) {
+                constexpr auto PER_STORE = 16 / sizeof(component_type);
+
+                auto *const destination = reinterpret_cast<component_type *>(out);
+
+                for (std::size_t i = 0; i < aCount; ++i) {
+                    aElement(i, element);
+
+                    for (std::size_t c = 0; c < element_components; c += PER_STORE)
+                        stream_16(destination + i * element_components + c, element + c);
+                }
+
+                // order the streaming stores before whatever hands the buffer on
+                _mm_sfence();
+
+                return;
+            }
+#endif
+
+            for (std::size_t i = 0; i < aCount; ++i) {
+                aElement(i, element);
+
+                std::memcpy(out + i * ELEMENT_BYTES, element, ELEMENT_BYTES);
+            }
+        }
+
+        //! a packed std430 float vec2 array is streamed a pair at a time, the odd one out copied
+        template<typename component_type, typename values_type>
+        void pack_vector2s(const values_type &aValues, const std::size_t aCount, const buffer_layout aLayout,
+            void *const aDestination) {
+            if (buffer_layout_traits<vector2<component_type>>::stride(aLayout) == 4) {
+                pack_elements<component_type, 4>(aCount, aDestination,
+                    [&](const std::size_t aIndex, component_type *const aOut) {
+                        const auto &v = aValues[aIndex];
+                        aOut[0] = v.x; aOut[1] = v.y; aOut[2] = 0; aOut[3] = 0;
+                    });
+
+                return;
+            }
+
+            pack_elements<component_type, 4>(aCount / 2, aDestination,
+                [&](const std::size_t aIndex, component_type *const aOut) {
+                    const auto &a = aValues[aIndex * 2], &b = aValues[aIndex * 2 + 1];
+                    aOut[0] = a.x; aOut[1] = a.y; aOut[2] = b.x; aOut[3] = b.y;
+                });
+
+            if (aCount % 2) {
+                const auto &last = aValues[aCount - 1];
+                const component_type tail[2] = {last.x, last.y};
+
+                std::memcpy(static_cast<unsigned char *>(aDestination) + (aCount - 1) * sizeof tail, tail,
+                    sizeof tail);
+            }
+        }
+
+        template<typename component_type, typename values_type>
+        void pack_vector3s(const values_type &aValues, const std::size_t aCount, void *const aDestination) {
+            pack_elements<component_type, 4>(aCount, aDestination,
+                [&](const std::size_t aIndex, component_type *const aOut) {
+                    const auto &v = aValues[aIndex];
+                    aOut[0] = v.x; aOut[1] = v.y; aOut[2] = v.z; aOut[3] = 0;
+                });
+        }
+
+        template<typename component_type, typename values_type>
+        void pack_vector4s(const values_type &aValues, const std::size_t aCount, void *const aDestination) {
+            pack_elements<component_type, 4>(aCount, aDestination,
+                [&](const std::size_t aIndex, component_type *const aOut) {
+                    const auto &v = aValues[aIndex];
+                    aOut[0] = v.x; aOut[1] = v.y; aOut[2] = v.z; aOut[3] = v.w;
+                });
+        }
+
+        template<typename component_type, typename values_type>
+        void pack_matrix3x3s(const values_type &aValues, const std::size_t aCount, void *const aDestination) {
+            pack_elements<component_type, 12>(aCount, aDestination,
+                [&](const std::size_t aIndex, component_type *const aOut) {
+                    const auto *const m = &aValues[aIndex].front();
+
+                    for (std::size_t column = 0; column < 3; ++column) {
+                        aOut[column * 4 + 0] = m[column * 3 + 0];
+                        aOut[column * 4 + 1] = m[column * 3 + 1];
+                        aOut[column * 4 + 2] = m[column * 3 + 2];
+                        aOut[column * 4 + 3] = 0;
+                    }
+                });
+        }
+
+        template<typename component_type, typename values_type>
+        void pack_matrix4x4s(const values_type &aValues, const std::size_t aCount, void *const aDestination) {
+            pack_elements<component_type, 16>(aCount, aDestination,
+                [&](const std::size_t aIndex, component_type *const aOut) {
+                    std::memcpy(aOut, &aValues[aIndex].front(), 16 * sizeof(component_type));
+                });
+        }
+    }
+
+    template<typename value_type>
+    constexpr std::size_t array_stride(const buffer_layout aLayout) {
+        return detail::buffer_layout_traits<value_type>::stride(aLayout) * sizeof(typename value_type::component_type);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const vector2<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout aLayout, void *const aDestination) {
+        detail::pack_vector2s<component_type>(aValues, aCount, aLayout, aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const vector3<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout, void *const aDestination) {
+        detail::pack_vector3s<component_type>(aValues, aCount, aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const vector4<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout, void *const aDestination) {
+        detail::pack_vector4s<component_type>(aValues, aCount, aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const matrix3x3<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout, void *const aDestination) {
+        detail::pack_matrix3x3s<component_type>(aValues, aCount, aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const matrix4x4<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout, void *const aDestination) {
+        detail::pack_matrix4x4s<component_type>(aValues, aCount, aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const vector2<component_type>> aValues, const buffer_layout aLayout,
+        void *const aDestination) {
+        detail::pack_vector2s<component_type>(aValues, aValues.size(), aLayout, aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const vector3<component_type>> aValues, const buffer_layout,
+        void *const aDestination) {
+        detail::pack_vector3s<component_type>(aValues, aValues.size(), aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const vector4<component_type>> aValues, const buffer_layout,
+        void *const aDestination) {
+        detail::pack_vector4s<component_type>(aValues, aValues.size(), aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const matrix3x3<component_type>> aValues, const buffer_layout,
+        void *const aDestination) {
+        detail::pack_matrix3x3s<component_type>(aValues, aValues.size(), aDestination);
+    }
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const matrix4x4<component_type>> aValues, const buffer_layout,
+        void *const aDestination) {
+        detail::pack_matrix4x4s<component_type>(aValues, aValues.size(), aDestination);
+    }
+GDK_MATH_END_NAMESPACE
+
+#undef GDK_MATH_DETAIL_SSE2
+
+#endif
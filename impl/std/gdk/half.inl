@@ -0,0 +1,271 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_HALF_INL
+#define GDK_MATH_IMPL_STD_HALF_INL
+
+#include <cstring>
+
+// F16C converts 8 floats to or from half in one instruction. MSVC has no flag of its own for it, and
+// every processor with AVX2 has it, so there it is used under /arch:AVX2. Undefined again below.
+#if !defined(GDK_MATH_DETAIL_F16C) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define GDK_MATH_DETAIL_F16C
+#endif
+
+#if defined(GDK_MATH_DETAIL_F16C)
+#include <immintrin.h>
+#endif
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        inline std::uint32_t bits_of_float(const float aValue) {
+            std::uint32_t bits;
+            std::memcpy(&bits, &aValue, sizeof bits);
+
+            return bits;
+        }
+
+        inline float float_of_bits(const std::uint32_t aBits) {
+            float value;
+            std::memcpy(&value, &aBits, sizeof value);
+
+            return value;
+        }
+
+        //! the half nearest aValue, ties to even. Every case is computed and the answer picked with all-ones
+        /// masks from integer compares: GCC turns nested selects back into branches, and loops of this
+        /// must stay free of them to vectorize.
+        inline std::uint16_t float_to_half_bits(const float aValue) {
+            const auto bits = bits_of_float(aValue);
+            const auto sign = (bits >> 16) & 0x8000u;
+            const auto magnitude = bits & 0x7fffffffu;
+
+            // rebias the exponent from 127 to 15, then round off the low 13 mantissa bits: adding just under
+            // half, plus the lowest bit kept, rounds ties to even. A carry out of the mantissa correctly
+            // raises the exponent, up to infinity.
+            const auto normal = (magnitude - ((127u - 15u) << 23) + 0xfffu + ((magnitude >> 13) & 1u)) >> 13;
+
+            // below 2^-14: adding 0.5 lines the value up with the last bits of 0.5's mantissa, and the float
+            // addition does the rounding
+            const auto subnormal = bits_of_float(float_of_bits(magnitude) + 0.5f) - bits_of_float(0.5f);
+
+            // the top of the mantissa carries over, and the quiet bit is set, as F16C does
+            const auto nan = 0u - static_cast<std::uint32_t>(magnitude > 0x7f800000u);
+            const auto infinityOrNaN = 0x7c00u | (nan & (0x200u | ((magnitude >> 13) & 0x3ffu)));
+
+            // 65520 and up round to infinity, through normal's carry until 2^16
+            const auto large = 0u - static_cast<std::uint32_t>(magnitude >= 0x47800000u);
+            const auto small = 0u - static_cast<std::uint32_t>(magnitude < 0x38800000u);
+
+            const auto result = (large & infinityOrNaN) | (~large & small & subnormal) | (~large & ~small & normal);
+
+            return static_cast<std::uint16_t>(sign | result);
+        }
+
+        //! the float equal to the half aBits, picked with masks as float_to_half_bits is
+        inline float half_bits_to_float(const std::uint16_t aBits) {
+            const auto bits = static_cast<std::uint32_t>(aBits);
+            const auto sign = (bits & 0x8000u) << 16;
+            const auto exponent = bits & 0x7c00u;
+            const auto shifted = (bits & 0x7fffu) << 13;
+
+            const auto normal = shifted + ((127u - 15u) << 23);
+            // a NaN keeps its payload and comes back quiet, as F16C converts it
+            const auto quiet = (0u - static_cast<std::uint32_t>((bits & 0x3ffu) != 0)) & 0x00400000u;
+            const auto infinityOrNaN = shifted | 0x7f800000u | quiet;
+            const auto subnormal = bits_of_float(static_cast<float>(bits & 0x3ffu) * (1.0f / (1u << 24)));
+
+            const auto special = 0u - static_cast<std::uint32_t>(exponent == 0x7c00u);
+            const auto zero = 0u - static_cast<std::uint32_t>(exponent == 0);
+
+            return float_of_bits(sign | (special & infinityOrNaN) | (~special & zero & subnormal)
+                | (~special & ~zero & normal));
+        }
+    }
+
+    inline half to_half(const float aValue) {
+#if defined(GDK_MATH_DETAIL_F16C)
+        return {static_cast<std::uint16_t>(_mm_extract_epi16(
+            _mm_cvtps_ph(_mm_set_ss(aValue), _MM_FROUND_TO_NEAREST_INT), 0))};
+#else
+        return {detail::float_to_half_bits(aValue)};
+#endif
+    }
+
+    inline float from_half(const half aValue) {
+#if defined(GDK_MATH_DETAIL_F16C)
+        return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(aValue.bits)));
+#else
+        return detail::half_bits_to_float(aValue.bits);
+#endif
+    }
+
+    template<typename component_type>
+    half_vector2 to_half(const vector2<component_type> &aVector) {
+        return {to_half(static_cast<float>(aVector.x)), to_half(static_cast<float>(aVector.y))};
+    }
+
+    template<typename component_type>
+    half_vector3 to_half(const vector3<component_type> &aVector) {
+        return {to_half(static_cast<float>(aVector.x)), to_half(static_cast<float>(aVector.y)),
+            to_half(static_cast<float>(aVector.z))};
+    }
+
+    template<typename component_type>
+    half_vector4 to_half(const vector4<component_type> &aVector) {
+        return {to_half(static_cast<float>(aVector.x)), to_half(static_cast<float>(aVector.y)),
+            to_half(static_cast<float>(aVector.z)), to_half(static_cast<float>(aVector.w))};
+    }
+
+    template<typename component_type>
+    half_quaternion to_half(const quaternion<component_type> &aRotation) {
+        return {to_half(static_cast<float>(aRotation.x)), to_half(static_cast<float>(aRotation.y)),
+            to_half(static_cast<float>(aRotation.z)), to_half(static_cast<float>(aRotation.w))};
+    }
+
+    template<typename component_type>
+    vector2<component_type> from_half(const half_vector2 &aVector) {
+        return {static_cast<component_type>(from_half(aVector.x)), static_cast<component_type>(from_half(aVector.y))};
+    }
+
+    template<typename component_type>
+    vector3<component_type> from_half(const half_vector3 &aVector) {
+        return {static_cast<component_type>(from_half(aVector.x)), static_cast<component_type>(from_half(aVector.y)),
+            static_cast<component_type>(from_half(aVector.z))};
+    }
+
+    template<typename component_type>
+    vector4<component_type> from_half(const half_vector4 &aVector) {
+        return {static_cast<component_type>(from_half(aVector.x)), static_cast<component_type>(from_half(aVector.y)),
+            static_cast<component_type>(from_half(aVector.z)), static_cast<component_type>(from_half(aVector.w))};
+    }
+
+    template<typename component_type>
+    quaternion<component_type> from_half(const half_quaternion &aRotation) {
+        return {static_cast<component_type>(from_half(aRotation.x)),
+            static_cast<component_type>(from_half(aRotation.y)),
+            static_cast<component_type>(from_half(aRotation.z)),
+            static_cast<component_type>(from_half(aRotation.w))};
+    }
+
+    inline void to_half(const float *const aValues, const std::size_t aCount, half *const aOut) {
+        std::size_t i = 0;
+
+#if defined(GDK_MATH_DETAIL_F16C)
+        for (; i + 8 <= aCount; i += 8) _mm_storeu_si128(reinterpret_cast<__m128i *>(aOut + i),
+            _mm256_cvtps_ph(_mm256_loadu_ps(aValues + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+
+        for (; i < aCount; ++i) aOut[i] = to_half(aValues[i]);
+    }
+
+    inline void from_half(const half *const aValues, const std::size_t aCount, float *const aOut) {
+        std::size_t i = 0;
+
+#if defined(GDK_MATH_DETAIL_F16C)
+        for (; i + 8 <= aCount; i += 8) _mm256_storeu_ps(aOut + i,
+            _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(aValues + i))));
+#endif
+
+        for (; i < aCount; ++i) aOut[i] = from_half(aValues[i]);
+    }
+
+    inline void to_half(const vector2<float> *const aVectors, const std::size_t aCount, half_vector2 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = to_half(aVectors[i]);
+    }
+
+    inline void to_half(const vector3<float> *const aVectors, const std::size_t aCount, half_vector3 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = to_half(aVectors[i]);
+    }
+
+    inline void to_half(const vector4<float> *const aVectors, const std::size_t aCount, half_vector4 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = to_half(aVectors[i]);
+    }
+
+    inline void to_half(const quaternion<float> *const aRotations, const std::size_t aCount,
+        half_quaternion *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = to_half(aRotations[i]);
+    }
+
+    inline void from_half(const half_vector2 *const aVectors, const std::size_t aCount, vector2<float> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = from_half(aVectors[i]);
+    }
+
+    inline void from_half(const half_vector3 *const aVectors, const std::size_t aCount, vector3<float> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = from_half(aVectors[i]);
+    }
+
+    inline void from_half(const half_vector4 *const aVectors, const std::size_t aCount, vector4<float> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = from_half(aVectors[i]);
+    }
+
+    inline void from_half(const half_quaternion *const aRotations, const std::size_t aCount,
+        quaternion<float> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = from_half(aRotations[i]);
+    }
+
+    inline void to_half(const strided_span<const float> aValues, const strided_span<half> aOut) {
+        detail::convert_span(aValues, aOut,
+            [](const auto... aArgs) { to_half(aArgs...); },
+            [](const float aValue) { return to_half(aValue); });
+    }
+
+    inline void to_half(const strided_span<const vector2<float>> aVectors, const strided_span<half_vector2> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { to_half(aArgs...); },
+            [](const vector2<float> &aVector) { return to_half(aVector); });
+    }
+
+    inline void to_half(const strided_span<const vector3<float>> aVectors, const strided_span<half_vector3> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { to_half(aArgs...); },
+            [](const vector3<float> &aVector) { return to_half(aVector); });
+    }
+
+    inline void to_half(const strided_span<const vector4<float>> aVectors, const strided_span<half_vector4> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { to_half(aArgs...); },
+            [](const vector4<float> &aVector) { return to_half(aVector); });
+    }
+
+    inline void to_half(const strided_span<const quaternion<float>> aRotations,
+        const strided_span<half_quaternion> aOut) {
+        detail::convert_span(aRotations, aOut,
+            [](const auto... aArgs) { to_half(aArgs...); },
+            [](const quaternion<float> &aRotation) { return to_half(aRotation); });
+    }
+
+    inline void from_half(const strided_span<const half> aValues, const strided_span<float> aOut) {
+        detail::convert_span(aValues, aOut,
+            [](const auto... aArgs) { from_half(aArgs...); },
+            [](const half aValue) { return from_half(aValue); });
+    }
+
+    inline void from_half(const strided_span<const half_vector2> aVectors, const strided_span<vector2<float>> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { from_half(aArgs...); },
+            [](const half_vector2 &aVector) { return from_half<float>(aVector); });
+    }
+
+    inline void from_half(const strided_span<const half_vector3> aVectors, const strided_span<vector3<float>> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { from_half(aArgs...); },
+            [](const half_vector3 &aVector) { return from_half<float>(aVector); });
+    }
+
+    inline void from_half(const strided_span<const half_vector4> aVectors, const strided_span<vector4<float>> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { from_half(aArgs...); },
+            [](const half_vector4 &aVector) { return from_half<float>(aVector); });
+    }
+
+    inline void from_half(const strided_span<const half_quaternion> aRotations,
+        const strided_span<quaternion<float>> aOut) {
+        detail::convert_span(aRotations, aOut,
+            [](const auto... aArgs) { from_half(aArgs...); },
+            [](const half_quaternion &aRotation) { return from_half<float>(aRotation); });
+    }
+GDK_MATH_END_NAMESPACE
+
+#undef GDK_MATH_DETAIL_F16C
+
+#endif
@@ -3,7 +3,7 @@
 #ifndef GDK_MATH_IMPL_STD_MATRIX3X3_INL
 #define GDK_MATH_IMPL_STD_MATRIX3X3_INL
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     template<typename component_type>
     constexpr std::size_t matrix3x3<component_type>::index(order_type aX, order_type aY) const {
         return aX * order + aY;
@@ -173,6 +173,6 @@ namespace gdk {
 
     template<typename component_type>
     const matrix3x3<component_type> matrix3x3<component_type>::identity = matrix3x3<component_type>();
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
@@ -3,7 +3,7 @@
 #ifndef GDK_MATH_IMPL_STD_MATRIX4X4_INL
 #define GDK_MATH_IMPL_STD_MATRIX4X4_INL
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     template<typename component_type>
     constexpr std::size_t matrix4x4<component_type>::index(order_type aX, order_type aY) const {
         return aX * order + aY;
@@ -427,6 +427,6 @@ namespace gdk {
 
     template<typename component_type> 
     const matrix4x4<component_type> matrix4x4<component_type>::identity = matrix4x4<component_type>();
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
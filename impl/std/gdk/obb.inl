@@ -0,0 +1,165 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_OBB_INL
+#define GDK_MATH_IMPL_STD_OBB_INL
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        template<typename component_type>
+        constexpr component_type absolute(const component_type aValue) {
+            return aValue < 0 ? -aValue : aValue;
+        }
+
+        //! the separating axis test of Gottschalk, Lin and Manocha, in the layout of Ericson's Real-Time
+        /// Collision Detection 4.4.1: b is expressed in a's frame, then the 3 face axes of a, the 3 of b
+        /// and the 9 edge cross products are tried in turn. aAxes are a's axes, passed in so a batch can
+        /// read them once.
+        template<typename component_type>
+        constexpr bool obb_overlap(const vector3<component_type> (&aAxes)[3], const obb<component_type> &a,
+            const obb<component_type> &b) {
+            // keeps near-parallel edges, whose cross product is near zero, from reporting a false separation
+            constexpr auto EPSILON = numbers::effectively_zero_length_squared_v<component_type>;
+
+            const vector3<component_type> bAxes[3] = {b.axis(0), b.axis(1), b.axis(2)};
+
+            component_type r[3][3] = {}, absR[3][3] = {};
+
+            for (int i = 0; i < 3; ++i) for (int j = 0; j < 3; ++j) {
+                r[i][j] = aAxes[i].dot_product(bAxes[j]);
+                absR[i][j] = absolute(r[i][j]) + EPSILON;
+            }
+
+            const auto offset = b.center - a.center;
+            const component_type t[3] = {
+                offset.dot_product(aAxes[0]), offset.dot_product(aAxes[1]), offset.dot_product(aAxes[2])};
+
+            const component_type ea[3] = {a.half_extents.x, a.half_extents.y, a.half_extents.z};
+            const component_type eb[3] = {b.half_extents.x, b.half_extents.y, b.half_extents.z};
+
+            for (int i = 0; i < 3; ++i) {
+                const auto rb = eb[0] * absR[i][0] + eb[1] * absR[i][1] + eb[2] * absR[i][2];
+
+                if (absolute(t[i]) > ea[i] + rb) return false;
+            }
+
+            for (int j = 0; j < 3; ++j) {
+                const auto ra = ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j];
+
+                if (absolute(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > ra + eb[j]) return false;
+            }
+
+            // a's axis i crossed with b's axis j
+            for (int i = 0; i < 3; ++i) {
+                const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+
+                for (int j = 0; j < 3; ++j) {
+                    const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+
+                    const auto ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+                    const auto rb = eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1];
+
+                    if (absolute(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    template<typename component_type>
+    constexpr obb<component_type>::obb(const vector3_type &aCenter, const vector3_type &aHalfExtents,
+        const matrix3x3_type &aOrientation)
+    : center(aCenter)
+    , half_extents(aHalfExtents)
+    , orientation(aOrientation)
+    {}
+
+    template<typename component_type>
+    obb<component_type> obb<component_type>::from_transform(const matrix4x4<component_type> &aTransform,
+        const aabb<component_type> &aLocalBounds) {
+        // a flattened axis keeps the identity's direction; its extent becomes zero either way
+        const vector3_type identityAxes[3] = {vector3_type::right, vector3_type::up, vector3_type::backward};
+
+        auto rotation = upper_left(aTransform);
+        auto halfExtents = aLocalBounds.half_extents();
+
+        for (std::size_t column = 0; column < matrix3x3_type::order; ++column) {
+            const vector3_type basis(rotation.get(column, 0), rotation.get(column, 1), rotation.get(column, 2));
+
+            const auto length = basis.length();
+            const auto unit = length > 0 ? basis / length : identityAxes[column];
+
+            for (std::size_t row = 0; row < matrix3x3_type::order; ++row) rotation.set(column, row, unit[row]);
+
+            halfExtents[column] *= length;
+        }
+
+        return {aTransform * aLocalBounds.center(), halfExtents, rotation};
+    }
+
+    template<typename component_type>
+    constexpr typename obb<component_type>::vector3_type obb<component_type>::axis(const std::size_t aIndex) const {
+        return {orientation.get(aIndex, 0), orientation.get(aIndex, 1), orientation.get(aIndex, 2)};
+    }
+
+    template<typename component_type>
+    constexpr bool obb<component_type>::contains(const vector3_type &aPoint) const {
+        const auto offset = aPoint - center;
+
+        return detail::absolute(offset.dot_product(axis(0))) <= half_extents.x
+            && detail::absolute(offset.dot_product(axis(1))) <= half_extents.y
+            && detail::absolute(offset.dot_product(axis(2))) <= half_extents.z;
+    }
+
+    template<typename component_type>
+    constexpr bool obb<component_type>::overlaps(const obb<component_type> &aOther) const {
+        const vector3_type axes[3] = {axis(0), axis(1), axis(2)};
+
+        return detail::obb_overlap(axes, *this, aOther);
+    }
+
+    template<typename component_type>
+    constexpr aabb<component_type> obb<component_type>::bounds() const {
+        vector3_type reach;
+
+        for (std::size_t world = 0; world < 3; ++world)
+            for (std::size_t local = 0; local < 3; ++local)
+                reach[world] += detail::absolute(orientation.get(local, world)) * half_extents[local];
+
+        return aabb<component_type>::from_center(center, reach);
+    }
+
+    namespace detail {
+        //! the batch overlaps, shared by arrays and views
+        template<typename component_type, typename others_type, typename results_type>
+        std::size_t obb_overlaps(const obb<component_type> &aBox, const others_type &aOthers,
+            const std::size_t aCount, const results_type &aResults) {
+            const vector3<component_type> axes[3] = {aBox.axis(0), aBox.axis(1), aBox.axis(2)};
+
+            std::size_t count = 0;
+
+            for (std::size_t i = 0; i < aCount; ++i) {
+                aResults[i] = obb_overlap(axes, aBox, aOthers[i]);
+                count += aResults[i];
+            }
+
+            return count;
+        }
+    }
+
+    template<typename component_type>
+    std::size_t overlaps(const obb<component_type> &aBox, const obb<component_type> *const aOthers,
+        const std::size_t aCount, bool *const aResults) {
+        return detail::obb_overlaps(aBox, aOthers, aCount, aResults);
+    }
+
+    template<typename component_type>
+    std::size_t overlaps(const obb<component_type> &aBox, const strided_span<const obb<component_type>> aOthers,
+        const strided_span<bool> aResults) {
+        if (aResults.size() < aOthers.size()) throw std::invalid_argument("overlaps: fewer results than boxes");
+
+        return detail::obb_overlaps(aBox, aOthers, aOthers.size(), aResults);
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -0,0 +1,201 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_OCTAHEDRAL_INL
+#define GDK_MATH_IMPL_STD_OCTAHEDRAL_INL
+
+#include <cmath>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! a point on the octahedral square, each coordinate on [-1, 1]
+        template<typename component_type>
+        struct octahedral_point final {
+            component_type u, v;
+        };
+
+        //! aVector projected onto the octahedron and, below the equator, folded over it. The fold is blended
+        /// in arithmetically: a select on a float compare can trap, so is not if-converted, and its branch
+        /// would keep the batch loops from vectorizing.
+        template<typename component_type>
+        octahedral_point<component_type> octahedral_fold(const vector3<component_type> &aVector) {
+            const auto x = aVector.x, y = aVector.y, z = aVector.z;
+            const auto ax = std::fabs(x), ay = std::fabs(y), az = std::fabs(z);
+
+            const auto scale = 1 / (ax + ay + az);
+            const auto u = x * scale, v = y * scale;
+
+            const auto foldedU = std::copysign(1 - ay * scale, x), foldedV = std::copysign(1 - ax * scale, y);
+
+            const auto below = static_cast<component_type>(z < 0);
+
+            return {u + (foldedU - u) * below, v + (foldedV - v) * below};
+        }
+
+        //! the unit vector at a point on the octahedral square. Normalized inline rather than by
+        /// vector3::normal, as the point on the octahedron is never zero, so normal's check is not needed.
+        /// Where std::sqrt sets errno, its error path still keeps the batch loops scalar.
+        template<typename component_type>
+        vector3<component_type> octahedral_unfold(const component_type u, const component_type v) {
+            const auto z = 1 - std::fabs(u) - std::fabs(v);
+            const auto fold = (std::fabs(z) - z) * static_cast<component_type>(0.5);
+
+            const auto x = u - std::copysign(fold, u), y = v - std::copysign(fold, v);
+
+            const auto scale = 1 / std::sqrt(x * x + y * y + z * z);
+
+            return {x * scale, y * scale, z * scale};
+        }
+
+        //! aValue, on [-1, 1], as a bits wide signed normalized integer, offset to be unsigned: 0 is -1,
+        /// 2^(bits - 1) - 1 is 0, and 2^bits - 2 is 1
+        template<unsigned bits, typename component_type>
+        constexpr std::uint32_t quantize_snorm(const component_type aValue) {
+            constexpr auto MAX = static_cast<component_type>((1u << (bits - 1)) - 1);
+
+            // non-negative, so the conversion's truncation rounds to nearest. Through a signed integer,
+            // which SIMD converts to directly
+            return static_cast<std::uint32_t>(static_cast<std::int32_t>(
+                aValue * MAX + MAX + static_cast<component_type>(0.5)));
+        }
+
+        template<unsigned bits, typename component_type>
+        constexpr component_type dequantize_snorm(const std::uint32_t aValue) {
+            constexpr auto MAX = static_cast<std::int32_t>((1u << (bits - 1)) - 1);
+
+            return static_cast<component_type>(static_cast<std::int32_t>(aValue) - MAX)
+                / static_cast<component_type>(MAX);
+        }
+    }
+
+    template<typename component_type>
+    octahedral16 encode16(const vector3<component_type> &aVector) {
+        const auto p = detail::octahedral_fold(aVector);
+
+        return {static_cast<std::uint16_t>(detail::quantize_snorm<8>(p.u) << 8 | detail::quantize_snorm<8>(p.v))};
+    }
+
+    template<typename component_type>
+    octahedral24 encode24(const vector3<component_type> &aVector) {
+        const auto p = detail::octahedral_fold(aVector);
+
+        const auto bits = detail::quantize_snorm<12>(p.u) << 12 | detail::quantize_snorm<12>(p.v);
+
+        return {{static_cast<std::uint8_t>(bits >> 16), static_cast<std::uint8_t>(bits >> 8),
+            static_cast<std::uint8_t>(bits)}};
+    }
+
+    template<typename component_type>
+    octahedral32 encode32(const vector3<component_type> &aVector) {
+        const auto p = detail::octahedral_fold(aVector);
+
+        return {detail::quantize_snorm<16>(p.u) << 16 | detail::quantize_snorm<16>(p.v)};
+    }
+
+    template<typename component_type>
+    vector3<component_type> decode(const octahedral16 &aEncoded) {
+        constexpr std::uint32_t MASK = (1u << 8) - 1;
+
+        return detail::octahedral_unfold(
+            detail::dequantize_snorm<8, component_type>((aEncoded.bits >> 8) & MASK),
+            detail::dequantize_snorm<8, component_type>(aEncoded.bits & MASK));
+    }
+
+    template<typename component_type>
+    vector3<component_type> decode(const octahedral24 &aEncoded) {
+        constexpr std::uint32_t MASK = (1u << 12) - 1;
+
+        const auto bits = static_cast<std::uint32_t>(aEncoded.bytes[0]) << 16
+            | static_cast<std::uint32_t>(aEncoded.bytes[1]) << 8
+            | static_cast<std::uint32_t>(aEncoded.bytes[2]);
+
+        return detail::octahedral_unfold(
+            detail::dequantize_snorm<12, component_type>((bits >> 12) & MASK),
+            detail::dequantize_snorm<12, component_type>(bits & MASK));
+    }
+
+    template<typename component_type>
+    vector3<component_type> decode(const octahedral32 &aEncoded) {
+        constexpr std::uint32_t MASK = (1u << 16) - 1;
+
+        return detail::octahedral_unfold(
+            detail::dequantize_snorm<16, component_type>((aEncoded.bits >> 16) & MASK),
+            detail::dequantize_snorm<16, component_type>(aEncoded.bits & MASK));
+    }
+
+    template<typename component_type>
+    void encode16(const vector3<component_type> *const aVectors, const std::size_t aCount,
+        octahedral16 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = encode16(aVectors[i]);
+    }
+
+    template<typename component_type>
+    void encode24(const vector3<component_type> *const aVectors, const std::size_t aCount,
+        octahedral24 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = encode24(aVectors[i]);
+    }
+
+    template<typename component_type>
+    void encode32(const vector3<component_type> *const aVectors, const std::size_t aCount,
+        octahedral32 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = encode32(aVectors[i]);
+    }
+
+    template<typename component_type>
+    void decode(const octahedral16 *const aEncoded, const std::size_t aCount, vector3<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = decode<component_type>(aEncoded[i]);
+    }
+
+    template<typename component_type>
+    void decode(const octahedral24 *const aEncoded, const std::size_t aCount, vector3<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = decode<component_type>(aEncoded[i]);
+    }
+
+    template<typename component_type>
+    void decode(const octahedral32 *const aEncoded, const std::size_t aCount, vector3<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = decode<component_type>(aEncoded[i]);
+    }
+
+    template<typename component_type>
+    void encode16(const strided_span<const vector3<component_type>> aVectors, const strided_span<octahedral16> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { encode16(aArgs...); },
+            [](const vector3<component_type> &aVector) { return encode16(aVector); });
+    }
+
+    template<typename component_type>
+    void encode24(const strided_span<const vector3<component_type>> aVectors, const strided_span<octahedral24> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { encode24(aArgs...); },
+            [](const vector3<component_type> &aVector) { return encode24(aVector); });
+    }
+
+    template<typename component_type>
+    void encode32(const strided_span<const vector3<component_type>> aVectors, const strided_span<octahedral32> aOut) {
+        detail::convert_span(aVectors, aOut,
+            [](const auto... aArgs) { encode32(aArgs...); },
+            [](const vector3<component_type> &aVector) { return encode32(aVector); });
+    }
+
+    template<typename component_type>
+    void decode(const strided_span<const octahedral16> aEncoded, const strided_span<vector3<component_type>> aOut) {
+        detail::convert_span(aEncoded, aOut,
+            [](const auto... aArgs) { decode(aArgs...); },
+            [](const octahedral16 &aValue) { return decode<component_type>(aValue); });
+    }
+
+    template<typename component_type>
+    void decode(const strided_span<const octahedral24> aEncoded, const strided_span<vector3<component_type>> aOut) {
+        detail::convert_span(aEncoded, aOut,
+            [](const auto... aArgs) { decode(aArgs...); },
+            [](const octahedral24 &aValue) { return decode<component_type>(aValue); });
+    }
+
+    template<typename component_type>
+    void decode(const strided_span<const octahedral32> aEncoded, const strided_span<vector3<component_type>> aOut) {
+        detail::convert_span(aEncoded, aOut,
+            [](const auto... aArgs) { decode(aArgs...); },
+            [](const octahedral32 &aValue) { return decode<component_type>(aValue); });
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
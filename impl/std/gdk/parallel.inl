@@ -0,0 +1,106 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_PARALLEL_INL
+#define GDK_MATH_IMPL_STD_PARALLEL_INL
+
+#include <gdk/detail/parallel.h>
+
+#include <array>
+#include <vector>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! below this many points per thread, a thread costs more than it saves
+        constexpr std::size_t BOUNDING_SPHERE_MINIMUM_CHUNK = 16384;
+
+        //! detail::bounding_sphere with each pass split across threads. Threads grow their own copies of
+        /// the starting sphere, which are merged at the end.
+        template<typename component_type, std::size_t direction_count, typename points_type>
+        sphere<component_type> bounding_sphere(const points_type &aPoints, const std::size_t aCount,
+            const std::array<vector3<component_type>, direction_count> &aDirections, const bool aAnyPair,
+            const std::size_t aThreadCount) {
+            if (aCount == 0) return {};
+
+            const auto chunks = chunk_count(aCount, aThreadCount, BOUNDING_SPHERE_MINIMUM_CHUNK);
+
+            std::vector<bounding_sphere_extremes<component_type, direction_count>> found(chunks);
+
+            parallel_chunks(aCount, chunks, [&](const std::size_t aBegin, const std::size_t aEnd,
+                const std::size_t aChunk) {
+                found[aChunk] = find_extremes(aPoints, aBegin, aEnd, aDirections);
+            });
+
+            auto all = found[0];
+
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk) all.merge(found[chunk]);
+
+            std::vector<sphere<component_type>> grown(chunks, starting_sphere(aPoints, all, aAnyPair));
+
+            parallel_chunks(aCount, chunks, [&](const std::size_t aBegin, const std::size_t aEnd,
+                const std::size_t aChunk) {
+                for (std::size_t i = aBegin; i < aEnd; ++i) grow_to_include(grown[aChunk], aPoints[i]);
+            });
+
+            auto result = grown[0];
+
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk) result = result.merged(grown[chunk]);
+
+            return result;
+        }
+
+        template<typename value_type, typename track_type>
+        void compress_tracks(const value_type *const *const aTracks, const std::size_t aTrackCount,
+            const std::size_t aFrameCount, const typename value_type::component_type aTolerance,
+            track_type *const aOut, const std::size_t aThreadCount) {
+            parallel_chunks(aTrackCount, chunk_count(aTrackCount, aThreadCount, 1),
+                [&](const std::size_t aBegin, const std::size_t aEnd, const std::size_t) {
+                    for (std::size_t i = aBegin; i < aEnd; ++i)
+                        compress_track(aTracks[i], aFrameCount, aTolerance, aOut[i]);
+                });
+        }
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_ritter(const vector3<component_type> *const aPoints,
+        const std::size_t aCount, const std::size_t aThreadCount) {
+        return detail::bounding_sphere(aPoints, aCount, detail::ritter_directions<component_type>(), false,
+            aThreadCount);
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_epos(const vector3<component_type> *const aPoints,
+        const std::size_t aCount, const std::size_t aThreadCount) {
+        return detail::bounding_sphere(aPoints, aCount, detail::epos_directions<component_type>(), true,
+            aThreadCount);
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_ritter(const strided_span<const vector3<component_type>> aPoints,
+        const std::size_t aThreadCount) {
+        return detail::bounding_sphere(aPoints, aPoints.size(), detail::ritter_directions<component_type>(), false,
+            aThreadCount);
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_epos(const strided_span<const vector3<component_type>> aPoints,
+        const std::size_t aThreadCount) {
+        return detail::bounding_sphere(aPoints, aPoints.size(), detail::epos_directions<component_type>(), true,
+            aThreadCount);
+    }
+
+    template<typename component_type>
+    void compress(const vector3<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_vector3_track<component_type> *const aOut, const std::size_t aThreadCount) {
+        detail::compress_tracks(aTracks, aTrackCount, aFrameCount, aTolerance, aOut, aThreadCount);
+    }
+
+    template<typename component_type>
+    void compress(const quaternion<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_quaternion_track<component_type> *const aOut, const std::size_t aThreadCount) {
+        detail::compress_tracks(aTracks, aTrackCount, aFrameCount, aTolerance, aOut, aThreadCount);
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
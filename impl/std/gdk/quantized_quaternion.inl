@@ -0,0 +1,264 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_QUANTIZED_QUATERNION_INL
+#define GDK_MATH_IMPL_STD_QUANTIZED_QUATERNION_INL
+
+#include <algorithm>
+#include <cmath>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! 1/sqrt(2): the largest a component other than a unit quaternion's largest can be
+        constexpr long double SQRT_HALF = 0.707106781186547524400844362104849039L;
+
+        //! the three components a packed quaternion keeps, in order, and the index of the one it drops
+        template<typename component_type>
+        struct smallest_three final {
+            std::uint32_t index;
+            component_type a, b, c;
+        };
+
+        //! the smallest three of aRotation, signed so that the dropped component is non-negative. Picked
+        /// with selects rather than branches, so the batch loops vectorize.
+        template<typename component_type>
+        constexpr smallest_three<component_type> split(const quaternion<component_type> &aRotation) {
+            const auto x = aRotation.x, y = aRotation.y, z = aRotation.z, w = aRotation.w;
+            const auto ax = x < 0 ? -x : x, ay = y < 0 ? -y : y, az = z < 0 ? -z : z, aw = w < 0 ? -w : w;
+
+            const auto xy = ay > ax ? ay : ax;
+            const std::uint32_t indexXY = ay > ax ? 1 : 0;
+            const auto zw = aw > az ? aw : az;
+            const std::uint32_t indexZW = aw > az ? 3 : 2;
+            const auto index = zw > xy ? indexZW : indexXY;
+
+            const auto largest = index == 0 ? x : index == 1 ? y : index == 2 ? z : w;
+            const auto sign = largest < 0 ? static_cast<component_type>(-1) : static_cast<component_type>(1);
+
+            return {index, (index == 0 ? y : x) * sign, (index <= 1 ? z : y) * sign, (index <= 2 ? w : z) * sign};
+        }
+
+        //! the unit quaternion whose smallest three these are
+        template<typename component_type>
+        quaternion<component_type> assemble(const std::uint32_t aIndex, const component_type a,
+            const component_type b, const component_type c) {
+            const auto largest = std::sqrt(std::max(static_cast<component_type>(0),
+                static_cast<component_type>(1) - a * a - b * b - c * c));
+
+            return {
+                aIndex == 0 ? largest : a,
+                aIndex == 1 ? largest : aIndex == 0 ? a : b,
+                aIndex == 2 ? largest : aIndex == 3 ? c : b,
+                aIndex == 3 ? largest : c
+            };
+        }
+
+        //! aValue, on [-1/sqrt(2), 1/sqrt(2)], to the nearest of aSteps + 1 evenly spaced values
+        template<typename component_type>
+        constexpr std::uint32_t quantize_smallest(const component_type aValue, const component_type aSteps) {
+            const auto unit = aValue * static_cast<component_type>(SQRT_HALF) + static_cast<component_type>(0.5);
+
+            // two unconditional compares rather than nested ones, which could trap and so are not if-converted
+            const auto raised = unit < 0 ? static_cast<component_type>(0) : unit;
+            const auto clamped = raised > 1 ? static_cast<component_type>(1) : raised;
+
+            // through a signed integer, which SIMD converts to directly
+            return static_cast<std::uint32_t>(
+                static_cast<std::int32_t>(clamped * aSteps + static_cast<component_type>(0.5)));
+        }
+
+        //! the value quantize_smallest gave aValue for
+        template<typename component_type>
+        constexpr component_type dequantize_smallest(const std::uint32_t aValue, const component_type aSteps) {
+            return (static_cast<component_type>(aValue) * (2 / aSteps) - 1) * static_cast<component_type>(SQRT_HALF);
+        }
+
+        //! aValue, on [-1/sqrt(2), 1/sqrt(2)], to the nearest of 2^bits evenly spaced steps
+        template<unsigned bits, typename component_type>
+        constexpr std::uint32_t quantize_smallest(const component_type aValue) {
+            return quantize_smallest(aValue, static_cast<component_type>((1u << bits) - 1));
+        }
+
+        template<unsigned bits, typename component_type>
+        constexpr component_type dequantize_smallest(const std::uint32_t aValue) {
+            return dequantize_smallest(aValue, static_cast<component_type>((1u << bits) - 1));
+        }
+
+        constexpr std::uint64_t bits_of(const packed_quaternion48 &aPacked) {
+            return static_cast<std::uint64_t>(aPacked.words[0]) << 32
+                | static_cast<std::uint64_t>(aPacked.words[1]) << 16
+                | static_cast<std::uint64_t>(aPacked.words[2]);
+        }
+    }
+
+    template<typename component_type>
+    packed_quaternion32 pack32(const quaternion<component_type> &aRotation) {
+        const auto s = detail::split(aRotation);
+
+        return {s.index << 30
+            | detail::quantize_smallest<10>(s.a) << 20
+            | detail::quantize_smallest<10>(s.b) << 10
+            | detail::quantize_smallest<10>(s.c)};
+    }
+
+    template<typename component_type>
+    packed_quaternion48 pack48(const quaternion<component_type> &aRotation) {
+        const auto s = detail::split(aRotation);
+
+        const auto bits = static_cast<std::uint64_t>(s.index) << 45
+            | static_cast<std::uint64_t>(detail::quantize_smallest<15>(s.a)) << 30
+            | static_cast<std::uint64_t>(detail::quantize_smallest<15>(s.b)) << 15
+            | static_cast<std::uint64_t>(detail::quantize_smallest<15>(s.c));
+
+        return {{static_cast<std::uint16_t>(bits >> 32), static_cast<std::uint16_t>(bits >> 16),
+            static_cast<std::uint16_t>(bits)}};
+    }
+
+    template<typename component_type>
+    quaternion<component_type> unpack(const packed_quaternion32 &aPacked) {
+        constexpr std::uint32_t MASK = (1u << 10) - 1;
+
+        return detail::assemble(aPacked.bits >> 30,
+            detail::dequantize_smallest<10, component_type>((aPacked.bits >> 20) & MASK),
+            detail::dequantize_smallest<10, component_type>((aPacked.bits >> 10) & MASK),
+            detail::dequantize_smallest<10, component_type>(aPacked.bits & MASK));
+    }
+
+    template<typename component_type>
+    quaternion<component_type> unpack(const packed_quaternion48 &aPacked) {
+        constexpr std::uint64_t MASK = (1u << 15) - 1;
+
+        const auto bits = detail::bits_of(aPacked);
+
+        return detail::assemble(static_cast<std::uint32_t>(bits >> 45),
+            detail::dequantize_smallest<15, component_type>(static_cast<std::uint32_t>((bits >> 30) & MASK)),
+            detail::dequantize_smallest<15, component_type>(static_cast<std::uint32_t>((bits >> 15) & MASK)),
+            detail::dequantize_smallest<15, component_type>(static_cast<std::uint32_t>(bits & MASK)));
+    }
+
+    template<typename component_type>
+    void pack32(const quaternion<component_type> *const aRotations, const std::size_t aCount,
+        packed_quaternion32 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = pack32(aRotations[i]);
+    }
+
+    template<typename component_type>
+    void pack48(const quaternion<component_type> *const aRotations, const std::size_t aCount,
+        packed_quaternion48 *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = pack48(aRotations[i]);
+    }
+
+    template<typename component_type>
+    void unpack(const packed_quaternion32 *const aPacked, const std::size_t aCount,
+        quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = unpack<component_type>(aPacked[i]);
+    }
+
+    template<typename component_type>
+    void unpack(const packed_quaternion48 *const aPacked, const std::size_t aCount,
+        quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i) aOut[i] = unpack<component_type>(aPacked[i]);
+    }
+
+    template<typename component_type>
+    void pack32(const strided_span<const quaternion<component_type>> aRotations,
+        const strided_span<packed_quaternion32> aOut) {
+        detail::convert_span(aRotations, aOut,
+            [](const auto... aArgs) { pack32(aArgs...); },
+            [](const quaternion<component_type> &aRotation) { return pack32(aRotation); });
+    }
+
+    template<typename component_type>
+    void pack48(const strided_span<const quaternion<component_type>> aRotations,
+        const strided_span<packed_quaternion48> aOut) {
+        detail::convert_span(aRotations, aOut,
+            [](const auto... aArgs) { pack48(aArgs...); },
+            [](const quaternion<component_type> &aRotation) { return pack48(aRotation); });
+    }
+
+    template<typename component_type>
+    void unpack(const strided_span<const packed_quaternion32> aPacked,
+        const strided_span<quaternion<component_type>> aOut) {
+        detail::convert_span(aPacked, aOut,
+            [](const auto... aArgs) { unpack(aArgs...); },
+            [](const packed_quaternion32 &aValue) { return unpack<component_type>(aValue); });
+    }
+
+    template<typename component_type>
+    void unpack(const strided_span<const packed_quaternion48> aPacked,
+        const strided_span<quaternion<component_type>> aOut) {
+        detail::convert_span(aPacked, aOut,
+            [](const auto... aArgs) { unpack(aArgs...); },
+            [](const packed_quaternion48 &aValue) { return unpack<component_type>(aValue); });
+    }
+
+    template<typename component_type>
+    void nlerp(const packed_quaternion32 *const aFrom, const packed_quaternion32 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i)
+            aOut[i] = nlerp(unpack<component_type>(aFrom[i]), unpack<component_type>(aTo[i]), aT);
+    }
+
+    template<typename component_type>
+    void nlerp(const packed_quaternion48 *const aFrom, const packed_quaternion48 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i)
+            aOut[i] = nlerp(unpack<component_type>(aFrom[i]), unpack<component_type>(aTo[i]), aT);
+    }
+
+    template<typename component_type>
+    void slerp(const packed_quaternion32 *const aFrom, const packed_quaternion32 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i)
+            aOut[i] = slerp(unpack<component_type>(aFrom[i]), unpack<component_type>(aTo[i]), aT);
+    }
+
+    template<typename component_type>
+    void slerp(const packed_quaternion48 *const aFrom, const packed_quaternion48 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut) {
+        for (std::size_t i = 0; i < aCount; ++i)
+            aOut[i] = slerp(unpack<component_type>(aFrom[i]), unpack<component_type>(aTo[i]), aT);
+    }
+
+    namespace detail {
+        //! aOut[i] = aInterpolate(aFrom[i], aTo[i]) for each element of aFrom, after checking the views' sizes
+        template<typename packed_type, typename component_type, typename interpolate_type>
+        void interpolate_packed(const strided_span<const packed_type> aFrom, const strided_span<const packed_type> aTo,
+            const strided_span<quaternion<component_type>> aOut, interpolate_type &&aInterpolate) {
+            if (aTo.size() < aFrom.size() || aOut.size() < aFrom.size())
+                throw std::invalid_argument("packed rotation interpolation: the views are smaller than aFrom");
+
+            for (std::size_t i = 0; i < aFrom.size(); ++i)
+                aOut[i] = aInterpolate(unpack<component_type>(aFrom[i]), unpack<component_type>(aTo[i]));
+        }
+    }
+
+    template<typename component_type>
+    void nlerp(const strided_span<const packed_quaternion32> aFrom, const strided_span<const packed_quaternion32> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut) {
+        detail::interpolate_packed(aFrom, aTo, aOut,
+            [aT](const auto &aA, const auto &aB) { return nlerp(aA, aB, aT); });
+    }
+
+    template<typename component_type>
+    void nlerp(const strided_span<const packed_quaternion48> aFrom, const strided_span<const packed_quaternion48> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut) {
+        detail::interpolate_packed(aFrom, aTo, aOut,
+            [aT](const auto &aA, const auto &aB) { return nlerp(aA, aB, aT); });
+    }
+
+    template<typename component_type>
+    void slerp(const strided_span<const packed_quaternion32> aFrom, const strided_span<const packed_quaternion32> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut) {
+        detail::interpolate_packed(aFrom, aTo, aOut,
+            [aT](const auto &aA, const auto &aB) { return slerp(aA, aB, aT); });
+    }
+
+    template<typename component_type>
+    void slerp(const strided_span<const packed_quaternion48> aFrom, const strided_span<const packed_quaternion48> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut) {
+        detail::interpolate_packed(aFrom, aTo, aOut,
+            [aT](const auto &aA, const auto &aB) { return slerp(aA, aB, aT); });
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -3,7 +3,7 @@
 #ifndef GDK_MATH_IMPL_STD_QUATERNION_INL
 #define GDK_MATH_IMPL_STD_QUATERNION_INL
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     template<typename component_type>
     quaternion<component_type> quaternion<component_type>::normalized() const {
         const component_type magnitude = std::sqrt(x * x + y * y + z * z + w * w);
@@ -209,6 +209,6 @@ namespace gdk {
 
     template <typename component_type>
     const quaternion<component_type> quaternion<component_type>::identity = quaternion();
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
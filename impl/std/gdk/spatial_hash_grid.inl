@@ -0,0 +1,324 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_SPATIAL_HASH_GRID_INL
+#define GDK_MATH_IMPL_STD_SPATIAL_HASH_GRID_INL
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! the cell coordinate of a value, clamped to 2^30 cells either side of the origin so that the
+        /// conversion is defined for distant and non-finite values too
+        template<typename component_type>
+        std::int32_t clamped_cell(const component_type aValue, const component_type aInverseCellSize) {
+            const auto limit = static_cast<component_type>(1 << 30);
+
+            return static_cast<std::int32_t>(std::max(-limit, std::min(limit,
+                std::floor(aValue * aInverseCellSize))));
+        }
+    }
+
+    template<typename component_type>
+    spatial_hash_grid<component_type>::spatial_hash_grid(const component_type aCellSize)
+    : m_CellSize(aCellSize)
+    , m_InverseCellSize(static_cast<component_type>(1) / aCellSize) {
+        if (!(aCellSize > 0)) throw std::domain_error("spatial_hash_grid cell size must be positive");
+
+        build(nullptr, 0);
+    }
+
+    template<typename component_type>
+    std::uint32_t spatial_hash_grid<component_type>::hash(const cell_type &aCell) {
+        auto h = static_cast<std::uint32_t>(aCell.x) * 0x8da6b343u
+            ^ static_cast<std::uint32_t>(aCell.y) * 0xd8163841u
+            ^ static_cast<std::uint32_t>(aCell.z) * 0xcb1ab31fu;
+
+        return h ^ (h >> 16);
+    }
+
+    template<typename component_type>
+    std::size_t spatial_hash_grid<component_type>::find(const cell_type &aCell) const {
+        const std::size_t mask = m_Slots.size() - 1;
+
+        for (std::size_t i = hash(aCell) & mask;; i = (i + 1) & mask) {
+            if (m_Slots[i].begin == EMPTY) return m_Slots.size();
+            if (m_Slots[i].cell == aCell) return i;
+        }
+    }
+
+    template<typename component_type>
+    std::size_t spatial_hash_grid<component_type>::find_or_insert(const cell_type &aCell) {
+        const std::size_t mask = m_Slots.size() - 1;
+
+        for (std::size_t i = hash(aCell) & mask;; i = (i + 1) & mask) {
+            auto &s = m_Slots[i];
+
+            if (s.begin == EMPTY) {
+                s = {aCell, 0, 0};
+                ++m_CellCount;
+
+                return i;
+            }
+
+            if (s.cell == aCell) return i;
+        }
+    }
+
+    template<typename component_type>
+    typename spatial_hash_grid<component_type>::cell_type
+    spatial_hash_grid<component_type>::cell_of(const vector3_type &aPoint) const {
+        return {
+            detail::clamped_cell(aPoint.x, m_InverseCellSize),
+            detail::clamped_cell(aPoint.y, m_InverseCellSize),
+            detail::clamped_cell(aPoint.z, m_InverseCellSize)};
+    }
+
+    template<typename component_type>
+    void spatial_hash_grid<component_type>::build(const vector3_type *const aPoints, const std::size_t aCount) {
+        build(aPoints, static_cast<const component_type *>(nullptr), aCount, false);
+    }
+
+    template<typename component_type>
+    void spatial_hash_grid<component_type>::build(const vector3_type *const aCenters,
+        const component_type *const aRadii, const std::size_t aCount) {
+        build(aCenters, aRadii, aCount, true);
+    }
+
+    template<typename component_type>
+    void spatial_hash_grid<component_type>::build(const strided_span<const vector3_type> aPoints) {
+        build(aPoints, static_cast<const component_type *>(nullptr), aPoints.size(), false);
+    }
+
+    template<typename component_type>
+    void spatial_hash_grid<component_type>::build(const strided_span<const vector3_type> aCenters,
+        const strided_span<const component_type> aRadii) {
+        if (aRadii.size() < aCenters.size()) throw std::invalid_argument("spatial_hash_grid: fewer radii than centers");
+
+        build(aCenters, aRadii, aCenters.size(), true);
+    }
+
+    template<typename component_type>
+    template<typename centers_type, typename radii_type>
+    void spatial_hash_grid<component_type>::build(const centers_type &aCenters, const radii_type &aRadii,
+        const std::size_t aCount, const bool aHasRadii) {
+        std::size_t capacity = 16;
+        while (capacity < aCount * 2) capacity *= 2;
+
+        m_Slots.assign(capacity, slot{cell_type(), EMPTY, 0});
+        m_Items.resize(aCount);
+        m_ItemSlot.resize(aCount);
+        m_CellCount = 0;
+        m_MaxRadius = 0;
+
+        m_MinCell = cell_type(1);
+        m_MaxCell = cell_type(0);
+
+        if (aCount) m_MinCell = m_MaxCell = cell_of(aCenters[0]);
+
+        // count the items per cell...
+        for (std::size_t i = 0; i < aCount; ++i) {
+            const auto cell = cell_of(aCenters[i]);
+            const auto s = find_or_insert(cell);
+
+            m_ItemSlot[i] = static_cast<std::uint32_t>(s);
+            ++m_Slots[s].end;
+
+            m_MinCell = cell_type::min(m_MinCell, cell);
+            m_MaxCell = cell_type::max(m_MaxCell, cell);
+        }
+
+        // ...give each cell its run of m_Items...
+        std::uint32_t running = 0;
+
+        for (auto &s : m_Slots) if (s.begin != EMPTY) {
+            const auto count = s.end;
+
+            s.begin = s.end = running;
+            running += count;
+        }
+
+        // ...and scatter into the runs, leaving each slot's end where it belongs
+        for (std::size_t i = 0; i < aCount; ++i) {
+            const auto radius = aHasRadii ? aRadii[i] : static_cast<component_type>(0);
+
+            m_Items[m_Slots[m_ItemSlot[i]].end++] = {aCenters[i], radius, static_cast<index_type>(i)};
+
+            m_MaxRadius = std::max(m_MaxRadius, radius);
+        }
+    }
+
+    template<typename component_type>
+    void spatial_hash_grid<component_type>::query_radius(const vector3_type &aCenter,
+        const component_type aRadius, std::vector<index_type> &aResults) const {
+        aResults.clear();
+
+        if (m_Items.empty()) return;
+
+        const auto reach = aRadius + m_MaxRadius;
+
+        // clamp before converting, so an enormous radius cannot overflow the cell coordinate
+        const auto to_cell = [&](const component_type aValue, const std::int32_t aMin, const std::int32_t aMax) {
+            const auto cell = std::floor(aValue * m_InverseCellSize);
+
+            return static_cast<std::int32_t>(std::max(static_cast<component_type>(aMin),
+                std::min(static_cast<component_type>(aMax), cell)));
+        };
+
+        const cell_type lo(to_cell(aCenter.x - reach, m_MinCell.x, m_MaxCell.x),
+            to_cell(aCenter.y - reach, m_MinCell.y, m_MaxCell.y),
+            to_cell(aCenter.z - reach, m_MinCell.z, m_MaxCell.z));
+
+        const cell_type hi(to_cell(aCenter.x + reach, m_MinCell.x, m_MaxCell.x),
+            to_cell(aCenter.y + reach, m_MinCell.y, m_MaxCell.y),
+            to_cell(aCenter.z + reach, m_MinCell.z, m_MaxCell.z));
+
+        const auto test_range = [&](const slot &aSlot) {
+            for (auto i = aSlot.begin; i < aSlot.end; ++i) {
+                const auto &it = m_Items[i];
+                const auto limit = aRadius + it.radius;
+
+                if ((it.position - aCenter).length_squared() <= limit * limit) aResults.push_back(it.index);
+            }
+        };
+
+        const auto cellsInRange = static_cast<std::uint64_t>(hi.x - lo.x + 1)
+            * static_cast<std::uint64_t>(hi.y - lo.y + 1)
+            * static_cast<std::uint64_t>(hi.z - lo.z + 1);
+
+        // past this many cells, walking the occupied ones is cheaper than probing for empties
+        if (cellsInRange > m_CellCount) {
+            for (const auto &s : m_Slots) if (s.begin != EMPTY) test_range(s);
+
+            return;
+        }
+
+        for (auto z = lo.z; z <= hi.z; ++z) for (auto y = lo.y; y <= hi.y; ++y) for (auto x = lo.x; x <= hi.x; ++x) {
+            const auto s = find({x, y, z});
+
+            if (s != m_Slots.size()) test_range(m_Slots[s]);
+        }
+    }
+
+    template<typename component_type>
+    void spatial_hash_grid<component_type>::query_nearest(const vector3_type &aPoint, const std::size_t aCount,
+        std::vector<index_type> &aResults) const {
+        aResults.clear();
+
+        if (m_Items.empty() || aCount == 0) return;
+
+        using candidate = std::pair<component_type, index_type>;
+
+        std::vector<candidate> heap;
+        heap.reserve(std::min(aCount, m_Items.size()) + 1);
+
+        const auto consider = [&](const slot &aSlot) {
+            for (auto i = aSlot.begin; i < aSlot.end; ++i) {
+                const candidate c((m_Items[i].position - aPoint).length_squared(), m_Items[i].index);
+
+                if (heap.size() == aCount) {
+                    if (!(c < heap.front())) continue;
+
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.pop_back();
+                }
+
+                heap.push_back(c);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        };
+
+        const auto visit = [&](const std::int64_t aX, const std::int64_t aY, const std::int64_t aZ) {
+            const auto s = find({static_cast<std::int32_t>(aX), static_cast<std::int32_t>(aY),
+                static_cast<std::int32_t>(aZ)});
+
+            if (s != m_Slots.size()) consider(m_Slots[s]);
+        };
+
+        // the query point may be far outside the occupied cells
+        const auto cell = cell_of(aPoint);
+
+        const std::int64_t c[3] = {cell.x, cell.y, cell.z};
+        const std::int64_t lo[3] = {m_MinCell.x, m_MinCell.y, m_MinCell.z};
+        const std::int64_t hi[3] = {m_MaxCell.x, m_MaxCell.y, m_MaxCell.z};
+
+        // rings nearer than this lie wholly outside the occupied cells, and rings past the last
+        // one have nothing left to find
+        std::int64_t first = 0, last = 0;
+
+        for (int i = 0; i < 3; ++i) {
+            first = std::max(first, std::max(lo[i] - c[i], c[i] - hi[i]));
+            last = std::max(last, std::max(hi[i] - c[i], c[i] - lo[i]));
+        }
+
+        // the number of occupied-box cells less than aShell cells from the query point's cell; as a
+        // double, since the box can span more cells than 64 bits count
+        const auto cells_within = [&](const std::int64_t aShell) {
+            double cells = 1;
+
+            for (int i = 0; i < 3; ++i) cells *= static_cast<double>(std::max<std::int64_t>(0,
+                std::min(c[i] + aShell - 1, hi[i]) - std::max(c[i] - aShell + 1, lo[i]) + 1));
+
+            return aShell > 0 ? cells : 0;
+        };
+
+        const auto cellsInBox = cells_within(last + 1);
+
+        // walk shells of cells outward: every cell of shell s is s cells from the query point's cell
+        for (auto s = first; s <= last; ++s) {
+            const auto nearest = static_cast<component_type>(s - 1) * m_CellSize;
+
+            if (heap.size() == aCount && s > 0 && heap.front().first <= nearest * nearest) break;
+
+            // past this many cells, walking the occupied ones is cheaper than probing for empties
+            if (cellsInBox - cells_within(s) > static_cast<double>(m_CellCount)) {
+                for (const auto &occupied : m_Slots) if (occupied.begin != EMPTY) {
+                    const std::int64_t at[3] = {occupied.cell.x, occupied.cell.y, occupied.cell.z};
+                    std::int64_t ring = 0;
+
+                    for (int i = 0; i < 3; ++i) ring = std::max(ring, std::abs(at[i] - c[i]));
+
+                    // the nearer shells have been walked already
+                    if (ring >= s) consider(occupied);
+                }
+
+                break;
+            }
+
+            for (auto z = std::max(c[2] - s, lo[2]); z <= std::min(c[2] + s, hi[2]); ++z) {
+                for (auto y = std::max(c[1] - s, lo[1]); y <= std::min(c[1] + s, hi[1]); ++y) {
+                    if (z == c[2] - s || z == c[2] + s || y == c[1] - s || y == c[1] + s) {
+                        for (auto x = std::max(c[0] - s, lo[0]); x <= std::min(c[0] + s, hi[0]); ++x)
+                            visit(x, y, z);
+                    }
+                    else {
+                        if (c[0] - s >= lo[0]) visit(c[0] - s, y, z);
+                        if (c[0] + s <= hi[0]) visit(c[0] + s, y, z);
+                    }
+                }
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+
+        for (const auto &found : heap) aResults.push_back(found.second);
+    }
+
+    template<typename component_type>
+    std::size_t spatial_hash_grid<component_type>::size() const {
+        return m_Items.size();
+    }
+
+    template<typename component_type>
+    std::size_t spatial_hash_grid<component_type>::cell_count() const {
+        return m_CellCount;
+    }
+
+    template<typename component_type>
+    component_type spatial_hash_grid<component_type>::cell_size() const {
+        return m_CellSize;
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
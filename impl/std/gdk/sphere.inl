@@ -0,0 +1,210 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_SPHERE_INL
+#define GDK_MATH_IMPL_STD_SPHERE_INL
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+GDK_MATH_BEGIN_NAMESPACE
+    template<typename component_type>
+    constexpr sphere<component_type>::sphere(const vector3_type &aCenter, const component_type aRadius)
+    : center(aCenter)
+    , radius(aRadius)
+    {}
+
+    template<typename component_type>
+    constexpr bool sphere<component_type>::contains(const vector3_type &aPoint) const {
+        return (aPoint - center).length_squared() <= radius * radius;
+    }
+
+    template<typename component_type>
+    bool sphere<component_type>::contains(const sphere<component_type> &aOther) const {
+        return center.distance_from(aOther.center) + aOther.radius <= radius;
+    }
+
+    template<typename component_type>
+    constexpr bool sphere<component_type>::overlaps(const sphere<component_type> &aOther) const {
+        const auto reach = radius + aOther.radius;
+
+        return (aOther.center - center).length_squared() <= reach * reach;
+    }
+
+    template<typename component_type>
+    sphere<component_type> sphere<component_type>::merged(const sphere<component_type> &aOther) const {
+        const auto offset = aOther.center - center;
+        const auto distance = offset.length();
+
+        if (distance + aOther.radius <= radius) return *this;
+        if (distance + radius <= aOther.radius) return aOther;
+
+        const auto mergedRadius = (distance + radius + aOther.radius) * static_cast<component_type>(0.5);
+
+        return {center + offset * ((mergedRadius - radius) / distance), mergedRadius};
+    }
+
+    template<typename component_type>
+    sphere<component_type> sphere<component_type>::merged(const vector3_type &aPoint) const {
+        return merged(sphere<component_type>(aPoint, 0));
+    }
+
+    template<typename component_type>
+    sphere<component_type> sphere<component_type>::transformed(const matrix4x4<component_type> &aTransform) const {
+        const auto scale = aTransform.scale();
+
+        return {aTransform * center, radius * std::max(scale.x, std::max(scale.y, scale.z))};
+    }
+
+    template<typename component_type>
+    constexpr bool sphere<component_type>::operator==(const sphere<component_type> &aOther) const {
+        return center == aOther.center && radius == aOther.radius;
+    }
+
+    template<typename component_type>
+    constexpr bool sphere<component_type>::operator!=(const sphere<component_type> &aOther) const {
+        return !(*this == aOther);
+    }
+
+    namespace detail {
+        //! grow aSphere just enough to take in aPoint, keeping the far side where it is
+        template<typename component_type>
+        void grow_to_include(sphere<component_type> &aSphere, const vector3<component_type> &aPoint) {
+            const auto offset = aPoint - aSphere.center;
+            const auto distanceSquared = offset.length_squared();
+
+            if (distanceSquared <= aSphere.radius * aSphere.radius) return;
+
+            const auto distance = std::sqrt(distanceSquared);
+            const auto grownRadius = (aSphere.radius + distance) * static_cast<component_type>(0.5);
+
+            aSphere.center += offset * ((grownRadius - aSphere.radius) / distance);
+            aSphere.radius = grownRadius;
+        }
+
+        //! the directions Ritter takes extreme points along: the axes
+        template<typename component_type>
+        std::array<vector3<component_type>, 3> ritter_directions() {
+            using vec = vector3<component_type>;
+
+            return {vec(1, 0, 0), vec(0, 1, 0), vec(0, 0, 1)};
+        }
+
+        //! the directions EPOS takes extreme points along: the axes and the cube's diagonals
+        template<typename component_type>
+        std::array<vector3<component_type>, 7> epos_directions() {
+            using vec = vector3<component_type>;
+
+            return {vec(1, 0, 0), vec(0, 1, 0), vec(0, 0, 1),
+                vec(1, 1, 1), vec(1, 1, -1), vec(1, -1, 1), vec(1, -1, -1)};
+        }
+
+        //! the indices of the points furthest along and against each direction, and how far they are
+        template<typename component_type, std::size_t direction_count>
+        struct bounding_sphere_extremes final {
+            std::array<std::size_t, direction_count> min, max;
+            std::array<component_type, direction_count> minValue, maxValue;
+
+            //! take in the extremes found over another range
+            void merge(const bounding_sphere_extremes &aOther) {
+                for (std::size_t d = 0; d < direction_count; ++d) {
+                    if (aOther.minValue[d] < minValue[d]) { minValue[d] = aOther.minValue[d]; min[d] = aOther.min[d]; }
+                    if (aOther.maxValue[d] > maxValue[d]) { maxValue[d] = aOther.maxValue[d]; max[d] = aOther.max[d]; }
+                }
+            }
+        };
+
+        //! the first pass shared by Ritter and EPOS, over the points [aBegin, aEnd), which must not be
+        /// empty. aPoints is an array or a strided_span.
+        template<typename component_type, std::size_t direction_count, typename points_type>
+        bounding_sphere_extremes<component_type, direction_count> find_extremes(const points_type &aPoints,
+            const std::size_t aBegin, const std::size_t aEnd,
+            const std::array<vector3<component_type>, direction_count> &aDirections) {
+            bounding_sphere_extremes<component_type, direction_count> e;
+
+            for (std::size_t d = 0; d < direction_count; ++d) {
+                e.min[d] = e.max[d] = aBegin;
+                e.minValue[d] = e.maxValue[d] = aPoints[aBegin].dot_product(aDirections[d]);
+            }
+
+            for (std::size_t i = aBegin + 1; i < aEnd; ++i) for (std::size_t d = 0; d < direction_count; ++d) {
+                const auto projection = aPoints[i].dot_product(aDirections[d]);
+
+                if (projection < e.minValue[d]) { e.minValue[d] = projection; e.min[d] = i; }
+                if (projection > e.maxValue[d]) { e.maxValue[d] = projection; e.max[d] = i; }
+            }
+
+            return e;
+        }
+
+        //! the sphere across the most distant pair of the extreme points, which the second pass grows.
+        /// Ritter only considers the two extremes of the same direction; aAnyPair considers every pair.
+        template<typename component_type, std::size_t direction_count, typename points_type>
+        sphere<component_type> starting_sphere(const points_type &aPoints,
+            const bounding_sphere_extremes<component_type, direction_count> &aExtremes, const bool aAnyPair) {
+            std::array<std::size_t, direction_count * 2> candidates;
+            for (std::size_t d = 0; d < direction_count; ++d) {
+                candidates[d * 2] = aExtremes.min[d];
+                candidates[d * 2 + 1] = aExtremes.max[d];
+            }
+
+            std::size_t first = candidates[0], second = candidates[1];
+            component_type widest = -1;
+
+            for (std::size_t i = 0; i < candidates.size(); ++i) {
+                for (std::size_t j = i + 1; j < candidates.size(); ++j) {
+                    if (!aAnyPair && (i % 2 != 0 || j != i + 1)) continue;
+
+                    const auto distanceSquared = (aPoints[candidates[i]] - aPoints[candidates[j]]).length_squared();
+
+                    if (distanceSquared > widest) {
+                        widest = distanceSquared;
+                        first = candidates[i];
+                        second = candidates[j];
+                    }
+                }
+            }
+
+            return {lerp(aPoints[first], aPoints[second], static_cast<component_type>(0.5)),
+                std::sqrt(widest) * static_cast<component_type>(0.5)};
+        }
+
+        //! the two-pass construction shared by Ritter and EPOS: find the extreme points along each
+        /// direction, take a sphere across the most distant candidate pair, then grow it over every point
+        template<typename component_type, std::size_t direction_count, typename points_type>
+        sphere<component_type> bounding_sphere(const points_type &aPoints, const std::size_t aCount,
+            const std::array<vector3<component_type>, direction_count> &aDirections, const bool aAnyPair) {
+            if (aCount == 0) return {};
+
+            auto result = starting_sphere(aPoints, find_extremes(aPoints, 0, aCount, aDirections), aAnyPair);
+
+            for (std::size_t i = 0; i < aCount; ++i) grow_to_include(result, aPoints[i]);
+
+            return result;
+        }
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_ritter(const vector3<component_type> *const aPoints,
+        const std::size_t aCount) {
+        return detail::bounding_sphere(aPoints, aCount, detail::ritter_directions<component_type>(), false);
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_epos(const vector3<component_type> *const aPoints,
+        const std::size_t aCount) {
+        return detail::bounding_sphere(aPoints, aCount, detail::epos_directions<component_type>(), true);
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_ritter(const strided_span<const vector3<component_type>> aPoints) {
+        return detail::bounding_sphere(aPoints, aPoints.size(), detail::ritter_directions<component_type>(), false);
+    }
+
+    template<typename component_type>
+    sphere<component_type> bounding_sphere_epos(const strided_span<const vector3<component_type>> aPoints) {
+        return detail::bounding_sphere(aPoints, aPoints.size(), detail::epos_directions<component_type>(), true);
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -3,10 +3,12 @@
 #ifndef GDK_MATH_IMPL_STD_STORAGE_INL
 #define GDK_MATH_IMPL_STD_STORAGE_INL
 
+#include <gdk/backend.h>
+
 #include <array>
 #include <cstddef>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     template<typename component_type>
     class vector2_storage {
     public:
@@ -71,6 +73,6 @@ namespace gdk {
         matrix4x4_storage &operator=(matrix4x4_storage &&) = default;
         ~matrix4x4_storage() = default;
     };
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
@@ -0,0 +1,225 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_STRIDED_SPAN_INL
+#define GDK_MATH_IMPL_STD_STRIDED_SPAN_INL
+
+#include <cstdint>
+
+GDK_MATH_BEGIN_NAMESPACE
+    template<typename value_type_param>
+    strided_span<value_type_param>::iterator::iterator(byte_type *const aElement, const std::size_t aStride)
+    : m_Element(aElement)
+    , m_Stride(aStride) {}
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator::reference
+    strided_span<value_type_param>::iterator::operator*() const {
+        return *reinterpret_cast<pointer>(m_Element);
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator::pointer
+    strided_span<value_type_param>::iterator::operator->() const {
+        return reinterpret_cast<pointer>(m_Element);
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator::reference
+    strided_span<value_type_param>::iterator::operator[](const difference_type aOffset) const {
+        return *(*this + aOffset);
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator &strided_span<value_type_param>::iterator::operator++() {
+        m_Element += m_Stride;
+
+        return *this;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator strided_span<value_type_param>::iterator::operator++(int) {
+        auto before = *this;
+        ++*this;
+
+        return before;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator &strided_span<value_type_param>::iterator::operator--() {
+        m_Element -= m_Stride;
+
+        return *this;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator strided_span<value_type_param>::iterator::operator--(int) {
+        auto before = *this;
+        --*this;
+
+        return before;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator &
+    strided_span<value_type_param>::iterator::operator+=(const difference_type aOffset) {
+        m_Element += aOffset * static_cast<difference_type>(m_Stride);
+
+        return *this;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator &
+    strided_span<value_type_param>::iterator::operator-=(const difference_type aOffset) {
+        return *this += -aOffset;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator
+    strided_span<value_type_param>::iterator::operator+(const difference_type aOffset) const {
+        auto moved = *this;
+
+        return moved += aOffset;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator
+    strided_span<value_type_param>::iterator::operator-(const difference_type aOffset) const {
+        auto moved = *this;
+
+        return moved -= aOffset;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator::difference_type
+    strided_span<value_type_param>::iterator::operator-(const iterator &aOther) const {
+        return (m_Element - aOther.m_Element) / static_cast<difference_type>(m_Stride);
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::iterator::operator==(const iterator &aOther) const {
+        return m_Element == aOther.m_Element;
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::iterator::operator!=(const iterator &aOther) const {
+        return !(*this == aOther);
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::iterator::operator<(const iterator &aOther) const {
+        return m_Element < aOther.m_Element;
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::iterator::operator>(const iterator &aOther) const {
+        return aOther < *this;
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::iterator::operator<=(const iterator &aOther) const {
+        return !(aOther < *this);
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::iterator::operator>=(const iterator &aOther) const {
+        return !(*this < aOther);
+    }
+
+    template<typename value_type_param>
+    strided_span<value_type_param>::strided_span(element_type *const aFirst, const std::size_t aCount)
+    : m_First(reinterpret_cast<byte_type *>(aFirst))
+    , m_Count(aCount) {}
+
+    template<typename value_type_param>
+    strided_span<value_type_param>::strided_span(void_type *const aFirst, const std::size_t aCount,
+        const std::size_t aStride)
+    : m_First(static_cast<byte_type *>(aFirst))
+    , m_Count(aCount)
+    , m_Stride(aStride) {
+        constexpr auto ALIGNMENT = alignof(value_type);
+
+        if (aStride == 0) throw std::invalid_argument("strided_span: the stride must be positive");
+
+        if (aStride < sizeof(value_type))
+            throw std::invalid_argument("strided_span: the stride is smaller than an element, so elements overlap");
+
+        if (reinterpret_cast<std::uintptr_t>(aFirst) % ALIGNMENT || aStride % ALIGNMENT)
+            throw std::invalid_argument("strided_span: the first element or the stride is misaligned");
+    }
+
+    template<typename value_type_param>
+    template<typename other_type, typename>
+    strided_span<value_type_param>::strided_span(const strided_span<other_type> &aOther)
+    : m_First(reinterpret_cast<byte_type *>(aOther.data()))
+    , m_Count(aOther.size())
+    , m_Stride(aOther.stride()) {}
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::element_type &
+    strided_span<value_type_param>::operator[](const std::size_t aIndex) const {
+        return *reinterpret_cast<element_type *>(m_First + aIndex * m_Stride);
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator strided_span<value_type_param>::begin() const {
+        return iterator(m_First, m_Stride);
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::iterator strided_span<value_type_param>::end() const {
+        return iterator(m_First + m_Count * m_Stride, m_Stride);
+    }
+
+    template<typename value_type_param>
+    strided_span<value_type_param> strided_span<value_type_param>::subspan(const std::size_t aOffset,
+        const std::size_t aCount) const {
+        if (aOffset > m_Count || aCount > m_Count - aOffset)
+            throw std::out_of_range("strided_span::subspan runs past the end");
+
+        strided_span<value_type_param> sub;
+        sub.m_First = m_First + aOffset * m_Stride;
+        sub.m_Count = aCount;
+        sub.m_Stride = m_Stride;
+
+        return sub;
+    }
+
+    template<typename value_type_param>
+    typename strided_span<value_type_param>::element_type *strided_span<value_type_param>::data() const {
+        return m_Count ? reinterpret_cast<element_type *>(m_First) : nullptr;
+    }
+
+    template<typename value_type_param>
+    std::size_t strided_span<value_type_param>::size() const {
+        return m_Count;
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::empty() const {
+        return m_Count == 0;
+    }
+
+    template<typename value_type_param>
+    std::size_t strided_span<value_type_param>::stride() const {
+        return m_Stride;
+    }
+
+    template<typename value_type_param>
+    bool strided_span<value_type_param>::is_contiguous() const {
+        return m_Stride == sizeof(value_type);
+    }
+
+    namespace detail {
+        template<typename in_type, typename out_type, typename batch_type, typename convert_type>
+        void convert_span(const strided_span<in_type> aIn, const strided_span<out_type> aOut,
+            batch_type &&aBatch, convert_type &&aConvert) {
+            if (aOut.size() < aIn.size())
+                throw std::invalid_argument("strided_span: the output is smaller than the input");
+
+            if (aIn.is_contiguous() && aOut.is_contiguous()) aBatch(aIn.data(), aIn.size(), aOut.data());
+            else for (std::size_t i = 0; i < aIn.size(); ++i) aOut[i] = aConvert(aIn[i]);
+        }
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
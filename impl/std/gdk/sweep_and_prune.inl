@@ -0,0 +1,244 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_SWEEP_AND_PRUNE_INL
+#define GDK_MATH_IMPL_STD_SWEEP_AND_PRUNE_INL
+
+#include <algorithm>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! more endpoints than this appended since the last sort and a full sort beats insertion
+        constexpr std::size_t SWEEP_AND_PRUNE_INSERTION_LIMIT = 64;
+    }
+
+    template<typename component_type>
+    sweep_and_prune<component_type>::sweep_and_prune(const std::size_t aAxis)
+    : m_Axis(aAxis) {
+        if (aAxis > 2) throw std::out_of_range("sweep_and_prune axis must be 0, 1 or 2");
+    }
+
+    template<typename component_type>
+    constexpr bool sweep_and_prune<component_type>::comes_before(const endpoint &a, const endpoint &b) {
+        return a.value < b.value || (a.value == b.value && (a.tag & 1u) < (b.tag & 1u));
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::check(const body_type aBody) const {
+        if (aBody >= m_Bounds.size() || m_EndpointIndex[aBody * 2] == DEAD)
+            throw std::out_of_range("sweep_and_prune: no such body");
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::check(const aabb_type &aBounds) {
+        // NaN endpoints have no place in the sort order
+        for (std::size_t i = 0; i < 3; ++i) if (aBounds.min[i] != aBounds.min[i] || aBounds.max[i] != aBounds.max[i])
+            throw std::invalid_argument("sweep_and_prune: the bounds are NaN");
+    }
+
+    template<typename component_type>
+    typename sweep_and_prune<component_type>::body_type
+    sweep_and_prune<component_type>::add(const aabb_type &aBounds) {
+        check(aBounds);
+
+        body_type body;
+
+        if (m_FreeBodies.empty()) {
+            body = static_cast<body_type>(m_Bounds.size());
+
+            m_Bounds.push_back(aBounds);
+            m_EndpointIndex.resize(m_EndpointIndex.size() + 2);
+        }
+        else {
+            body = m_FreeBodies.back();
+            m_FreeBodies.pop_back();
+
+            m_Bounds[body] = aBounds;
+        }
+
+        const auto tag = body * 2;
+
+        m_EndpointIndex[tag] = static_cast<std::uint32_t>(m_Endpoints.size());
+        m_Endpoints.push_back({aBounds.min[m_Axis], tag});
+
+        m_EndpointIndex[tag + 1] = static_cast<std::uint32_t>(m_Endpoints.size());
+        m_Endpoints.push_back({aBounds.max[m_Axis], tag + 1});
+
+        m_Appended += 2;
+
+        return body;
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::update(const body_type aBody, const aabb_type &aBounds) {
+        check(aBody);
+        check(aBounds);
+
+        m_Bounds[aBody] = aBounds;
+
+        m_Endpoints[m_EndpointIndex[aBody * 2]].value = aBounds.min[m_Axis];
+        m_Endpoints[m_EndpointIndex[aBody * 2 + 1]].value = aBounds.max[m_Axis];
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::remove(const body_type aBody) {
+        check(aBody);
+
+        for (std::uint32_t tag = aBody * 2; tag < aBody * 2 + 2; ++tag) {
+            m_Endpoints[m_EndpointIndex[tag]].tag = DEAD;
+            m_EndpointIndex[tag] = DEAD;
+        }
+
+        m_FreeBodies.push_back(aBody);
+
+        ++m_Removed;
+    }
+
+    template<typename component_type>
+    const typename sweep_and_prune<component_type>::aabb_type &
+    sweep_and_prune<component_type>::bounds(const body_type aBody) const {
+        check(aBody);
+
+        return m_Bounds[aBody];
+    }
+
+    template<typename component_type>
+    std::size_t sweep_and_prune<component_type>::size() const {
+        return m_Bounds.size() - m_FreeBodies.size();
+    }
+
+    template<typename component_type>
+    std::size_t sweep_and_prune<component_type>::axis() const {
+        return m_Axis;
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::set_axis(const std::size_t aAxis) {
+        if (aAxis > 2) throw std::out_of_range("sweep_and_prune axis must be 0, 1 or 2");
+
+        m_Axis = aAxis;
+
+        for (auto &e : m_Endpoints) if (e.tag != DEAD) {
+            const auto &bounds = m_Bounds[e.tag >> 1];
+
+            e.value = (e.tag & 1u) ? bounds.max[m_Axis] : bounds.min[m_Axis];
+        }
+
+        full_sort();
+    }
+
+    template<typename component_type>
+    std::size_t sweep_and_prune<component_type>::best_axis() const {
+        component_type sum[3] = {}, sumSquared[3] = {};
+        std::size_t counted = 0;
+
+        for (std::size_t body = 0; body < m_Bounds.size(); ++body) {
+            // the center of an empty box can be infinite or NaN
+            if (m_EndpointIndex[body * 2] == DEAD || m_Bounds[body].is_empty()) continue;
+
+            const auto center = m_Bounds[body].center();
+            ++counted;
+
+            for (std::size_t i = 0; i < 3; ++i) {
+                sum[i] += center[i];
+                sumSquared[i] += center[i] * center[i];
+            }
+        }
+
+        const auto count = static_cast<component_type>(std::max<std::size_t>(counted, 1));
+
+        std::size_t best = 0;
+        component_type bestVariance = -1;
+
+        for (std::size_t i = 0; i < 3; ++i) {
+            const auto variance = sumSquared[i] / count - (sum[i] / count) * (sum[i] / count);
+
+            if (variance > bestVariance) {
+                bestVariance = variance;
+                best = i;
+            }
+        }
+
+        return best;
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::full_sort() {
+        m_Endpoints.erase(std::remove_if(m_Endpoints.begin(), m_Endpoints.end(),
+            [](const endpoint &e) { return e.tag == DEAD; }), m_Endpoints.end());
+
+        std::sort(m_Endpoints.begin(), m_Endpoints.end(), comes_before);
+
+        for (std::size_t i = 0; i < m_Endpoints.size(); ++i)
+            m_EndpointIndex[m_Endpoints[i].tag] = static_cast<std::uint32_t>(i);
+
+        m_Appended = 0;
+        m_Removed = 0;
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::insertion_sort() {
+        auto *const endpoints = m_Endpoints.data();
+        auto *const index = m_EndpointIndex.data();
+
+        for (std::size_t i = 1; i < m_Endpoints.size(); ++i) {
+            const auto held = endpoints[i];
+
+            if (!comes_before(held, endpoints[i - 1])) continue;
+
+            auto j = i;
+
+            do {
+                endpoints[j] = endpoints[j - 1];
+                index[endpoints[j].tag] = static_cast<std::uint32_t>(j);
+                --j;
+            }
+            while (j > 0 && comes_before(held, endpoints[j - 1]));
+
+            endpoints[j] = held;
+            index[held.tag] = static_cast<std::uint32_t>(j);
+        }
+
+        m_Appended = 0;
+    }
+
+    template<typename component_type>
+    void sweep_and_prune<component_type>::find_pairs(std::vector<pair_type> &aPairs) {
+        aPairs.clear();
+
+        if (m_Removed || m_Appended > detail::SWEEP_AND_PRUNE_INSERTION_LIMIT) full_sort();
+        else insertion_sort();
+
+        m_Active.clear();
+        m_ActiveIndex.resize(m_Bounds.size());
+
+        for (const auto &e : m_Endpoints) {
+            const body_type body = e.tag >> 1;
+
+            // an empty box overlaps nothing, and an inverted one has its max sorted before its min
+            if (m_Bounds[body].is_empty()) continue;
+
+            if (e.tag & 1u) {
+                const auto slot = m_ActiveIndex[body];
+
+                m_Active[slot] = m_Active.back();
+                m_ActiveIndex[m_Active[slot]] = slot;
+                m_Active.pop_back();
+
+                continue;
+            }
+
+            const auto &bounds = m_Bounds[body];
+
+            for (const auto other : m_Active) {
+                if (!bounds.overlaps(m_Bounds[other])) continue;
+
+                aPairs.push_back(other < body ? pair_type(other, body) : pair_type(body, other));
+            }
+
+            m_ActiveIndex[body] = static_cast<std::uint32_t>(m_Active.size());
+            m_Active.push_back(body);
+        }
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -0,0 +1,499 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_IMPL_STD_TRANSFORM_DELTA_INL
+#define GDK_MATH_IMPL_STD_TRANSFORM_DELTA_INL
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! entities per block of the bit stream, each block with its own code parameters
+        constexpr std::size_t TRANSFORM_BLOCK = 64;
+
+        //! bits an exponential-Golomb parameter is written in
+        constexpr unsigned GOLOMB_PARAMETER_BITS = 5;
+
+        //! the furthest a position may be from the origin, in grid spacings
+        constexpr long double TRANSFORM_POSITION_LIMIT = 1073741824.0L;
+
+        //! the difference from an empty baseline: the origin
+        constexpr std::int32_t TRANSFORM_ORIGIN[3 * TRANSFORM_BLOCK] = {};
+
+        inline unsigned bit_width(const std::uint64_t aValue) {
+#if defined(__GNUC__) || defined(__clang__)
+            return aValue ? 64 - static_cast<unsigned>(__builtin_clzll(aValue)) : 0;
+#else
+            unsigned width = 0;
+            for (auto value = aValue; value; value >>= 1) ++width;
+
+            return width;
+#endif
+        }
+
+        //! a difference, taken modulo 2^32, as an unsigned value that is small when its magnitude is:
+        /// 0, -1, 1, -2, 2 become 0, 1, 2, 3, 4
+        constexpr std::uint32_t zigzag(const std::uint32_t aDifference) {
+            return (aDifference << 1) ^ (0u - (aDifference >> 31));
+        }
+
+        constexpr std::uint32_t unzigzag(const std::uint32_t aValue) {
+            return (aValue >> 1) ^ (0u - (aValue & 1));
+        }
+
+        //! bits aValue takes in the exponential-Golomb code of parameter aK
+        inline unsigned golomb_length(const std::uint32_t aValue, const unsigned aK) {
+            return 2 * bit_width((static_cast<std::uint64_t>(aValue) >> aK) + 1) - 1 + aK;
+        }
+
+        //! the parameter that writes the codes of the flagged entities, three each, in the fewest bits. Tried
+        /// either side of the log of their mean, which is near the best for the sizes of change typical of motion.
+        inline unsigned golomb_parameter(const std::uint32_t *const aCodes, const std::uint8_t *const aCoded,
+            const std::size_t aCount) {
+            std::uint64_t sum = 0;
+            std::size_t coded = 0;
+
+            for (std::size_t i = 0; i < aCount * 3; ++i) sum += aCodes[i];
+            for (std::size_t i = 0; i < aCount; ++i) coded += aCoded[i];
+
+            if (!coded) return 0;
+
+            const auto width = bit_width(sum / (coded * 3));
+            const auto estimate = width ? width - 1 : 0;
+
+            unsigned best = 0;
+            std::uint64_t bestLength = std::numeric_limits<std::uint64_t>::max();
+
+            for (unsigned k = estimate ? estimate - 1 : 0; k <= std::min(estimate + 1, 31u); ++k) {
+                std::uint64_t length = 0;
+
+                for (std::size_t i = 0; i < aCount; ++i) if (aCoded[i])
+                    length += golomb_length(aCodes[i * 3], k) + golomb_length(aCodes[i * 3 + 1], k)
+                        + golomb_length(aCodes[i * 3 + 2], k);
+
+                if (length < bestLength) {
+                    best = k;
+                    bestLength = length;
+                }
+            }
+
+            return best;
+        }
+
+        /// \brief appends bits to a byte vector, most significant first
+        class bit_writer final {
+            std::vector<std::uint8_t> &m_Out;
+
+            //! the bits not yet written out are the low m_Count of these
+            std::uint64_t m_Bits = 0;
+
+            unsigned m_Count = 0;
+
+        public:
+            explicit bit_writer(std::vector<std::uint8_t> &aOut)
+            : m_Out(aOut) {}
+
+            //! the low aBits, at most 32, of aValue
+            void write(const std::uint64_t aValue, const unsigned aBits) {
+                m_Bits = (m_Bits << aBits) | (aValue & ((std::uint64_t(1) << aBits) - 1));
+                m_Count += aBits;
+
+                while (m_Count >= 8) {
+                    m_Count -= 8;
+                    m_Out.push_back(static_cast<std::uint8_t>(m_Bits >> m_Count));
+                }
+            }
+
+            //! aValue in the exponential-Golomb code of parameter aK: aValue >> aK, plus one, in binary after
+            /// as many zeros as it has digits less one, then the low aK bits of aValue
+            void write_golomb(const std::uint32_t aValue, const unsigned aK) {
+                const auto high = (static_cast<std::uint64_t>(aValue) >> aK) + 1;
+                const auto width = bit_width(high);
+
+                write(0, width - 1);
+
+                if (width > 32) write(high >> 32, width - 32);
+
+                write(high, std::min(width, 32u));
+                write(aValue, aK);
+            }
+
+            //! pad with zeros to a whole byte
+            void flush() {
+                if (m_Count) write(0, 8 - m_Count);
+            }
+        };
+
+        /// \brief reads what bit_writer wrote, throwing std::runtime_error rather than reading past the end
+        class bit_reader final {
+            const std::uint8_t *m_First;
+            const std::uint8_t *const m_Last;
+
+            std::uint64_t m_Bits = 0;
+
+            unsigned m_Count = 0;
+
+        public:
+            bit_reader(const std::uint8_t *const aFirst, const std::uint8_t *const aLast)
+            : m_First(aFirst)
+            , m_Last(aLast) {}
+
+            //! the next aBits, at most 32
+            std::uint32_t read(const unsigned aBits) {
+                while (m_Count < aBits) {
+                    if (m_First == m_Last) throw std::runtime_error("transform delta stream is truncated");
+
+                    m_Bits = (m_Bits << 8) | *m_First++;
+                    m_Count += 8;
+                }
+
+                m_Count -= aBits;
+
+                return static_cast<std::uint32_t>((m_Bits >> m_Count) & ((std::uint64_t(1) << aBits) - 1));
+            }
+
+            std::uint32_t read_golomb(const unsigned aK) {
+                unsigned zeros = 0;
+
+                while (!read(1)) if (++zeros > 32) throw std::runtime_error("transform delta stream is malformed");
+
+                const auto high = ((std::uint64_t(1) << zeros) | read(zeros)) - 1;
+
+                if (high > (std::uint64_t(0xffffffffu) >> aK))
+                    throw std::runtime_error("transform delta stream is malformed");
+
+                return static_cast<std::uint32_t>(high << aK) | read(aK);
+            }
+
+            //! bits left unread
+            std::size_t remaining() const {
+                return static_cast<std::size_t>(m_Last - m_First) * 8 + m_Count;
+            }
+
+            //! one past the last byte read
+            const std::uint8_t *position() const {
+                return m_First;
+            }
+        };
+
+        template<typename component_type>
+        void check_precision(const transform_precision<component_type> &aPrecision) {
+            if (!(aPrecision.position > 0))
+                throw std::invalid_argument("transform_precision: the position spacing must be positive");
+
+            if (aPrecision.rotation_bits < 2 || aPrecision.rotation_bits > 15)
+                throw std::invalid_argument("transform_precision: rotation_bits must be from 2 to 15");
+        }
+
+        //! quantize, shared by arrays and views
+        template<typename component_type, typename positions_type, typename rotations_type>
+        void quantize_transforms(const positions_type &aPositions, const rotations_type &aRotations,
+            const std::size_t aCount, const transform_precision<component_type> &aPrecision,
+            transform_snapshot &aOut) {
+            check_precision(aPrecision);
+
+            aOut.rotation_bits = aPrecision.rotation_bits;
+            aOut.positions.resize(aCount * 3);
+            aOut.rotations.resize(aCount * 4);
+
+            const auto scale = 1 / aPrecision.position;
+            const auto limit = static_cast<component_type>(TRANSFORM_POSITION_LIMIT);
+            const auto steps = static_cast<component_type>((1u << aPrecision.rotation_bits) - 1);
+
+            std::int32_t *const positions = aOut.positions.data();
+            std::uint16_t *const rotations = aOut.rotations.data();
+
+            bool inRange = true;
+
+            for (std::size_t i = 0; i < aCount; ++i) {
+                const vector3<component_type> position = aPositions[i];
+                const component_type grid[3] = {position.x * scale, position.y * scale, position.z * scale};
+
+                for (std::size_t axis = 0; axis < 3; ++axis) {
+                    // selects that also send NaN to the limit, so the conversion is always defined
+                    const auto raised = grid[axis] >= -limit ? grid[axis] : -limit;
+                    const auto clamped = raised <= limit ? raised : limit;
+
+                    inRange &= (grid[axis] >= -limit) & (grid[axis] <= limit);
+
+                    positions[i * 3 + axis] = static_cast<std::int32_t>(
+                        clamped + (clamped < 0 ? static_cast<component_type>(-0.5) : static_cast<component_type>(0.5)));
+                }
+
+                const auto s = split(aRotations[i]);
+
+                rotations[i * 4] = static_cast<std::uint16_t>(s.index);
+                rotations[i * 4 + 1] = static_cast<std::uint16_t>(quantize_smallest(s.a, steps));
+                rotations[i * 4 + 2] = static_cast<std::uint16_t>(quantize_smallest(s.b, steps));
+                rotations[i * 4 + 3] = static_cast<std::uint16_t>(quantize_smallest(s.c, steps));
+            }
+
+            if (!inRange) throw std::out_of_range("transform position is too far from the origin, or not finite");
+        }
+
+        //! dequantize, shared by arrays and views
+        template<typename component_type, typename positions_type, typename rotations_type>
+        void dequantize_transforms(const transform_snapshot &aSnapshot,
+            const transform_precision<component_type> &aPrecision, const positions_type aPositions,
+            const rotations_type aRotations) {
+            check_precision(aPrecision);
+
+            if (aSnapshot.rotation_bits != aPrecision.rotation_bits)
+                throw std::invalid_argument("transform snapshot was quantized with other rotation_bits");
+
+            const auto steps = static_cast<component_type>((1u << aPrecision.rotation_bits) - 1);
+
+            for (std::size_t i = 0; i < aSnapshot.size(); ++i) {
+                const auto *const position = &aSnapshot.positions[i * 3];
+                const auto *const rotation = &aSnapshot.rotations[i * 4];
+
+                aPositions[i] = vector3<component_type>(static_cast<component_type>(position[0]) * aPrecision.position,
+                    static_cast<component_type>(position[1]) * aPrecision.position,
+                    static_cast<component_type>(position[2]) * aPrecision.position);
+
+                aRotations[i] = assemble(rotation[0], dequantize_smallest(rotation[1], steps),
+                    dequantize_smallest(rotation[2], steps), dequantize_smallest(rotation[3], steps));
+            }
+        }
+    }
+
+    inline std::size_t transform_snapshot::size() const {
+        return positions.size() / 3;
+    }
+
+    inline bool transform_snapshot::empty() const {
+        return positions.empty();
+    }
+
+    inline bool transform_snapshot::operator==(const transform_snapshot &aOther) const {
+        return rotation_bits == aOther.rotation_bits && positions == aOther.positions
+            && rotations == aOther.rotations;
+    }
+
+    inline bool transform_snapshot::operator!=(const transform_snapshot &aOther) const {
+        return !(*this == aOther);
+    }
+
+    template<typename component_type>
+    void quantize(const vector3<component_type> *const aPositions, const quaternion<component_type> *const aRotations,
+        const std::size_t aCount, const transform_precision<component_type> &aPrecision,
+        transform_snapshot &aOut) {
+        detail::quantize_transforms(aPositions, aRotations, aCount, aPrecision, aOut);
+    }
+
+    template<typename component_type>
+    void quantize(const strided_span<const vector3<component_type>> aPositions,
+        const strided_span<const quaternion<component_type>> aRotations,
+        const transform_precision<component_type> &aPrecision, transform_snapshot &aOut) {
+        if (aRotations.size() < aPositions.size())
+            throw std::invalid_argument("quantize: fewer rotations than positions");
+
+        detail::quantize_transforms(aPositions, aRotations, aPositions.size(), aPrecision, aOut);
+    }
+
+    template<typename component_type>
+    void dequantize(const transform_snapshot &aSnapshot, const transform_precision<component_type> &aPrecision,
+        vector3<component_type> *const aPositions, quaternion<component_type> *const aRotations) {
+        detail::dequantize_transforms(aSnapshot, aPrecision, aPositions, aRotations);
+    }
+
+    template<typename component_type>
+    void dequantize(const transform_snapshot &aSnapshot, const transform_precision<component_type> &aPrecision,
+        const strided_span<vector3<component_type>> aPositions,
+        const strided_span<quaternion<component_type>> aRotations) {
+        if (aPositions.size() < aSnapshot.size() || aRotations.size() < aSnapshot.size())
+            throw std::invalid_argument("dequantize: the views are smaller than the snapshot");
+
+        detail::dequantize_transforms(aSnapshot, aPrecision, aPositions, aRotations);
+    }
+
+    inline void encode_delta(const transform_snapshot &aBaseline, const transform_snapshot &aCurrent,
+        std::vector<std::uint8_t> &aOut) {
+        using detail::TRANSFORM_BLOCK;
+
+        const auto count = aCurrent.size();
+        const bool full = aBaseline.empty();
+
+        if (aCurrent.rotation_bits < 2 || aCurrent.rotation_bits > 15 || aCurrent.rotations.size() != count * 4
+            || aCurrent.positions.size() != count * 3 || count > 0xffffffffu)
+            throw std::invalid_argument("encode_delta: the snapshot is malformed");
+
+        if (!full && (aBaseline.size() != count || aBaseline.rotation_bits != aCurrent.rotation_bits
+            || aBaseline.rotations.size() != count * 4))
+            throw std::invalid_argument("encode_delta: the baseline does not match the snapshot");
+
+        detail::bit_writer writer(aOut);
+
+        writer.write(full, 1);
+        writer.write(aCurrent.rotation_bits, 4);
+        writer.write_golomb(static_cast<std::uint32_t>(count), 0);
+
+        std::uint32_t positionCodes[3 * TRANSFORM_BLOCK];
+        std::uint32_t rotationCodes[3 * TRANSFORM_BLOCK];
+        std::uint8_t positionChanged[TRANSFORM_BLOCK];
+        std::uint8_t rotationChanged[TRANSFORM_BLOCK];
+        std::uint8_t rotationWhole[TRANSFORM_BLOCK];
+        std::uint8_t rotationCoded[TRANSFORM_BLOCK];
+
+        for (std::size_t first = 0; first < count; first += TRANSFORM_BLOCK) {
+            const auto n = std::min(TRANSFORM_BLOCK, count - first);
+
+            const std::int32_t *const position = &aCurrent.positions[first * 3];
+            const std::uint16_t *const rotation = &aCurrent.rotations[first * 4];
+
+            // an empty baseline is the origin, and rotations compared with themselves, as they are sent whole
+            const std::int32_t *const basePosition = full
+                ? detail::TRANSFORM_ORIGIN
+                : &aBaseline.positions[first * 3];
+            const std::uint16_t *const baseRotation = full
+                ? rotation
+                : &aBaseline.rotations[first * 4];
+
+            for (std::size_t i = 0; i < n * 3; ++i) positionCodes[i] = detail::zigzag(
+                static_cast<std::uint32_t>(position[i]) - static_cast<std::uint32_t>(basePosition[i]));
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const bool whole = full | (rotation[i * 4] != baseRotation[i * 4]);
+
+                std::uint32_t any = 0;
+
+                for (std::size_t c = 0; c < 3; ++c) {
+                    const auto code = detail::zigzag(static_cast<std::uint32_t>(rotation[i * 4 + 1 + c])
+                        - static_cast<std::uint32_t>(baseRotation[i * 4 + 1 + c]));
+
+                    rotationCodes[i * 3 + c] = whole ? 0 : code;
+                    any |= code;
+                }
+
+                positionChanged[i] = (positionCodes[i * 3] | positionCodes[i * 3 + 1] | positionCodes[i * 3 + 2]) != 0;
+                rotationWhole[i] = whole;
+                rotationChanged[i] = whole | (any != 0);
+                rotationCoded[i] = !whole & (any != 0);
+            }
+
+            const auto positionK = detail::golomb_parameter(positionCodes, positionChanged, n);
+            const auto rotationK = detail::golomb_parameter(rotationCodes, rotationCoded, n);
+
+            writer.write(positionK, detail::GOLOMB_PARAMETER_BITS);
+            writer.write(rotationK, detail::GOLOMB_PARAMETER_BITS);
+
+            // each flag is left out where the ones before imply it
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!full) {
+                    const bool changed = positionChanged[i] | rotationChanged[i];
+
+                    writer.write(changed, 1);
+
+                    if (!changed) continue;
+                }
+
+                writer.write(positionChanged[i], 1);
+
+                if (positionChanged[i]) for (std::size_t c = 0; c < 3; ++c)
+                    writer.write_golomb(positionCodes[i * 3 + c], positionK);
+
+                if (!full && positionChanged[i]) writer.write(rotationChanged[i], 1);
+
+                if (!rotationChanged[i]) continue;
+
+                if (!full) writer.write(rotationWhole[i], 1);
+
+                if (rotationWhole[i]) {
+                    writer.write(rotation[i * 4], 2);
+
+                    for (std::size_t c = 0; c < 3; ++c) writer.write(rotation[i * 4 + 1 + c], aCurrent.rotation_bits);
+                }
+                else for (std::size_t c = 0; c < 3; ++c) writer.write_golomb(rotationCodes[i * 3 + c], rotationK);
+            }
+        }
+
+        writer.flush();
+    }
+
+    inline const std::uint8_t *decode_delta(const transform_snapshot &aBaseline, const std::uint8_t *const aFirst,
+        const std::uint8_t *const aLast, transform_snapshot &aOut) {
+        using detail::TRANSFORM_BLOCK;
+
+        detail::bit_reader reader(aFirst, aLast);
+
+        const bool full = reader.read(1);
+        const auto rotationBits = reader.read(4);
+        const auto count = static_cast<std::size_t>(reader.read_golomb(0));
+
+        // every entity takes at least a bit, which bounds what a malformed count can allocate
+        if (rotationBits < 2 || count > reader.remaining())
+            throw std::runtime_error("transform delta stream is malformed");
+
+        if (!full && (aBaseline.size() != count || aBaseline.rotation_bits != rotationBits))
+            throw std::runtime_error("transform delta stream was encoded against another baseline");
+
+        // decoded aside and moved into aOut only once the whole stream has been read, so that a bad
+        // stream leaves aOut, which is often the receiver's baseline, as it was
+        transform_snapshot decoded;
+        decoded.rotation_bits = rotationBits;
+        decoded.positions.resize(count * 3);
+        decoded.rotations.resize(count * 4);
+
+        const auto steps = (1u << rotationBits) - 1;
+
+        for (std::size_t first = 0; first < count; first += TRANSFORM_BLOCK) {
+            const auto n = std::min(TRANSFORM_BLOCK, count - first);
+
+            const auto positionK = reader.read(detail::GOLOMB_PARAMETER_BITS);
+            const auto rotationK = reader.read(detail::GOLOMB_PARAMETER_BITS);
+
+            for (std::size_t entity = first; entity < first + n; ++entity) {
+                std::int32_t *const position = &decoded.positions[entity * 3];
+                std::uint16_t *const rotation = &decoded.rotations[entity * 4];
+
+                const std::int32_t *const basePosition = full
+                    ? detail::TRANSFORM_ORIGIN
+                    : &aBaseline.positions[entity * 3];
+
+                const bool changed = full || reader.read(1);
+                const bool positionChanged = changed && reader.read(1);
+
+                for (std::size_t c = 0; c < 3; ++c) position[c] = static_cast<std::int32_t>(
+                    static_cast<std::uint32_t>(basePosition[c])
+                    + (positionChanged ? detail::unzigzag(reader.read_golomb(positionK)) : 0));
+
+                const bool rotationChanged = changed && (full || !positionChanged || reader.read(1));
+
+                if (!rotationChanged) {
+                    std::copy(&aBaseline.rotations[entity * 4], &aBaseline.rotations[entity * 4] + 4, rotation);
+
+                    continue;
+                }
+
+                if (full || reader.read(1)) {
+                    rotation[0] = static_cast<std::uint16_t>(reader.read(2));
+
+                    for (std::size_t c = 0; c < 3; ++c) rotation[1 + c] = static_cast<std::uint16_t>(
+                        reader.read(rotationBits));
+
+                    continue;
+                }
+
+                const std::uint16_t *const baseRotation = &aBaseline.rotations[entity * 4];
+
+                rotation[0] = baseRotation[0];
+
+                for (std::size_t c = 0; c < 3; ++c) {
+                    const auto value = baseRotation[1 + c] + detail::unzigzag(reader.read_golomb(rotationK));
+
+                    if (value > steps) throw std::runtime_error("transform delta stream is malformed");
+
+                    rotation[1 + c] = static_cast<std::uint16_t>(value);
+                }
+            }
+        }
+
+        aOut = std::move(decoded);
+
+        return reader.position();
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -3,7 +3,7 @@
 #ifndef GDK_MATH_IMPL_STD_VECTOR2_INL
 #define GDK_MATH_IMPL_STD_VECTOR2_INL
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     template<typename T> constexpr vector2<T> vector2<T>::min(const vector2<T> &a, const vector2<T> &b) {
         return {std::min(a.x, b.x), std::min(a.y, b.y)};
     }
@@ -237,6 +237,6 @@ namespace gdk {
     template <typename T> const vector2<T> vector2<T>::right = { 1, 0};
     template <typename T> const vector2<T> vector2<T>::up    = { 0, 1};
     template <typename T> const vector2<T> vector2<T>::zero  = { 0, 0};
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
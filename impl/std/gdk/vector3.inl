@@ -3,7 +3,7 @@
 #ifndef GDK_MATH_IMPL_STD_VECTOR3_INL
 #define GDK_MATH_IMPL_STD_VECTOR3_INL
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
 
     template <typename T> constexpr vector3<T> vector3<T>::min(const vector3<T> &a, const vector3<T> &b) {
         return { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) };
@@ -53,7 +53,7 @@ namespace gdk {
 
     template<typename component_type> 
     constexpr component_type vector3<component_type>::length_squared() const {
-        return (x * x) + (y * y) + (z * z);
+        return static_cast<component_type>((x * x) + (y * y) + (z * z));
     }
 
     template<typename component_type> 
@@ -105,36 +105,36 @@ namespace gdk {
     template<typename component_type>
     constexpr vector3<component_type> vector3<component_type>::operator+(const vector3<component_type> &that) const {
         return {
-            x + that.x,
-            y + that.y,
-            z + that.z
+            static_cast<component_type>(x + that.x),
+            static_cast<component_type>(y + that.y),
+            static_cast<component_type>(z + that.z)
         };
     }
 
     template<typename component_type>
     constexpr vector3<component_type> vector3<component_type>::operator-(const vector3<component_type> &that) const {
         return {
-            x - that.x,
-            y - that.y,
-            z - that.z
+            static_cast<component_type>(x - that.x),
+            static_cast<component_type>(y - that.y),
+            static_cast<component_type>(z - that.z)
         };
     }
 
     template<typename component_type>
     constexpr vector3<component_type> vector3<component_type>::operator-() const {
         return {
-            x * -1,
-            y * -1,
-            z * -1
+            static_cast<component_type>(-x),
+            static_cast<component_type>(-y),
+            static_cast<component_type>(-z)
         };
     }
 
     template<typename component_type>
     constexpr vector3<component_type> vector3<component_type>::operator*(const component_type aScalar) const {
         return {
-            x * aScalar,
-            y * aScalar,
-            z * aScalar
+            static_cast<component_type>(x * aScalar),
+            static_cast<component_type>(y * aScalar),
+            static_cast<component_type>(z * aScalar)
         };
     }
 
@@ -237,26 +237,26 @@ namespace gdk {
 
     template<typename component_type>
     constexpr component_type vector3<component_type>::dot_product(const vector3<component_type> &that) const {
-        return { x * that.x + y * that.y + z * that.z };
+        return static_cast<component_type>(x * that.x + y * that.y + z * that.z);
     }
 
     template<typename component_type>
     constexpr vector3<component_type> vector3<component_type>::cross_product(const vector3<component_type> &that) const {
         return { 
-            y * that.z - z * that.y,
-            z * that.x - x * that.z,
-            x * that.y - y * that.x
+            static_cast<component_type>(y * that.z - z * that.y),
+            static_cast<component_type>(z * that.x - x * that.z),
+            static_cast<component_type>(x * that.y - y * that.x)
         };
     }
 
     template<typename component_type>
     constexpr vector3<component_type> vector3<component_type>::element_wise_product(const vector3<component_type> &aOther) const {
         return { 
-            x * aOther.x, 
-            y * aOther.y, 
-            z * aOther.z
+            static_cast<component_type>(x * aOther.x), 
+            static_cast<component_type>(y * aOther.y), 
+            static_cast<component_type>(z * aOther.z)
         };
     }
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
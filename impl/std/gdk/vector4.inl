@@ -3,7 +3,7 @@
 #ifndef GDK_MATH_IMPL_STD_VECTOR4_INL
 #define GDK_MATH_IMPL_STD_VECTOR4_INL
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     template<typename component_type>
     constexpr vector3<component_type> vector4<component_type>::xyz() const {
         return {x, y, z};
@@ -50,6 +50,6 @@ namespace gdk {
     {}
 
     template<typename T> const vector4<T> vector4<T>::origin = {0., 0., 0., 1.};
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
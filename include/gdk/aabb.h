@@ -0,0 +1,93 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_AABB_H
+#define GDK_MATH_AABB_H
+
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief axis-aligned bounding box: the region between a min corner and a max corner
+    /// - **inclusive**: points and boxes on the surface are inside, and touching boxes overlap
+    /// - a box whose min exceeds its max on any axis is empty; see aabb::empty
+    template<typename component_type_param = float>
+    class aabb final {
+    public:
+        static_assert(std::is_floating_point<component_type_param>::value,
+            "component_type must be a floating point type");
+
+        using component_type = component_type_param;
+        using vector3_type = vector3<component_type_param>;
+
+        vector3_type min;
+        vector3_type max;
+
+        //! inverted to infinity: contains nothing, and merging anything into it gives that thing
+        static const aabb<component_type> empty;
+
+        //! the smallest box around a run of points. Empty for a count of zero.
+        [[nodiscard]] static constexpr aabb<component_type> from_points(const vector3_type *const aPoints,
+            const std::size_t aCount);
+
+        //! the smallest box around the points of a view, such as the positions in a vertex buffer
+        [[nodiscard]] static aabb<component_type> from_points(const strided_span<const vector3_type> aPoints);
+
+        //! the box of the given half extents about a center
+        [[nodiscard]] static constexpr aabb<component_type> from_center(const vector3_type &aCenter,
+            const vector3_type &aHalfExtents);
+
+        //! true when min exceeds max on any axis
+        [[nodiscard]] constexpr bool is_empty() const;
+
+        [[nodiscard]] constexpr vector3_type center() const;
+
+        //! half the size on each axis
+        [[nodiscard]] constexpr vector3_type half_extents() const;
+
+        [[nodiscard]] constexpr vector3_type size() const;
+
+        [[nodiscard]] constexpr component_type surface_area() const;
+
+        [[nodiscard]] constexpr bool contains(const vector3_type &aPoint) const;
+        [[nodiscard]] constexpr bool contains(const aabb<component_type> &aOther) const;
+
+        //! true when the boxes share any point, including a shared face
+        [[nodiscard]] constexpr bool overlaps(const aabb<component_type> &aOther) const;
+
+        //! the smallest box enclosing this and another box
+        [[nodiscard]] constexpr aabb<component_type> merged(const aabb<component_type> &aOther) const;
+
+        //! the smallest box enclosing this and a point
+        [[nodiscard]] constexpr aabb<component_type> merged(const vector3_type &aPoint) const;
+
+        //! grown by aMargin on every side. A negative margin shrinks.
+        [[nodiscard]] constexpr aabb<component_type> expanded(const component_type aMargin) const;
+
+        [[nodiscard]] constexpr bool operator==(const aabb<component_type> &aOther) const;
+        [[nodiscard]] constexpr bool operator!=(const aabb<component_type> &aOther) const;
+
+        constexpr aabb(const vector3_type &aMin, const vector3_type &aMax);
+
+        aabb<component_type> &operator=(const aabb<component_type> &) = default;
+
+        //! a zero size box at the origin
+        aabb() = default;
+        aabb(const aabb<component_type> &) = default;
+        aabb(aabb<component_type> &&) = default;
+        ~aabb() = default;
+    };
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/aabb.inl> // varies by implementation
+
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(aabb)
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -0,0 +1,137 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_ANIMATION_COMPRESSION_H
+#define GDK_MATH_ANIMATION_COMPRESSION_H
+
+#include <gdk/backend.h>
+#include <gdk/quaternion.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \file animation tracks sampled once per frame, reduced to the keys interpolation needs to stay within
+/// a tolerance, and stored at 16 bits per component.
+///
+/// Every sample is first quantized against the track's range: the least and greatest of each component
+/// over the whole track. Keys are then chosen greedily: from each kept key, the next is a frame such
+/// that interpolating between the two quantized keys reproduces every frame between within the
+/// tolerance, found by doubling the distance while that holds and then bisecting. Where the error only
+/// grows with distance, as it does for most motion, that is the furthest such frame; either way a track
+/// of n frames costs about n log n error measurements. The first and last frames are always kept. As the
+/// error is measured from the quantized keys, it bounds what playback gives, quantization included; a
+/// tolerance below the quantization error, about a 65536th of the track's range, keeps every frame.
+///
+/// vector3 tracks, translations and scales, are interpolated with lerp and their error is the distance
+/// from the source sample. quaternion tracks are interpolated with nlerp, the cheaper of the library's
+/// two, which also serves to renormalize the quantized keys; their error is the angle, in radians, from
+/// the source rotation. A rotation track's samples are first flipped where needed so that each is on
+/// the same side as the one before: q and -q are the same rotation, and the track's range is tighter.
+///
+/// Frames are positions in the track: 2.5 is halfway between the third and fourth samples. Sampling
+/// before the first or after the last frame gives the first or last key.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief a vector3 track's kept keys, each a frame index and three components quantized over the
+    /// track's range, stored contiguously in frame order
+    template<typename component_type>
+    struct compressed_vector3_track final {
+        //! how many frames the source track had
+        std::size_t frame_count = 0;
+
+        //! the least of each component over the track
+        vector3<component_type> minimum;
+
+        //! the size of one quantization step of each component
+        vector3<component_type> step;
+
+        //! the frame index of each kept key, ascending
+        std::vector<std::uint32_t> frames;
+
+        //! three quantized components per key
+        std::vector<std::uint16_t> values;
+    };
+
+    /// \brief a quaternion track's kept keys, each a frame index and four components quantized over the
+    /// track's range, stored contiguously in frame order
+    template<typename component_type>
+    struct compressed_quaternion_track final {
+        std::size_t frame_count = 0;
+
+        quaternion<component_type> minimum;
+
+        quaternion<component_type> step;
+
+        std::vector<std::uint32_t> frames;
+
+        //! four quantized components per key
+        std::vector<std::uint16_t> values;
+    };
+
+    //! aFrameCount samples, one per frame, reduced to within aTolerance of each, in the track's units.
+    /// An empty track for a count of zero.
+    template<typename component_type>
+    [[nodiscard]] compressed_vector3_track<component_type> compress(const vector3<component_type> *const aSamples,
+        const std::size_t aFrameCount, const component_type aTolerance);
+
+    //! aFrameCount unit rotations, one per frame, reduced to within aTolerance radians of each. An
+    /// empty track for a count of zero.
+    template<typename component_type>
+    [[nodiscard]] compressed_quaternion_track<component_type> compress(
+        const quaternion<component_type> *const aSamples, const std::size_t aFrameCount,
+        const component_type aTolerance);
+
+    //! compress over the samples of a view, such as one channel of interleaved clip data
+    template<typename component_type>
+    [[nodiscard]] compressed_vector3_track<component_type> compress(
+        const strided_span<const vector3<component_type>> aSamples, const component_type aTolerance);
+
+    template<typename component_type>
+    [[nodiscard]] compressed_quaternion_track<component_type> compress(
+        const strided_span<const quaternion<component_type>> aSamples, const component_type aTolerance);
+
+    //! compress each of aTrackCount tracks of aFrameCount samples, aTracks[i] to aOut[i]. gdk/parallel.h
+    /// splits the tracks across threads.
+    template<typename component_type>
+    void compress(const vector3<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_vector3_track<component_type> *const aOut);
+
+    template<typename component_type>
+    void compress(const quaternion<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_quaternion_track<component_type> *const aOut);
+
+    //! the track at aFrame. aTrack must have at least one key.
+    template<typename component_type>
+    [[nodiscard]] vector3<component_type> sample(const compressed_vector3_track<component_type> &aTrack,
+        const component_type aFrame);
+
+    template<typename component_type>
+    [[nodiscard]] quaternion<component_type> sample(const compressed_quaternion_track<component_type> &aTrack,
+        const component_type aFrame);
+
+    //! sample each of aCount tracks at the same aFrame: one pose of a clip
+    template<typename component_type>
+    void sample(const compressed_vector3_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, vector3<component_type> *const aOut);
+
+    template<typename component_type>
+    void sample(const compressed_quaternion_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, quaternion<component_type> *const aOut);
+
+    //! the pose written through a view, such as the bones of an instance buffer. Throws
+    /// std::invalid_argument if aOut is smaller than aCount.
+    template<typename component_type>
+    void sample(const compressed_vector3_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, const strided_span<vector3<component_type>> aOut);
+
+    template<typename component_type>
+    void sample(const compressed_quaternion_track<component_type> *const aTracks, const std::size_t aCount,
+        const component_type aFrame, const strided_span<quaternion<component_type>> aOut);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/animation_compression.inl> // varies by implementation
+
+#endif
@@ -0,0 +1,127 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_ANIMATION_SAMPLER_H
+#define GDK_MATH_ANIMATION_SAMPLER_H
+
+#include <gdk/backend.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/quaternion.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <vector>
+
+/// \file samples many keyframe tracks at one time, into a buffer of values or a pose.
+///
+/// Each track's keys are found from where the track's cursor last left them: forward playback moves
+/// a key or two per call, so finding them costs a few compares rather than a binary search. A cursor
+/// walks at most a few keys before falling back to a binary search, so a jump, a loop back to the start,
+/// or playing backwards costs no more than a search would.
+///
+/// Tracks are sampled in blocks: first each track's keys are found and gathered, with its
+/// interpolation parameter, into contiguous arrays; then one straight-line loop blends the whole block,
+/// which the optimizer can vectorize and which keeps the tracks' key arrays out of the blend.
+///
+/// A time before a track's first key gives the first key, and after its last key, the last. Outputs
+/// must not overlap inputs. Each output also comes as a strided_span, for values or bones written into
+/// an interleaved buffer; such a span must hold at least aCount, or std::invalid_argument is thrown.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief a track's keys: count values, each at the time of the same index, times ascending. A view:
+    /// the arrays belong to the caller. A track has at least one key.
+    template<typename value_type>
+    struct keyframe_track final {
+        const typename value_type::component_type *times;
+        const value_type *values;
+        std::size_t count;
+    };
+
+    /// \brief a translation, rotation and scale: one bone of a pose
+    template<typename component_type>
+    struct bone_transform final {
+        vector3<component_type> translation;
+        quaternion<component_type> rotation;
+        vector3<component_type> scale = vector3<component_type>(1);
+    };
+
+    /// \brief the key each of a set of tracks was last found at. One per animation instance: sampling
+    /// through it is what makes playback cheap. Grows to the number of tracks sampled if it is short.
+    struct animation_cursor final {
+        std::vector<std::size_t> keys;
+
+        animation_cursor() = default;
+
+        explicit animation_cursor(const std::size_t aTrackCount)
+        : keys(aTrackCount, 0) {}
+    };
+
+    //! how rotation tracks are blended between keys
+    enum class rotation_interpolation {
+        //! normalized linear: cheap, and close to slerp between keys near each other
+        nlerp,
+        //! spherical linear: constant angular velocity
+        slerp
+    };
+
+    //! each of aCount tracks at aTime, lerped between its keys
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, vector3<component_type> *const aOut);
+
+    //! each of aCount rotation tracks at aTime
+    template<typename component_type>
+    void sample(const keyframe_track<quaternion<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, quaternion<component_type> *const aOut,
+        const rotation_interpolation aInterpolation = rotation_interpolation::nlerp);
+
+    //! a pose of aCount bones at aTime, from a translation, rotation and scale track per bone. aScales
+    /// may be null, for a scale of one throughout; its type is not deduced, so null converts to it.
+    /// aCursor covers 3 * aCount tracks.
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        bone_transform<component_type> *const aOut,
+        const rotation_interpolation aInterpolation = rotation_interpolation::nlerp);
+
+    //! the same pose, as a matrix per bone
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        matrix4x4<component_type> *const aOut,
+        const rotation_interpolation aInterpolation = rotation_interpolation::nlerp);
+
+    //! each of aCount tracks at aTime, written through a view
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, const strided_span<vector3<component_type>> aOut);
+
+    template<typename component_type>
+    void sample(const keyframe_track<quaternion<component_type>> *const aTracks, const std::size_t aCount,
+        const component_type aTime, animation_cursor &aCursor, const strided_span<quaternion<component_type>> aOut,
+        const rotation_interpolation aInterpolation = rotation_interpolation::nlerp);
+
+    //! a pose written through a view
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        const strided_span<bone_transform<component_type>> aOut,
+        const rotation_interpolation aInterpolation = rotation_interpolation::nlerp);
+
+    template<typename component_type>
+    void sample(const keyframe_track<vector3<component_type>> *const aTranslations,
+        const keyframe_track<quaternion<component_type>> *const aRotations,
+        const keyframe_track<vector3<typename vector3<component_type>::component_type>> *const aScales,
+        const std::size_t aCount, const component_type aTime, animation_cursor &aCursor,
+        const strided_span<matrix4x4<component_type>> aOut,
+        const rotation_interpolation aInterpolation = rotation_interpolation::nlerp);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/animation_sampler.inl> // varies by implementation
+
+#endif
@@ -0,0 +1,136 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_ARRAY_FILE_H
+#define GDK_MATH_ARRAY_FILE_H
+
+#include <gdk/backend.h>
+#include <gdk/matrix3x3.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/quaternion.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector2.h>
+#include <gdk/vector3.h>
+#include <gdk/vector4.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// \file a binary file of one array of vectors, quaternions or matrices, read by mapping it into memory.
+///
+/// The file is a 64 byte header followed by the array exactly as it lies in memory, so reading it is a
+/// map and a check of the header: no parsing, and no copy until a page is first touched. The payload
+/// starts 64 bytes in, so with the mapping page aligned the values are aligned for any of the types.
+///
+/// Values are written in the writer's byte order and float format, and the header records the byte
+/// order: a reader of the other order rejects the file rather than swapping it. Only float and double
+/// components are written, their sizes being the same everywhere.
+///
+/// | bytes | field          |
+/// |-------|----------------|
+/// | 0-3   | "GDKA"         |
+/// | 4-7   | version        |
+/// | 8-11  | byte order mark, 0x01020304 as written |
+/// | 12-15 | element type   |
+/// | 16-19 | component type |
+/// | 20-23 | element size   |
+/// | 24-31 | element count  |
+/// | 32-39 | payload offset |
+/// | 40-63 | zero           |
+///
+/// Mapping a file takes platform headers that would otherwise reach every translation unit including
+/// this one, so it is compiled once, in src/array_file.cpp: link gdkmath_array_file to read array files.
+/// This header is not part of gdk/math.h for the same reason.
+GDK_MATH_BEGIN_NAMESPACE
+    //! what an array file holds
+    enum class array_file_element : std::uint32_t {
+        vector2 = 1,
+        vector3 = 2,
+        vector4 = 3,
+        quaternion = 4,
+        matrix3x3 = 5,
+        matrix4x4 = 6
+    };
+
+    //! the component type of an array file's elements
+    enum class array_file_component : std::uint32_t {
+        float32 = 1,
+        float64 = 2
+    };
+
+    /// \brief the first 64 bytes of an array file
+    struct array_file_header final {
+        static constexpr std::uint32_t CURRENT_VERSION = 1;
+        static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        array_file_element element;
+        array_file_component component;
+        std::uint32_t element_size;
+        std::uint64_t count;
+        std::uint64_t payload_offset;
+        std::uint8_t reserved[24];
+    };
+
+    static_assert(sizeof(array_file_header) == 64, "array_file_header must be 64 bytes");
+
+    namespace detail {
+        //! map the file at aPath read only, its size to aSize. Compiled in gdkmath_array_file.
+        /// \throws std::runtime_error if it cannot be opened or mapped, or is empty
+        const unsigned char *map_array_file(const std::string &aPath, std::size_t &aSize);
+
+        //! undo map_array_file
+        void unmap_array_file(const unsigned char *const aData, const std::size_t aSize);
+    }
+
+    //! write aCount values to a new array file at aPath, replacing any file there. value_type is a vector,
+    /// quaternion or matrix of float or double.
+    /// \throws std::runtime_error if the file cannot be written
+    template<typename value_type>
+    void write_array_file(const std::string &aPath, const value_type *const aValues, const std::size_t aCount);
+
+    /// \brief an array file mapped read only into memory, for as long as this lives
+    /// - the views it hands out point into the mapping, so must not outlive it
+    /// - move only; a moved from file is empty
+    class mapped_array_file final {
+    public:
+        //! map the file at aPath and check its header
+        /// \throws std::runtime_error if it cannot be opened or mapped, or is not a complete array file
+        /// of this version and byte order
+        explicit mapped_array_file(const std::string &aPath);
+
+        mapped_array_file(mapped_array_file &&aOther) noexcept;
+        mapped_array_file &operator=(mapped_array_file &&aOther) noexcept;
+
+        mapped_array_file(const mapped_array_file &) = delete;
+        mapped_array_file &operator=(const mapped_array_file &) = delete;
+
+        ~mapped_array_file();
+
+        [[nodiscard]] const array_file_header &header() const;
+
+        //! the number of elements in the payload
+        [[nodiscard]] std::size_t size() const;
+
+        //! true if the payload is an array of value_type
+        template<typename value_type>
+        [[nodiscard]] bool holds() const;
+
+        //! the payload, in place
+        /// \throws std::runtime_error unless the payload is an array of value_type
+        template<typename value_type>
+        [[nodiscard]] strided_span<const value_type> view() const;
+
+    private:
+        void unmap();
+
+        const unsigned char *m_Data = nullptr;
+        std::size_t m_Size = 0;
+    };
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/array_file.inl> // varies by implementation
+
+#endif
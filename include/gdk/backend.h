@@ -0,0 +1,29 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_BACKEND_H
+#define GDK_MATH_BACKEND_H
+
+/// \file the namespace the types are declared in, and the opt-in that keeps backends apart.
+///
+/// By default every type lives directly in gdk. Defining GDK_MATH_BACKEND_NAMESPACE, to a name such as
+/// std_ or sse, declares them in gdk::backend::<name> instead. Both levels are inline namespaces, so
+/// gdk::vector3 still names them; what changes is the symbol of every function, which now carries the
+/// backend's name.
+///
+/// A backend is picked by include path, so one translation unit sees one backend. Translation units
+/// built against different backends, each with its own GDK_MATH_BACKEND_NAMESPACE, link into one
+/// binary without their definitions of the same member colliding. Hot batch code can use a SIMD
+/// backend while the rest keeps impl/std. Values cross between them explicitly, as plain component
+/// arrays: see to_components and from_components in components.h.
+///
+/// The namespace must be the same for every translation unit built against a given backend.
+
+#if defined(GDK_MATH_BACKEND_NAMESPACE)
+#define GDK_MATH_BEGIN_NAMESPACE namespace gdk { inline namespace backend { inline namespace GDK_MATH_BACKEND_NAMESPACE {
+#define GDK_MATH_END_NAMESPACE }}}
+#else
+#define GDK_MATH_BEGIN_NAMESPACE namespace gdk {
+#define GDK_MATH_END_NAMESPACE }
+#endif
+
+#endif
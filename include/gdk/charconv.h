@@ -0,0 +1,108 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_CHARCONV_H
+#define GDK_MATH_CHARCONV_H
+
+#include <gdk/backend.h>
+#include <gdk/components.h>
+#include <gdk/strided_span.h>
+
+#include <charconv>
+#include <cstddef>
+#include <system_error>
+
+/// \file every type written to and read from text, after std::to_chars and std::from_chars.
+///
+/// A value is its components in the order of component_layout (see components.h), separated by single
+/// spaces: "1 2.5 -3" for a vector3, and a matrix column by column. Nothing is allocated, no locale is
+/// consulted, and no stream is involved, so this is fit for scene and configuration files of millions
+/// of values where operator<< and operator>> are not.
+///
+/// Floating point components are written in the fewest digits that read back to the same value, so
+/// text written here reloads bit for bit. Where the standard library lacks floating point to_chars
+/// and from_chars (__cpp_lib_to_chars undefined), the same round trip is kept by trying precisions
+/// through snprintf until strtod gives the value back: slower, and at the mercy of the C locale's
+/// decimal point, but exact.
+///
+/// Reading skips whitespace before each component, requires at least one whitespace character between
+/// components, and accepts what std::from_chars does: no leading '+', and no hexadecimal for floating
+/// point. As with std::from_chars, a value that fails to read is
+/// left unchanged.
+GDK_MATH_BEGIN_NAMESPACE
+    //! write aValue to [aFirst, aLast). On success ptr is one past the last character written; on
+    /// std::errc::value_too_large ptr is aLast and the contents of the range are unspecified.
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const vector2<component_type> &aValue);
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const vector3<component_type> &aValue);
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const vector4<component_type> &aValue);
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast,
+        const quaternion<component_type> &aValue);
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast,
+        const matrix3x3<component_type> &aValue);
+
+    template<typename component_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast,
+        const matrix4x4<component_type> &aValue);
+
+    //! read aValue from [aFirst, aLast). On success ptr is one past its last component; on
+    /// std::errc::invalid_argument or result_out_of_range ptr is the component that failed, and aValue is
+    /// unchanged.
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        vector2<component_type> &aValue);
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        vector3<component_type> &aValue);
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        vector4<component_type> &aValue);
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        quaternion<component_type> &aValue);
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        matrix3x3<component_type> &aValue);
+
+    template<typename component_type>
+    std::from_chars_result from_chars(const char *const aFirst, const char *const aLast,
+        matrix4x4<component_type> &aValue);
+
+    /// \brief how far a batch read got
+    struct from_chars_batch_result final {
+        //! one past the last value read, or where reading failed
+        const char *ptr;
+        //! std::errc() if every value read, or the error of the one that did not
+        std::errc ec;
+        //! the number of values read
+        std::size_t count;
+    };
+
+    //! write each value of aValues to [aFirst, aLast), a line each, every line ending in '\n'. Errors as
+    /// for one value.
+    template<typename value_type>
+    std::to_chars_result to_chars(char *const aFirst, char *const aLast, const strided_span<const value_type> aValues);
+
+    //! read values from [aFirst, aLast) into aOut until aOut is full or only whitespace is left. Values
+    /// may be split across lines or share them: all whitespace is alike, and some must follow each value
+    /// but the last. A value that fails to read stops the batch, as does one that runs straight into the
+    /// next character, with std::errc::invalid_argument; those before it are in aOut.
+    template<typename value_type>
+    from_chars_batch_result from_chars(const char *const aFirst, const char *const aLast,
+        const strided_span<value_type> aOut);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/charconv.inl> // varies by implementation
+
+#endif
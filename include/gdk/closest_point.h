@@ -0,0 +1,117 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_CLOSEST_POINT_H
+#define GDK_MATH_CLOSEST_POINT_H
+
+#include <gdk/backend.h>
+#include <gdk/aabb.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <type_traits>
+
+/// \file closest points and squared distances between points, segments, triangles and boxes.
+///
+/// Each query has a scalar form and a batch form. The batch forms test one query against many
+/// primitives stored as separate x, y and z arrays (see vector3_soa), so the common cases compile
+/// to straight-line loops the optimizer can vectorize. Each returns the index of the nearest
+/// primitive, or aCount when aCount is zero. Outputs must not overlap inputs.
+///
+/// The batch forms take no strided_span views. A view of vector3 is an array of structures, and
+/// reading one in these loops would gather each component from its own place, the cost the separate
+/// arrays are there to avoid; data kept interleaved is better copied out into arrays once.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief a run of 3d vectors stored structure-of-arrays: x[i], y[i] and z[i] are the i-th vector
+    /// - component_type may be const for read-only input
+    template<typename component_type>
+    struct vector3_soa final {
+        component_type *x;
+        component_type *y;
+        component_type *z;
+
+        constexpr vector3_soa(component_type *const aX, component_type *const aY, component_type *const aZ)
+        : x(aX), y(aY), z(aZ) {}
+
+        //! a writable run reads as a read-only one
+        template<typename other_type, typename = std::enable_if_t<
+            std::is_same<const other_type, component_type>::value && !std::is_const<other_type>::value>>
+        constexpr vector3_soa(const vector3_soa<other_type> &aOther)
+        : x(aOther.x), y(aOther.y), z(aOther.z) {}
+    };
+
+    //! read-only input to a batch form. Not deduced, so a writable vector3_soa converts to it.
+    template<typename component_type>
+    using soa_input = vector3_soa<const typename vector3<component_type>::component_type>;
+
+    //! the point on the segment from aStart to aEnd nearest to aPoint
+    template<typename component_type>
+    [[nodiscard]] constexpr vector3<component_type> closest_point_on_segment(const vector3<component_type> &aPoint,
+        const vector3<component_type> &aStart, const vector3<component_type> &aEnd);
+
+    //! the point on or inside the triangle aA, aB, aC nearest to aPoint. A degenerate triangle is
+    /// treated as the segment or point it collapses to.
+    template<typename component_type>
+    [[nodiscard]] constexpr vector3<component_type> closest_point_on_triangle(const vector3<component_type> &aPoint,
+        const vector3<component_type> &aA, const vector3<component_type> &aB, const vector3<component_type> &aC);
+
+    //! the point on or inside the box nearest to aPoint: aPoint clamped to the box
+    template<typename component_type>
+    [[nodiscard]] constexpr vector3<component_type> closest_point_on_aabb(const vector3<component_type> &aPoint,
+        const aabb<component_type> &aBox);
+
+    /// \brief the nearest pair of points between two segments
+    template<typename component_type>
+    struct segment_closest_points final {
+        //! the nearest point on the first segment, and its parameter along it in [0, 1]
+        vector3<component_type> first;
+        component_type s;
+
+        //! the nearest point on the second segment, and its parameter along it in [0, 1]
+        vector3<component_type> second;
+        component_type t;
+
+        [[nodiscard]] constexpr component_type distance_squared() const {
+            return (second - first).length_squared();
+        }
+    };
+
+    //! the nearest points between segment aStart0 to aEnd0 and segment aStart1 to aEnd1, after Ericson's
+    /// Real-Time Collision Detection 5.1.9. Parallel segments pick one of the equally near pairs.
+    template<typename component_type>
+    [[nodiscard]] constexpr segment_closest_points<component_type> closest_points_between_segments(
+        const vector3<component_type> &aStart0, const vector3<component_type> &aEnd0,
+        const vector3<component_type> &aStart1, const vector3<component_type> &aEnd1);
+
+    //! closest_point_on_segment of aPoint against aCount segments. Writes each nearest point to
+    /// aClosest and its squared distance to aDistancesSquared.
+    template<typename component_type>
+    std::size_t closest_points_on_segments(const vector3<component_type> &aPoint,
+        const soa_input<component_type> aStarts, const soa_input<component_type> aEnds,
+        const std::size_t aCount, const vector3_soa<component_type> aClosest, component_type *const aDistancesSquared);
+
+    //! closest_point_on_triangle of aPoint against aCount triangles, as closest_points_on_segments
+    template<typename component_type>
+    std::size_t closest_points_on_triangles(const vector3<component_type> &aPoint,
+        const soa_input<component_type> aA, const soa_input<component_type> aB,
+        const soa_input<component_type> aC, const std::size_t aCount,
+        const vector3_soa<component_type> aClosest, component_type *const aDistancesSquared);
+
+    //! closest_point_on_aabb of aPoint against aCount boxes given by their min and max corners,
+    /// as closest_points_on_segments
+    template<typename component_type>
+    std::size_t closest_points_on_aabbs(const vector3<component_type> &aPoint,
+        const soa_input<component_type> aMins, const soa_input<component_type> aMaxes,
+        const std::size_t aCount, const vector3_soa<component_type> aClosest, component_type *const aDistancesSquared);
+
+    //! the squared distance between segment aStart to aEnd and each of aCount segments, written to
+    /// aDistancesSquared: the core of a capsule against many capsules
+    template<typename component_type>
+    std::size_t distances_squared_between_segments(const vector3<component_type> &aStart,
+        const vector3<component_type> &aEnd, const soa_input<component_type> aStarts,
+        const soa_input<component_type> aEnds, const std::size_t aCount,
+        component_type *const aDistancesSquared);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/closest_point.inl> // varies by implementation
+
+#endif
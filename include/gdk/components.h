@@ -0,0 +1,131 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_COMPONENTS_H
+#define GDK_MATH_COMPONENTS_H
+
+#include <gdk/backend.h>
+#include <gdk/matrix3x3.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/quaternion.h>
+#include <gdk/vector2.h>
+#include <gdk/vector3.h>
+#include <gdk/vector4.h>
+
+#include <array>
+#include <cstddef>
+
+/// \file every type as a flat array of its components, and back.
+///
+/// An array of components means the same thing to every backend, whatever a backend's storage looks
+/// like, so it is how values cross between translation units built against different backends (see
+/// backend.h): one side calls to_components, the other from_components.
+GDK_MATH_BEGIN_NAMESPACE
+    //! the order of a type's components in its array. Vectors are x, y, z, w; quaternions x, y, z, w;
+    /// matrices column by column, as get(column, row).
+    template<typename value_type>
+    struct component_layout;
+
+    template<typename component_type>
+    struct component_layout<vector2<component_type>> final {
+        static constexpr std::size_t size = 2;
+
+        static constexpr std::array<component_type, size> to(const vector2<component_type> &aValue) {
+            return {aValue.x, aValue.y};
+        }
+
+        static constexpr vector2<component_type> from(const std::array<component_type, size> &aComponents) {
+            return {aComponents[0], aComponents[1]};
+        }
+    };
+
+    template<typename component_type>
+    struct component_layout<vector3<component_type>> final {
+        static constexpr std::size_t size = 3;
+
+        static constexpr std::array<component_type, size> to(const vector3<component_type> &aValue) {
+            return {aValue.x, aValue.y, aValue.z};
+        }
+
+        static constexpr vector3<component_type> from(const std::array<component_type, size> &aComponents) {
+            return {aComponents[0], aComponents[1], aComponents[2]};
+        }
+    };
+
+    template<typename component_type>
+    struct component_layout<vector4<component_type>> final {
+        static constexpr std::size_t size = 4;
+
+        static constexpr std::array<component_type, size> to(const vector4<component_type> &aValue) {
+            return {aValue.x, aValue.y, aValue.z, aValue.w};
+        }
+
+        static constexpr vector4<component_type> from(const std::array<component_type, size> &aComponents) {
+            return {aComponents[0], aComponents[1], aComponents[2], aComponents[3]};
+        }
+    };
+
+    template<typename component_type>
+    struct component_layout<quaternion<component_type>> final {
+        static constexpr std::size_t size = 4;
+
+        static constexpr std::array<component_type, size> to(const quaternion<component_type> &aValue) {
+            return {aValue.x, aValue.y, aValue.z, aValue.w};
+        }
+
+        static constexpr quaternion<component_type> from(const std::array<component_type, size> &aComponents) {
+            return {aComponents[0], aComponents[1], aComponents[2], aComponents[3]};
+        }
+    };
+
+    //! both matrices, which share get(column, row) and set(column, row, value)
+    template<typename matrix_type>
+    struct matrix_component_layout {
+        using component_type = typename matrix_type::component_type;
+
+        static constexpr std::size_t size = matrix_type::order * matrix_type::order;
+
+        static constexpr std::array<component_type, size> to(const matrix_type &aValue) {
+            std::array<component_type, size> out = {};
+
+            for (std::size_t column = 0; column < matrix_type::order; ++column)
+                for (std::size_t row = 0; row < matrix_type::order; ++row)
+                    out[column * matrix_type::order + row] = aValue.get(column, row);
+
+            return out;
+        }
+
+        static constexpr matrix_type from(const std::array<component_type, size> &aComponents) {
+            matrix_type out;
+
+            for (std::size_t column = 0; column < matrix_type::order; ++column)
+                for (std::size_t row = 0; row < matrix_type::order; ++row)
+                    out.set(column, row, aComponents[column * matrix_type::order + row]);
+
+            return out;
+        }
+    };
+
+    template<typename component_type>
+    struct component_layout<matrix3x3<component_type>> final
+    : matrix_component_layout<matrix3x3<component_type>> {};
+
+    template<typename component_type>
+    struct component_layout<matrix4x4<component_type>> final
+    : matrix_component_layout<matrix4x4<component_type>> {};
+
+    //! aValue's components, in the order of component_layout
+    template<typename value_type>
+    [[nodiscard]] constexpr std::array<typename value_type::component_type, component_layout<value_type>::size>
+    to_components(const value_type &aValue) {
+        return component_layout<value_type>::to(aValue);
+    }
+
+    //! the value_type with aComponents, in the order of component_layout
+    template<typename value_type>
+    [[nodiscard]] constexpr value_type from_components(
+        const std::array<typename value_type::component_type, component_layout<value_type>::size> &aComponents) {
+        return component_layout<value_type>::from(aComponents);
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
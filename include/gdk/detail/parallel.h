@@ -0,0 +1,72 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_DETAIL_PARALLEL_H
+#define GDK_MATH_DETAIL_PARALLEL_H
+
+#include <gdk/backend.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/// \file splits a run of independent work across threads, for the batch kernels that take a thread count
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        //! how many chunks aCount items split into, given a requested thread count and the smallest chunk
+        /// worth a thread. A thread count of zero means one per hardware thread.
+        [[nodiscard]] inline std::size_t chunk_count(const std::size_t aCount, const std::size_t aThreadCount,
+            const std::size_t aMinimumChunk) {
+            const std::size_t threads = aThreadCount
+                ? aThreadCount
+                : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+            return std::max<std::size_t>(1, std::min(threads, aCount / std::max<std::size_t>(1, aMinimumChunk)));
+        }
+
+        //! call aBody(begin, end, chunk) for aChunks contiguous, near-equal pieces of [0, aCount). The first
+        /// runs on the calling thread. If aBody throws, the other chunks still run; once every thread has
+        /// been joined, the exception of the lowest chunk that threw is rethrown. Failing to start a thread
+        /// throws std::system_error, after joining those already started.
+        template<typename body_type>
+        void parallel_chunks(const std::size_t aCount, const std::size_t aChunks, body_type &&aBody) {
+            const auto bounds = [&](const std::size_t aChunk) { return aCount * aChunk / aChunks; };
+
+            // one per chunk, so that no two threads write the same one
+            std::vector<std::exception_ptr> errors(aChunks);
+
+            // an exception escaping a thread would terminate the program
+            const auto run = [&](const std::size_t aChunk) {
+                try {
+                    aBody(bounds(aChunk), bounds(aChunk + 1), aChunk);
+                }
+                catch (...) {
+                    errors[aChunk] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(aChunks - 1);
+
+            // as would destroying a thread that has not been joined, should starting another throw
+            struct joiner final {
+                std::vector<std::thread> &threads;
+
+                ~joiner() {
+                    for (auto &thread : threads) if (thread.joinable()) thread.join();
+                }
+            } const join{workers};
+
+            for (std::size_t chunk = 1; chunk < aChunks; ++chunk) workers.emplace_back(run, chunk);
+
+            run(0);
+
+            for (auto &worker : workers) worker.join();
+
+            for (const auto &error : errors) if (error) std::rethrow_exception(error);
+        }
+    }
+GDK_MATH_END_NAMESPACE
+
+#endif
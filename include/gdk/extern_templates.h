@@ -0,0 +1,34 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_EXTERN_TEMPLATES_H
+#define GDK_MATH_EXTERN_TEMPLATES_H
+
+/// \file the opt-in that lets a translation unit skip instantiating the types for float and double.
+///
+/// Every type is a template, so every translation unit that uses one instantiates the members it uses.
+/// Defining GDK_MATH_EXTERN_TEMPLATES declares the float and double instantiations of each class
+/// template extern: a translation unit then compiles only the members it may inline, and links the rest
+/// from the gdkmath_templates library (src/templates.cpp), which defines them once. Turn on the
+/// GDK_MATH_EXTERN_TEMPLATES CMake option and link gdkmath_templates, which defines the macro for
+/// whatever links it.
+///
+/// constexpr members are implicitly inline, so they are still instantiated where they are used, as are
+/// free functions and component types other than float and double. That leaves little to skip: most of
+/// the library is constexpr members and free function templates, and most of what a translation unit
+/// spends on it is parsing gdk/math.h, which this does not change.
+///
+/// The option gives no measurable saving. bench/compile_time's typical translation unit compiles in
+/// about the same time either way (about 1019 ms instantiating everything, 1021 ms with the macro),
+/// where including gdk/math.h alone takes most of that. It is kept for builds that want each
+/// instantiation compiled once, not as a way to compile faster; to compile faster, include the headers
+/// a file uses rather than gdk/math.h.
+
+#if defined(GDK_MATH_EXTERN_TEMPLATES)
+#define GDK_MATH_EXTERN_TEMPLATE(aTemplate) \
+    extern template class aTemplate<float>; \
+    extern template class aTemplate<double>;
+#else
+#define GDK_MATH_EXTERN_TEMPLATE(aTemplate)
+#endif
+
+#endif
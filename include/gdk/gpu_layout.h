@@ -0,0 +1,113 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_GPU_LAYOUT_H
+#define GDK_MATH_GPU_LAYOUT_H
+
+#include <gdk/backend.h>
+#include <gdk/matrix3x3.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector2.h>
+#include <gdk/vector3.h>
+#include <gdk/vector4.h>
+
+#include <cstddef>
+
+/// \file arrays of vectors and matrices laid out as GLSL's std140 and std430 buffer layouts lay them out.
+///
+/// A vector3 is three components with nothing between vectors, but in a uniform or storage buffer a vec3
+/// is aligned as a vec4, so an array of them has a component of padding after each, and a mat3 is three
+/// such columns. An array of vec2 is packed in std430 but each vec2 is padded to 16 bytes in std140.
+/// Otherwise the layouts agree for the types here:
+///
+/// | element   | std140 stride | std430 stride |
+/// |-----------|---------------|---------------|
+/// | vector2   | 16            | 2 components  |
+/// | vector3   | 4 components  | 4 components  |
+/// | vector4   | 4 components  | 4 components  |
+/// | matrix3x3 | 12 components | 12 components |
+/// | matrix4x4 | 16 components | 16 components |
+///
+/// Components are float or double, double being read as GLSL's dvec and dmat types. The padded types below are those
+/// elements, to declare buffer structs with; the pack_buffer functions fill a buffer from arrays or
+/// strided spans of the unpadded types, padding zeroed.
+///
+/// Where SSE2 is available and the destination is 16 byte aligned, pack_buffer writes with streaming
+/// stores, which go to memory without first reading the destination into cache, and without evicting
+/// what is there: the right thing for a mapped upload buffer written once per frame and not read back.
+/// The stores are fenced before it returns.
+GDK_MATH_BEGIN_NAMESPACE
+    //! GLSL's two buffer layouts: std140 for uniform blocks, std430 for shader storage blocks
+    enum class buffer_layout {
+        std140,
+        std430
+    };
+
+    /// \brief a vec3 as an array element in either layout: padded to the size of a vec4
+    template<typename component_type>
+    struct alignas(4 * sizeof(component_type)) padded_vector3 final {
+        component_type x, y, z, padding;
+    };
+
+    /// \brief a mat3 in either layout: three columns, each a padded vec3
+    template<typename component_type>
+    struct alignas(4 * sizeof(component_type)) padded_matrix3x3 final {
+        padded_vector3<component_type> columns[3];
+    };
+
+    /// \brief a vec2 as an array element in std140: its alignment pads it to 16 bytes
+    template<typename component_type>
+    struct alignas(16) std140_vector2 final {
+        component_type x, y;
+    };
+
+    //! bytes from one element of an array of value_type to the next, in aLayout
+    template<typename value_type>
+    [[nodiscard]] constexpr std::size_t array_stride(const buffer_layout aLayout);
+
+    //! write aCount values to aDestination as an array in aLayout: aCount * array_stride bytes
+    template<typename component_type>
+    void pack_buffer(const vector2<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout aLayout, void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const vector3<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout aLayout, void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const vector4<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout aLayout, void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const matrix3x3<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout aLayout, void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const matrix4x4<component_type> *const aValues, const std::size_t aCount,
+        const buffer_layout aLayout, void *const aDestination);
+
+    //! write the values of a view, such as the positions of a vertex buffer, as an array in aLayout
+    template<typename component_type>
+    void pack_buffer(const strided_span<const vector2<component_type>> aValues, const buffer_layout aLayout,
+        void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const vector3<component_type>> aValues, const buffer_layout aLayout,
+        void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const vector4<component_type>> aValues, const buffer_layout aLayout,
+        void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const matrix3x3<component_type>> aValues, const buffer_layout aLayout,
+        void *const aDestination);
+
+    template<typename component_type>
+    void pack_buffer(const strided_span<const matrix4x4<component_type>> aValues, const buffer_layout aLayout,
+        void *const aDestination);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/gpu_layout.inl> // varies by implementation
+
+#endif
@@ -0,0 +1,151 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_HALF_H
+#define GDK_MATH_HALF_H
+
+#include <gdk/backend.h>
+#include <gdk/quaternion.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector2.h>
+#include <gdk/vector3.h>
+#include <gdk/vector4.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// \file IEEE 754 binary16 storage, for positions, texture coordinates and animation data kept at half
+/// the size of float and widened to float for arithmetic.
+///
+/// A half has 11 significant bits, so about 3 decimal digits, and a range of +-65504; the smallest
+/// normal is 2^-14 and the smallest subnormal 2^-24. Converting to half rounds to nearest, ties to even;
+/// values beyond the range become infinity, and NaN stays NaN. Converting from half is exact. double and
+/// long double are rounded to float first, which can round a value lying within a float's precision of
+/// a tie between two halves the other way.
+///
+/// The types here are storage only: to_half narrows a vector or quaternion into one and from_half
+/// widens it back for computing. Where the compiler targets F16C (-mf16c, a -march that has it, or
+/// MSVC's /arch:AVX2) conversions use its instructions, eight at a time in the batch forms; elsewhere
+/// they use bit operations that give the same results, NaN payloads included: both keep a NaN's
+/// payload and set its quiet bit, in either direction. Outputs must not overlap inputs.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief a binary16 value: sign, 5 exponent bits and 10 mantissa bits. Compared by its bits, so
+    /// +0 and -0 differ, and a NaN equals itself.
+    struct half final {
+        std::uint16_t bits;
+
+        [[nodiscard]] constexpr bool operator==(const half &aOther) const {
+            return bits == aOther.bits;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const half &aOther) const {
+            return !(*this == aOther);
+        }
+    };
+
+    /// \brief a vector2 stored in half precision
+    struct half_vector2 final {
+        half x, y;
+    };
+
+    /// \brief a vector3 stored in half precision
+    struct half_vector3 final {
+        half x, y, z;
+    };
+
+    /// \brief a vector4 stored in half precision
+    struct half_vector4 final {
+        half x, y, z, w;
+    };
+
+    /// \brief a quaternion stored in half precision
+    struct half_quaternion final {
+        half x, y, z, w;
+    };
+
+    //! aValue rounded to the nearest half
+    [[nodiscard]] inline half to_half(const float aValue);
+
+    //! the float equal to aValue
+    [[nodiscard]] inline float from_half(const half aValue);
+
+    template<typename component_type>
+    [[nodiscard]] half_vector2 to_half(const vector2<component_type> &aVector);
+
+    template<typename component_type>
+    [[nodiscard]] half_vector3 to_half(const vector3<component_type> &aVector);
+
+    template<typename component_type>
+    [[nodiscard]] half_vector4 to_half(const vector4<component_type> &aVector);
+
+    template<typename component_type>
+    [[nodiscard]] half_quaternion to_half(const quaternion<component_type> &aRotation);
+
+    //! aVector widened for computing. component_type is float unless given: from_half<double>(v).
+    template<typename component_type = float>
+    [[nodiscard]] vector2<component_type> from_half(const half_vector2 &aVector);
+
+    template<typename component_type = float>
+    [[nodiscard]] vector3<component_type> from_half(const half_vector3 &aVector);
+
+    template<typename component_type = float>
+    [[nodiscard]] vector4<component_type> from_half(const half_vector4 &aVector);
+
+    template<typename component_type = float>
+    [[nodiscard]] quaternion<component_type> from_half(const half_quaternion &aRotation);
+
+    //! to_half each of aCount floats
+    inline void to_half(const float *const aValues, const std::size_t aCount, half *const aOut);
+
+    //! from_half each of aCount halves
+    inline void from_half(const half *const aValues, const std::size_t aCount, float *const aOut);
+
+    //! to_half each of aCount vectors
+    inline void to_half(const vector2<float> *const aVectors, const std::size_t aCount, half_vector2 *const aOut);
+
+    inline void to_half(const vector3<float> *const aVectors, const std::size_t aCount, half_vector3 *const aOut);
+
+    inline void to_half(const vector4<float> *const aVectors, const std::size_t aCount, half_vector4 *const aOut);
+
+    inline void to_half(const quaternion<float> *const aRotations, const std::size_t aCount,
+        half_quaternion *const aOut);
+
+    //! from_half each of aCount vectors
+    inline void from_half(const half_vector2 *const aVectors, const std::size_t aCount, vector2<float> *const aOut);
+
+    inline void from_half(const half_vector3 *const aVectors, const std::size_t aCount, vector3<float> *const aOut);
+
+    inline void from_half(const half_vector4 *const aVectors, const std::size_t aCount, vector4<float> *const aOut);
+
+    inline void from_half(const half_quaternion *const aRotations, const std::size_t aCount,
+        quaternion<float> *const aOut);
+
+    //! to_half each value of a view, such as the positions of a vertex buffer, into another view. aOut
+    /// holds at least as many as the input; otherwise throws std::invalid_argument.
+    inline void to_half(const strided_span<const float> aValues, const strided_span<half> aOut);
+
+    inline void to_half(const strided_span<const vector2<float>> aVectors, const strided_span<half_vector2> aOut);
+
+    inline void to_half(const strided_span<const vector3<float>> aVectors, const strided_span<half_vector3> aOut);
+
+    inline void to_half(const strided_span<const vector4<float>> aVectors, const strided_span<half_vector4> aOut);
+
+    inline void to_half(const strided_span<const quaternion<float>> aRotations,
+        const strided_span<half_quaternion> aOut);
+
+    //! from_half each value of a view into another view. aOut holds at least as many as the input;
+    /// otherwise throws std::invalid_argument.
+    inline void from_half(const strided_span<const half> aValues, const strided_span<float> aOut);
+
+    inline void from_half(const strided_span<const half_vector2> aVectors, const strided_span<vector2<float>> aOut);
+
+    inline void from_half(const strided_span<const half_vector3> aVectors, const strided_span<vector3<float>> aOut);
+
+    inline void from_half(const strided_span<const half_vector4> aVectors, const strided_span<vector4<float>> aOut);
+
+    inline void from_half(const strided_span<const half_quaternion> aRotations,
+        const strided_span<quaternion<float>> aOut);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/half.inl> // varies by implementation
+
+#endif
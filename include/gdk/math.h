@@ -6,11 +6,27 @@
 /// \file includes headers for all types and every operation between them.
 ///
 /// Include this rather than individual type headers unless you have a reason not to. 
+#include <gdk/aabb.h>
+#include <gdk/animation_compression.h>
+#include <gdk/animation_sampler.h>
+#include <gdk/charconv.h>
+#include <gdk/closest_point.h>
+#include <gdk/components.h>
+#include <gdk/gpu_layout.h>
+#include <gdk/half.h>
 #include <gdk/math_constants.h>
 #include <gdk/math_ops.h>
 #include <gdk/matrix3x3.h>
 #include <gdk/matrix4x4.h>
+#include <gdk/obb.h>
+#include <gdk/octahedral.h>
+#include <gdk/quantized_quaternion.h>
 #include <gdk/quaternion.h>
+#include <gdk/spatial_hash_grid.h>
+#include <gdk/sphere.h>
+#include <gdk/strided_span.h>
+#include <gdk/sweep_and_prune.h>
+#include <gdk/transform_delta.h>
 #include <gdk/vector2.h>
 #include <gdk/vector3.h>
 #include <gdk/vector4.h>
@@ -3,6 +3,7 @@
 #ifndef GDK_MATH_MATH_OPS_H
 #define GDK_MATH_MATH_OPS_H
 
+#include <gdk/backend.h>
 #include <gdk/matrix3x3.h>
 #include <gdk/matrix4x4.h>
 #include <gdk/quaternion.h>
@@ -10,7 +11,7 @@
 #include <gdk/vector4.h>
 
 /// \file Every operation that combines two *different* math types
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     //! apply a transform to a 4d vector, as `M * v` 
     template<typename component_type>
     [[nodiscard]] constexpr vector4<component_type> operator*(const matrix4x4<component_type> &aMatrix,
@@ -76,6 +77,6 @@ namespace gdk {
 
         return aVector + t * aRotation.w + axis.cross_product(t);
     }
-}
+GDK_MATH_END_NAMESPACE
 
 #endif
@@ -3,6 +3,8 @@
 #ifndef GDK_MATH_MAT3X3_H
 #define GDK_MATH_MAT3X3_H
 
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
 #include <gdk/storage.inl> // varies by implementation 
 
 #include <array>
@@ -11,7 +13,7 @@
 #include <type_traits>
 #include <utility>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     /// \brief 3 by 3 matrix: the linear part of a transform, without translation
     /// - **column-major**: data layout is column first
     /// - **Storage order is part of the interface, it does not vary with implementations.**
@@ -91,8 +93,12 @@ namespace gdk {
         matrix3x3(matrix3x3<component_type> &&) = default;
         ~matrix3x3() = default;
     };
-}
+GDK_MATH_END_NAMESPACE
 
 #include <gdk/matrix3x3.inl> // varies by implementation 
 
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(matrix3x3)
+GDK_MATH_END_NAMESPACE
+
 #endif
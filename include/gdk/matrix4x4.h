@@ -3,6 +3,8 @@
 #ifndef GDK_MATH_MAT4X4_H
 #define GDK_MATH_MAT4X4_H
 
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
 #include <gdk/storage.inl> // varies by implementation 
 
 #include <gdk/quaternion.h>
@@ -18,7 +20,7 @@
 #include <iosfwd>
 #include <type_traits>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     /// \brief 4 by 4 matrix used to calculate 3D transformations and camera projections.
     /// - **right-handed**: +X right, +Y up, +Z back
     /// - **column-major**: data layout is column first 
@@ -140,8 +142,12 @@ namespace gdk {
         matrix4x4(matrix4x4<component_type>&&) = default;
         ~matrix4x4() = default;
     };
-}
+GDK_MATH_END_NAMESPACE
 
 #include <gdk/matrix4x4.inl> // varies by implementation 
 
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(matrix4x4)
+GDK_MATH_END_NAMESPACE
+
 #endif
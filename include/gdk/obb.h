@@ -0,0 +1,84 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_OBB_H
+#define GDK_MATH_OBB_H
+
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
+#include <gdk/aabb.h>
+#include <gdk/math_ops.h>
+#include <gdk/matrix3x3.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief oriented bounding box: a box free to rotate
+    /// - **orientation** is a rotation whose columns are the box's local x, y and z axes in world space
+    /// - **inclusive**: points on the surface are inside, and touching boxes overlap
+    template<typename component_type_param = float>
+    class obb final {
+    public:
+        static_assert(std::is_floating_point<component_type_param>::value,
+            "component_type must be a floating point type");
+
+        using component_type = component_type_param;
+        using vector3_type = vector3<component_type_param>;
+        using matrix3x3_type = matrix3x3<component_type_param>;
+
+        vector3_type center;
+        vector3_type half_extents;
+        matrix3x3_type orientation;
+
+        //! the world space box of a local box under a transform. Scale moves into the half extents,
+        /// so the transform must be a translation, rotation and scale without shear.
+        [[nodiscard]] static obb<component_type> from_transform(const matrix4x4<component_type> &aTransform,
+            const aabb<component_type> &aLocalBounds);
+
+        //! one of the box's unit axes in world space: 0, 1 or 2 for local x, y or z
+        [[nodiscard]] constexpr vector3_type axis(const std::size_t aIndex) const;
+
+        [[nodiscard]] constexpr bool contains(const vector3_type &aPoint) const;
+
+        //! separating axis test over the 15 candidate axes, stopping at the first that separates
+        [[nodiscard]] constexpr bool overlaps(const obb<component_type> &aOther) const;
+
+        //! the smallest axis-aligned box around this one
+        [[nodiscard]] constexpr aabb<component_type> bounds() const;
+
+        constexpr obb(const vector3_type &aCenter, const vector3_type &aHalfExtents,
+            const matrix3x3_type &aOrientation = matrix3x3_type());
+
+        obb<component_type> &operator=(const obb<component_type> &) = default;
+
+        //! a zero size box at the origin, axis-aligned
+        obb() = default;
+        obb(const obb<component_type> &) = default;
+        obb(obb<component_type> &&) = default;
+        ~obb() = default;
+    };
+
+    //! test aBox against each of aCount boxes, writing whether each overlaps into aResults.
+    /// Returns the number that overlap. aBox's basis is set up once rather than once per pair.
+    template<typename component_type>
+    std::size_t overlaps(const obb<component_type> &aBox, const obb<component_type> *const aOthers,
+        const std::size_t aCount, bool *const aResults);
+
+    //! test aBox against each box of a view, such as the bounds of an entity array, writing whether each
+    /// overlaps into aResults, which holds at least as many; otherwise throws std::invalid_argument
+    template<typename component_type>
+    std::size_t overlaps(const obb<component_type> &aBox, const strided_span<const obb<component_type>> aOthers,
+        const strided_span<bool> aResults);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/obb.inl> // varies by implementation
+
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(obb)
+GDK_MATH_END_NAMESPACE
+
+#endif
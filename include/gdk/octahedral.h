@@ -0,0 +1,143 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_OCTAHEDRAL_H
+#define GDK_MATH_OCTAHEDRAL_H
+
+#include <gdk/backend.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// \file unit vectors, such as normals and tangents, packed into 16, 24 or 32 bits by octahedral mapping.
+///
+/// A direction is projected onto the octahedron |x| + |y| + |z| = 1, whose lower half is folded over the
+/// upper, flattening it to a square on [-1, 1]. Its two coordinates are stored as signed normalized
+/// integers, which represent -1, 0 and 1 exactly, so the six axes round trip without error. The errors
+/// below are the worst over 2M random directions.
+///
+/// | format       | bits per coordinate | max angle error |
+/// |--------------|---------------------|-----------------|
+/// | octahedral16 | 8                   | 1 degree        |
+/// | octahedral24 | 12                  | 0.06 degrees    |
+/// | octahedral32 | 16                  | 0.004 degrees   |
+///
+/// Encoding needs no unit input: any vector but zero encodes its direction, which is then decoded unit
+/// length. The batch forms are straight-line loops over contiguous arrays that the optimizer can
+/// vectorize: encode16 and encode32 always, and decode under -fno-math-errno, as otherwise the square
+/// root's errno path is a branch. Outputs must not overlap inputs.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief a direction in 16 bits: the first coordinate in the high byte, the second in the low
+    struct octahedral16 final {
+        std::uint16_t bits;
+
+        [[nodiscard]] constexpr bool operator==(const octahedral16 &aOther) const {
+            return bits == aOther.bits;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const octahedral16 &aOther) const {
+            return !(*this == aOther);
+        }
+    };
+
+    /// \brief a direction in 24 bits: the two coordinates at 12 bits each, in three bytes, most
+    /// significant first, so an array of them is 3 bytes per direction
+    struct octahedral24 final {
+        std::uint8_t bytes[3];
+
+        [[nodiscard]] constexpr bool operator==(const octahedral24 &aOther) const {
+            return bytes[0] == aOther.bytes[0] && bytes[1] == aOther.bytes[1] && bytes[2] == aOther.bytes[2];
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const octahedral24 &aOther) const {
+            return !(*this == aOther);
+        }
+    };
+
+    /// \brief a direction in 32 bits: the first coordinate in the high 16 bits, the second in the low
+    struct octahedral32 final {
+        std::uint32_t bits;
+
+        [[nodiscard]] constexpr bool operator==(const octahedral32 &aOther) const {
+            return bits == aOther.bits;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const octahedral32 &aOther) const {
+            return !(*this == aOther);
+        }
+    };
+
+    //! the direction of aVector, which must not be zero, in 16 bits
+    template<typename component_type>
+    [[nodiscard]] octahedral16 encode16(const vector3<component_type> &aVector);
+
+    //! the direction of aVector, which must not be zero, in 24 bits
+    template<typename component_type>
+    [[nodiscard]] octahedral24 encode24(const vector3<component_type> &aVector);
+
+    //! the direction of aVector, which must not be zero, in 32 bits
+    template<typename component_type>
+    [[nodiscard]] octahedral32 encode32(const vector3<component_type> &aVector);
+
+    //! the unit vector aEncoded holds. component_type is float unless given: decode<double>(e).
+    template<typename component_type = float>
+    [[nodiscard]] vector3<component_type> decode(const octahedral16 &aEncoded);
+
+    template<typename component_type = float>
+    [[nodiscard]] vector3<component_type> decode(const octahedral24 &aEncoded);
+
+    template<typename component_type = float>
+    [[nodiscard]] vector3<component_type> decode(const octahedral32 &aEncoded);
+
+    //! encode16 each of aCount vectors
+    template<typename component_type>
+    void encode16(const vector3<component_type> *const aVectors, const std::size_t aCount,
+        octahedral16 *const aOut);
+
+    //! encode24 each of aCount vectors
+    template<typename component_type>
+    void encode24(const vector3<component_type> *const aVectors, const std::size_t aCount,
+        octahedral24 *const aOut);
+
+    //! encode32 each of aCount vectors
+    template<typename component_type>
+    void encode32(const vector3<component_type> *const aVectors, const std::size_t aCount,
+        octahedral32 *const aOut);
+
+    //! decode each of aCount encoded directions
+    template<typename component_type>
+    void decode(const octahedral16 *const aEncoded, const std::size_t aCount, vector3<component_type> *const aOut);
+
+    template<typename component_type>
+    void decode(const octahedral24 *const aEncoded, const std::size_t aCount, vector3<component_type> *const aOut);
+
+    template<typename component_type>
+    void decode(const octahedral32 *const aEncoded, const std::size_t aCount, vector3<component_type> *const aOut);
+
+    //! encode16 each vector of a view, such as the normals of a vertex buffer, into another view. aOut
+    /// holds at least as many as aVectors; otherwise throws std::invalid_argument.
+    template<typename component_type>
+    void encode16(const strided_span<const vector3<component_type>> aVectors, const strided_span<octahedral16> aOut);
+
+    template<typename component_type>
+    void encode24(const strided_span<const vector3<component_type>> aVectors, const strided_span<octahedral24> aOut);
+
+    template<typename component_type>
+    void encode32(const strided_span<const vector3<component_type>> aVectors, const strided_span<octahedral32> aOut);
+
+    //! decode each direction of a view into another view. aOut holds at least as many as aEncoded;
+    /// otherwise throws std::invalid_argument.
+    template<typename component_type>
+    void decode(const strided_span<const octahedral16> aEncoded, const strided_span<vector3<component_type>> aOut);
+
+    template<typename component_type>
+    void decode(const strided_span<const octahedral24> aEncoded, const strided_span<vector3<component_type>> aOut);
+
+    template<typename component_type>
+    void decode(const strided_span<const octahedral32> aEncoded, const strided_span<vector3<component_type>> aOut);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/octahedral.inl> // varies by implementation
+
+#endif
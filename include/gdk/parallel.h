@@ -0,0 +1,63 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_PARALLEL_H
+#define GDK_MATH_PARALLEL_H
+
+#include <gdk/animation_compression.h>
+#include <gdk/backend.h>
+#include <gdk/quaternion.h>
+#include <gdk/sphere.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+
+/// \file the batch kernels that split their work across threads: bounding spheres over many points, and
+/// compression of many animation tracks. Each gives what its single threaded form in gdk/sphere.h or
+/// gdk/animation_compression.h does, given the same input.
+///
+/// A thread count of zero means one per hardware thread. The threads are started for each call and
+/// joined before it returns; an exception thrown on one is rethrown on the calling thread.
+///
+/// Threads take <thread>, which would otherwise reach every translation unit including gdk/math.h, so
+/// this header is not part of gdk/math.h. Include it where the threads pay, and link the platform's
+/// thread library.
+GDK_MATH_BEGIN_NAMESPACE
+    //! bounding_sphere_ritter, with both passes split across aThreadCount threads. Each thread grows its
+    /// own copy of the starting sphere and the copies are merged, so the sphere can be slightly larger
+    /// than the single threaded one.
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_ritter(const vector3<component_type> *const aPoints,
+        const std::size_t aCount, const std::size_t aThreadCount);
+
+    //! bounding_sphere_epos, split across aThreadCount threads as bounding_sphere_ritter is
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_epos(const vector3<component_type> *const aPoints,
+        const std::size_t aCount, const std::size_t aThreadCount);
+
+    //! bounding_sphere_ritter over the points of a view, split across aThreadCount threads
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_ritter(
+        const strided_span<const vector3<component_type>> aPoints, const std::size_t aThreadCount);
+
+    //! bounding_sphere_epos over the points of a view, split across aThreadCount threads
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_epos(
+        const strided_span<const vector3<component_type>> aPoints, const std::size_t aThreadCount);
+
+    //! compress each of aTrackCount tracks of aFrameCount samples, aTracks[i] to aOut[i], with the tracks
+    /// split across aThreadCount threads. Each track is what compressing it alone gives.
+    template<typename component_type>
+    void compress(const vector3<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_vector3_track<component_type> *const aOut, const std::size_t aThreadCount);
+
+    template<typename component_type>
+    void compress(const quaternion<component_type> *const *const aTracks, const std::size_t aTrackCount,
+        const std::size_t aFrameCount, const component_type aTolerance,
+        compressed_quaternion_track<component_type> *const aOut, const std::size_t aThreadCount);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/parallel.inl> // varies by implementation
+
+#endif
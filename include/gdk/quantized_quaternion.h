@@ -0,0 +1,157 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_QUANTIZED_QUATERNION_H
+#define GDK_MATH_QUANTIZED_QUATERNION_H
+
+#include <gdk/backend.h>
+#include <gdk/quaternion.h>
+#include <gdk/strided_span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+/// \file unit quaternions packed into 32 or 48 bits by the smallest three method.
+///
+/// q and -q are the same rotation, so the largest component can always be made positive, and a unit
+/// quaternion's largest component follows from the other three: sqrt(1 - a^2 - b^2 - c^2). The other
+/// three each lie in [-1/sqrt(2), 1/sqrt(2)]. A packed quaternion keeps the index of the largest, in
+/// the order x, y, z, w, and the other three quantized evenly across that range. The errors below are
+/// the worst over 2M random rotations; the largest component, being rebuilt, carries the most.
+///
+/// | format              | bits per component | max component error | max angle error |
+/// |---------------------|--------------------|---------------------|-----------------|
+/// | packed_quaternion32 | 10                 | 2e-3                | 0.25 degrees    |
+/// | packed_quaternion48 | 15                 | 6e-5                | 0.008 degrees   |
+///
+/// Inputs are assumed unit length; normalize first where they may have drifted. Unpacking always gives
+/// the rotation with a non-negative largest component, which may be the negation of what was packed.
+///
+/// The batch forms are straight-line loops over contiguous arrays that the optimizer can vectorize.
+/// The batch interpolations unpack both ends into registers only, so keys stored packed are blended
+/// without first writing out a quaternion array. Outputs must not overlap inputs.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief a unit quaternion in 32 bits: the largest component's index in the top 2 bits, then the
+    /// other three, in order, at 10 bits each
+    struct packed_quaternion32 final {
+        std::uint32_t bits;
+
+        [[nodiscard]] constexpr bool operator==(const packed_quaternion32 &aOther) const {
+            return bits == aOther.bits;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const packed_quaternion32 &aOther) const {
+            return !(*this == aOther);
+        }
+    };
+
+    /// \brief a unit quaternion in 48 bits: the largest component's index in the top 2 bits, then the
+    /// other three, in order, at 15 bits each, and one bit unused. Three 16-bit words, most significant
+    /// first, so an array of them is 6 bytes per quaternion.
+    struct packed_quaternion48 final {
+        std::uint16_t words[3];
+
+        [[nodiscard]] constexpr bool operator==(const packed_quaternion48 &aOther) const {
+            return words[0] == aOther.words[0] && words[1] == aOther.words[1] && words[2] == aOther.words[2];
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const packed_quaternion48 &aOther) const {
+            return !(*this == aOther);
+        }
+    };
+
+    //! aRotation, which must be unit length, in 32 bits
+    template<typename component_type>
+    [[nodiscard]] packed_quaternion32 pack32(const quaternion<component_type> &aRotation);
+
+    //! aRotation, which must be unit length, in 48 bits
+    template<typename component_type>
+    [[nodiscard]] packed_quaternion48 pack48(const quaternion<component_type> &aRotation);
+
+    //! the rotation aPacked holds. component_type is float unless given: unpack<double>(p).
+    template<typename component_type = float>
+    [[nodiscard]] quaternion<component_type> unpack(const packed_quaternion32 &aPacked);
+
+    template<typename component_type = float>
+    [[nodiscard]] quaternion<component_type> unpack(const packed_quaternion48 &aPacked);
+
+    //! pack32 each of aCount rotations
+    template<typename component_type>
+    void pack32(const quaternion<component_type> *const aRotations, const std::size_t aCount,
+        packed_quaternion32 *const aOut);
+
+    //! pack48 each of aCount rotations
+    template<typename component_type>
+    void pack48(const quaternion<component_type> *const aRotations, const std::size_t aCount,
+        packed_quaternion48 *const aOut);
+
+    //! unpack each of aCount packed rotations
+    template<typename component_type>
+    void unpack(const packed_quaternion32 *const aPacked, const std::size_t aCount,
+        quaternion<component_type> *const aOut);
+
+    template<typename component_type>
+    void unpack(const packed_quaternion48 *const aPacked, const std::size_t aCount,
+        quaternion<component_type> *const aOut);
+
+    //! pack32 each rotation of a view, such as the rotations of an instance buffer, into another view. aOut
+    /// holds at least as many as aRotations; otherwise throws std::invalid_argument.
+    template<typename component_type>
+    void pack32(const strided_span<const quaternion<component_type>> aRotations,
+        const strided_span<packed_quaternion32> aOut);
+
+    template<typename component_type>
+    void pack48(const strided_span<const quaternion<component_type>> aRotations,
+        const strided_span<packed_quaternion48> aOut);
+
+    //! unpack each rotation of a view into another view. aOut holds at least as many as aPacked;
+    /// otherwise throws std::invalid_argument.
+    template<typename component_type>
+    void unpack(const strided_span<const packed_quaternion32> aPacked,
+        const strided_span<quaternion<component_type>> aOut);
+
+    template<typename component_type>
+    void unpack(const strided_span<const packed_quaternion48> aPacked,
+        const strided_span<quaternion<component_type>> aOut);
+
+    //! nlerp from aFrom[i] to aTo[i] by aT, for each of aCount pairs of packed rotations
+    template<typename component_type>
+    void nlerp(const packed_quaternion32 *const aFrom, const packed_quaternion32 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut);
+
+    template<typename component_type>
+    void nlerp(const packed_quaternion48 *const aFrom, const packed_quaternion48 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut);
+
+    //! slerp from aFrom[i] to aTo[i] by aT, for each of aCount pairs of packed rotations
+    template<typename component_type>
+    void slerp(const packed_quaternion32 *const aFrom, const packed_quaternion32 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut);
+
+    template<typename component_type>
+    void slerp(const packed_quaternion48 *const aFrom, const packed_quaternion48 *const aTo,
+        const component_type aT, const std::size_t aCount, quaternion<component_type> *const aOut);
+
+    //! nlerp from aFrom[i] to aTo[i] by aT for each element of views, such as the poses of two keyframes
+    /// in a track. aTo and aOut hold at least as many as aFrom; otherwise throws std::invalid_argument.
+    template<typename component_type>
+    void nlerp(const strided_span<const packed_quaternion32> aFrom, const strided_span<const packed_quaternion32> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut);
+
+    template<typename component_type>
+    void nlerp(const strided_span<const packed_quaternion48> aFrom, const strided_span<const packed_quaternion48> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut);
+
+    //! slerp from aFrom[i] to aTo[i] by aT for each element of views, as the nlerp of views
+    template<typename component_type>
+    void slerp(const strided_span<const packed_quaternion32> aFrom, const strided_span<const packed_quaternion32> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut);
+
+    template<typename component_type>
+    void slerp(const strided_span<const packed_quaternion48> aFrom, const strided_span<const packed_quaternion48> aTo,
+        const component_type aT, const strided_span<quaternion<component_type>> aOut);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/quantized_quaternion.inl> // varies by implementation
+
+#endif
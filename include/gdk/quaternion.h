@@ -3,6 +3,8 @@
 #ifndef GDK_MATH_QUATERNION_H
 #define GDK_MATH_QUATERNION_H
 
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
 #include <gdk/storage.inl> // varies by implementation
 
 #include <gdk/math_constants.h>
@@ -14,7 +16,7 @@
 #include <stdexcept>
 #include <type_traits>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     /// \brief Used to represent 3d rotations 
     template<typename component_type_param = float>
     class quaternion final : public quaternion_storage<component_type_param> {
@@ -108,8 +110,12 @@ namespace gdk {
     template <typename component_type>
     [[nodiscard]] constexpr quaternion<component_type> operator*(const quaternion<component_type> &a,
         const quaternion<component_type> &b);
-}
+GDK_MATH_END_NAMESPACE
 
 #include <gdk/quaternion.inl> // varies by implementation
 
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(quaternion)
+GDK_MATH_END_NAMESPACE
+
 #endif
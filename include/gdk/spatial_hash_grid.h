@@ -0,0 +1,127 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_SPATIAL_HASH_GRID_H
+#define GDK_MATH_SPATIAL_HASH_GRID_H
+
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief uniform grid over unbounded space, for neighbour queries among many points or spheres
+    /// - space is cut into cubes of cell_size(). Only occupied cells cost memory: they are the keys of
+    ///   an open-addressing hash table, keyed on the integer cell coordinate
+    /// - build() rebuckets everything with a counting sort, so is linear in the number of items.
+    ///   Rebuild every tick rather than moving items one at a time.
+    /// - items are stored cell by cell, so a query walks contiguous memory
+    template<typename component_type_param = float>
+    class spatial_hash_grid final {
+    public:
+        static_assert(std::is_floating_point<component_type_param>::value,
+            "component_type must be a floating point type");
+
+        using component_type = component_type_param;
+        using vector3_type = vector3<component_type_param>;
+        using cell_type = vector3<std::int32_t>;
+
+        //! position of an item in the array given to build()
+        using index_type = std::uint32_t;
+
+        //! aCellSize should be around the typical query radius. Must be positive.
+        explicit spatial_hash_grid(const component_type aCellSize);
+
+        //! bucket a run of points, replacing the previous contents
+        void build(const vector3_type *const aPoints, const std::size_t aCount);
+
+        //! bucket a run of spheres by their centers, replacing the previous contents
+        void build(const vector3_type *const aCenters, const component_type *const aRadii,
+            const std::size_t aCount);
+
+        //! bucket the points of a view, such as the positions in a vertex buffer
+        void build(const strided_span<const vector3_type> aPoints);
+
+        //! bucket spheres whose centers and radii are views. aRadii holds at least as many as aCenters;
+        /// otherwise throws std::invalid_argument.
+        void build(const strided_span<const vector3_type> aCenters,
+            const strided_span<const component_type> aRadii);
+
+        //! replace the contents of aResults with every item within aRadius of aCenter. For spheres,
+        /// every sphere that touches the query sphere. In no particular order.
+        void query_radius(const vector3_type &aCenter, const component_type aRadius,
+            std::vector<index_type> &aResults) const;
+
+        //! replace the contents of aResults with the aCount items whose positions are nearest aPoint,
+        /// nearest first. Fewer if the grid holds fewer.
+        void query_nearest(const vector3_type &aPoint, const std::size_t aCount,
+            std::vector<index_type> &aResults) const;
+
+        //! the cell containing a point, clamped to 2^30 cells either side of the origin in each axis
+        [[nodiscard]] cell_type cell_of(const vector3_type &aPoint) const;
+
+        //! the number of items in the most recent build
+        [[nodiscard]] std::size_t size() const;
+
+        //! the number of distinct occupied cells in the most recent build
+        [[nodiscard]] std::size_t cell_count() const;
+
+        [[nodiscard]] component_type cell_size() const;
+
+    private:
+        static constexpr std::uint32_t EMPTY = ~std::uint32_t(0);
+
+        //! a table slot: an occupied cell, and the range of m_Items it holds
+        struct slot final {
+            cell_type cell;
+            std::uint32_t begin;
+            std::uint32_t end;
+        };
+
+        struct item final {
+            vector3_type position;
+            component_type radius;
+            index_type index;
+        };
+
+        [[nodiscard]] static std::uint32_t hash(const cell_type &aCell);
+
+        [[nodiscard]] std::size_t find(const cell_type &aCell) const;
+        [[nodiscard]] std::size_t find_or_insert(const cell_type &aCell);
+
+        //! aCenters and aRadii are arrays or strided spans; aRadii is not read unless aHasRadii
+        template<typename centers_type, typename radii_type>
+        void build(const centers_type &aCenters, const radii_type &aRadii, const std::size_t aCount,
+            const bool aHasRadii);
+
+        component_type m_CellSize;
+        component_type m_InverseCellSize;
+
+        //! the largest radius in the grid; zero for points
+        component_type m_MaxRadius = 0;
+
+        //! the bounds of the occupied cells, so queries need not visit beyond them
+        cell_type m_MinCell;
+        cell_type m_MaxCell;
+
+        std::vector<slot> m_Slots;
+        std::vector<item> m_Items;
+        std::size_t m_CellCount = 0;
+
+        //! scratch for build: the slot each input lands in
+        std::vector<std::uint32_t> m_ItemSlot;
+    };
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/spatial_hash_grid.inl> // varies by implementation
+
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(spatial_hash_grid)
+GDK_MATH_END_NAMESPACE
+
+#endif
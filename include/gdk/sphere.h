@@ -0,0 +1,93 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_SPHERE_H
+#define GDK_MATH_SPHERE_H
+
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
+#include <gdk/math_ops.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <type_traits>
+
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief bounding sphere: a center and a radius
+    /// - **inclusive**: points on the surface are inside, and touching spheres overlap
+    template<typename component_type_param = float>
+    class sphere final {
+    public:
+        static_assert(std::is_floating_point<component_type_param>::value,
+            "component_type must be a floating point type");
+
+        using component_type = component_type_param;
+        using vector3_type = vector3<component_type_param>;
+
+        vector3_type center;
+        component_type radius = 0;
+
+        [[nodiscard]] constexpr bool contains(const vector3_type &aPoint) const;
+        [[nodiscard]] bool contains(const sphere<component_type> &aOther) const;
+
+        //! true when the spheres share any point
+        [[nodiscard]] constexpr bool overlaps(const sphere<component_type> &aOther) const;
+
+        //! the smallest sphere enclosing this and another sphere
+        [[nodiscard]] sphere<component_type> merged(const sphere<component_type> &aOther) const;
+
+        //! the smallest sphere enclosing this and a point
+        [[nodiscard]] sphere<component_type> merged(const vector3_type &aPoint) const;
+
+        //! bounds of this sphere after a transform. The center is transformed as a point, and the
+        /// radius grows by the largest of matrix4x4::scale(), so non-uniform scale over-estimates.
+        [[nodiscard]] sphere<component_type> transformed(const matrix4x4<component_type> &aTransform) const;
+
+        [[nodiscard]] constexpr bool operator==(const sphere<component_type> &aOther) const;
+        [[nodiscard]] constexpr bool operator!=(const sphere<component_type> &aOther) const;
+
+        constexpr sphere(const vector3_type &aCenter, const component_type aRadius);
+
+        sphere<component_type> &operator=(const sphere<component_type> &) = default;
+
+        //! a zero radius sphere at the origin
+        sphere() = default;
+        sphere(const sphere<component_type> &) = default;
+        sphere(sphere<component_type> &&) = default;
+        ~sphere() = default;
+    };
+
+    //! Ritter's bounding sphere: a diameter between the most distant of the extreme points on each
+    /// axis, grown over one more pass to take in any point left outside. Typically 5-20% larger than
+    /// the minimal sphere. A zero radius sphere at the origin for a count of zero. gdk/parallel.h splits
+    /// both passes across threads.
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_ritter(const vector3<component_type> *const aPoints,
+        const std::size_t aCount);
+
+    //! as bounding_sphere_ritter, but the starting diameter is chosen among the extreme points along
+    /// seven directions rather than three, after Larsson's EPOS. Usually tighter, for about twice the
+    /// cost of the first pass.
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_epos(const vector3<component_type> *const aPoints,
+        const std::size_t aCount);
+
+    //! bounding_sphere_ritter over the points of a view, such as the positions in a vertex buffer
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_ritter(
+        const strided_span<const vector3<component_type>> aPoints);
+
+    //! bounding_sphere_epos over the points of a view
+    template<typename component_type>
+    [[nodiscard]] sphere<component_type> bounding_sphere_epos(
+        const strided_span<const vector3<component_type>> aPoints);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/sphere.inl> // varies by implementation
+
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(sphere)
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -0,0 +1,139 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_STRIDED_SPAN_H
+#define GDK_MATH_STRIDED_SPAN_H
+
+#include <gdk/backend.h>
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+/// \file a view of values laid out at a fixed byte stride in memory the library does not own.
+///
+/// An interleaved vertex buffer holds a position, a normal, texture coordinates and so on per vertex;
+/// a strided_span<vector3<float>> over its positions reads and writes them in place, where the
+/// positions would otherwise be copied into an array to be worked on and back out again. The same goes
+/// for a matrix per instance in an instance buffer, or values in a mapped file or GPU staging buffer.
+///
+/// The library's batch operations take strided spans alongside their pointer forms, all but the
+/// structure-of-arrays queries of closest_point.h, which want their arrays; where an array
+/// allows a faster loop, spans that are all contiguous take it. A span with a const value_type reads
+/// only; a span of mutable values converts to it, though not while a template argument is being
+/// deduced, so pass a const span to a function template that reads.
+///
+/// The vector, quaternion and matrix types are standard layout with no padding, so one laid over
+/// floats sees the floats. Elements must be aligned for value_type, which for a float buffer means a
+/// stride and offset that are multiples of four.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief count values of value_type, each stride bytes after the one before. A view: the memory
+    /// belongs to the caller.
+    template<typename value_type_param>
+    class strided_span final {
+    public:
+        using value_type = std::remove_cv_t<value_type_param>;
+        using element_type = value_type_param;
+        using byte_type = std::conditional_t<std::is_const<element_type>::value, const unsigned char,
+            unsigned char>;
+        using void_type = std::conditional_t<std::is_const<element_type>::value, const void, void>;
+
+        /// \brief random access over the span's elements
+        class iterator final {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<value_type_param>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = element_type *;
+            using reference = element_type &;
+
+            iterator() = default;
+            iterator(byte_type *const aElement, const std::size_t aStride);
+
+            [[nodiscard]] reference operator*() const;
+            [[nodiscard]] pointer operator->() const;
+            [[nodiscard]] reference operator[](const difference_type aOffset) const;
+
+            iterator &operator++();
+            iterator operator++(int);
+            iterator &operator--();
+            iterator operator--(int);
+            iterator &operator+=(const difference_type aOffset);
+            iterator &operator-=(const difference_type aOffset);
+
+            [[nodiscard]] iterator operator+(const difference_type aOffset) const;
+            [[nodiscard]] iterator operator-(const difference_type aOffset) const;
+            [[nodiscard]] difference_type operator-(const iterator &aOther) const;
+
+            [[nodiscard]] bool operator==(const iterator &aOther) const;
+            [[nodiscard]] bool operator!=(const iterator &aOther) const;
+            [[nodiscard]] bool operator<(const iterator &aOther) const;
+            [[nodiscard]] bool operator>(const iterator &aOther) const;
+            [[nodiscard]] bool operator<=(const iterator &aOther) const;
+            [[nodiscard]] bool operator>=(const iterator &aOther) const;
+
+        private:
+            byte_type *m_Element = nullptr;
+            std::size_t m_Stride = sizeof(value_type);
+        };
+
+        //! an empty span
+        strided_span() = default;
+
+        //! aCount values side by side from aFirst, as in an array
+        strided_span(element_type *const aFirst, const std::size_t aCount);
+
+        //! aCount values, the first at aFirst and each aStride bytes after the one before. For a member
+        /// of an interleaved struct, aFirst is the member's address in the first struct and aStride the
+        /// struct's size.
+        /// \throws std::invalid_argument for a stride smaller than value_type, which would overlap the
+        /// elements, or if aFirst or aStride would leave an element misaligned
+        strided_span(void_type *const aFirst, const std::size_t aCount, const std::size_t aStride);
+
+        //! a span of mutable values as a span of const ones
+        template<typename other_type, typename = std::enable_if_t<
+            std::is_same<const other_type, element_type>::value && !std::is_const<other_type>::value>>
+        strided_span(const strided_span<other_type> &aOther);
+
+        //! the element at aIndex; no bounds check
+        [[nodiscard]] element_type &operator[](const std::size_t aIndex) const;
+
+        [[nodiscard]] iterator begin() const;
+        [[nodiscard]] iterator end() const;
+
+        //! aCount elements starting from aOffset
+        /// \throws std::out_of_range if they run past the end
+        [[nodiscard]] strided_span<element_type> subspan(const std::size_t aOffset, const std::size_t aCount) const;
+
+        //! the first element, or null for an empty span
+        [[nodiscard]] element_type *data() const;
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        //! bytes from one element to the next
+        [[nodiscard]] std::size_t stride() const;
+
+        //! true when the elements sit side by side, so data() can be used as an array of size()
+        [[nodiscard]] bool is_contiguous() const;
+
+    private:
+        byte_type *m_First = nullptr;
+        std::size_t m_Count = 0;
+        std::size_t m_Stride = sizeof(value_type);
+    };
+
+    namespace detail {
+        //! aOut[i] = aConvert(aIn[i]) for each element of aIn, or aBatch(aIn.data(), aIn.size(), aOut.data())
+        /// when both spans are contiguous, so that the array form's faster loop is kept
+        /// \throws std::invalid_argument if aOut is smaller than aIn
+        template<typename in_type, typename out_type, typename batch_type, typename convert_type>
+        void convert_span(const strided_span<in_type> aIn, const strided_span<out_type> aOut,
+            batch_type &&aBatch, convert_type &&aConvert);
+    }
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/strided_span.inl> // varies by implementation
+
+#endif
@@ -0,0 +1,107 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_SWEEP_AND_PRUNE_H
+#define GDK_MATH_SWEEP_AND_PRUNE_H
+
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
+#include <gdk/aabb.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief broadphase collision: finds every pair of bodies whose bounds overlap
+    /// - each body's min and max on one axis are kept as endpoints in a single sorted array
+    /// - update() only rewrites endpoint values. find_pairs() restores the order with an insertion
+    ///   sort, which is close to linear when bodies move a little between calls
+    /// - pick the axis along which bodies are most spread out; see best_axis()
+    template<typename component_type_param = float>
+    class sweep_and_prune final {
+    public:
+        using component_type = component_type_param;
+        using aabb_type = aabb<component_type_param>;
+
+        //! handle to a body. Stays valid until the body is removed, after which it may be reused.
+        using body_type = std::uint32_t;
+
+        //! two overlapping bodies, lower handle first
+        using pair_type = std::pair<body_type, body_type>;
+
+        //! sort along aAxis: 0, 1 or 2 for x, y or z
+        explicit sweep_and_prune(const std::size_t aAxis = 0);
+
+        //! start tracking a body. An empty box, including one whose min exceeds its max on some axis, is
+        /// tracked but overlaps nothing.
+        /// \throws std::invalid_argument if a bound is NaN
+        [[nodiscard]] body_type add(const aabb_type &aBounds);
+
+        //! move a body. Cheap: the endpoints are reordered by the next find_pairs()
+        /// \throws std::invalid_argument if a bound is NaN
+        void update(const body_type aBody, const aabb_type &aBounds);
+
+        //! stop tracking a body. Its handle may be returned by a later add()
+        void remove(const body_type aBody);
+
+        [[nodiscard]] const aabb_type &bounds(const body_type aBody) const;
+
+        //! the number of bodies being tracked
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] std::size_t axis() const;
+
+        //! change the sort axis. A full re-sort, so not something to do every tick.
+        void set_axis(const std::size_t aAxis);
+
+        //! the axis along which the tracked bodies' centers vary the most
+        [[nodiscard]] std::size_t best_axis() const;
+
+        //! sort the endpoints, then replace the contents of aPairs with every overlapping pair
+        void find_pairs(std::vector<pair_type> &aPairs);
+
+    private:
+        static constexpr std::uint32_t DEAD = ~std::uint32_t(0);
+
+        //! an endpoint's body is tagged in the upper bits, and whether it is a max in bit 0
+        struct endpoint final {
+            component_type value;
+            std::uint32_t tag;
+        };
+
+        [[nodiscard]] static constexpr bool comes_before(const endpoint &a, const endpoint &b);
+
+        void check(const body_type aBody) const;
+        static void check(const aabb_type &aBounds);
+        void full_sort();
+        void insertion_sort();
+
+        std::size_t m_Axis;
+
+        std::vector<endpoint> m_Endpoints;
+        std::vector<aabb_type> m_Bounds;
+
+        //! per body: the index of its min endpoint then its max endpoint, or DEAD
+        std::vector<std::uint32_t> m_EndpointIndex;
+
+        std::vector<body_type> m_FreeBodies;
+
+        //! endpoints added and bodies removed since the last sort
+        std::size_t m_Appended = 0;
+        std::size_t m_Removed = 0;
+
+        //! scratch for the sweep: the open bodies, and each body's place in that list
+        std::vector<body_type> m_Active;
+        std::vector<std::uint32_t> m_ActiveIndex;
+    };
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/sweep_and_prune.inl> // varies by implementation
+
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(sweep_and_prune)
+GDK_MATH_END_NAMESPACE
+
+#endif
@@ -0,0 +1,115 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_TRANSFORM_DELTA_H
+#define GDK_MATH_TRANSFORM_DELTA_H
+
+#include <gdk/backend.h>
+#include <gdk/quantized_quaternion.h>
+#include <gdk/quaternion.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \file the positions and rotations of many entities, quantized each tick and sent as the difference
+/// from a snapshot the receiver already has.
+///
+/// A snapshot is the quantized state of every entity. Positions are rounded to a grid of a given
+/// spacing, so each is within half a spacing of its source in each axis. Rotations are reduced to their
+/// smallest three, as packed_quaternion48 does, at a given number of bits each: 15 matches
+/// packed_quaternion48, and each bit fewer doubles the error.
+///
+/// Sender and receiver both keep the last snapshot the receiver acknowledged: the baseline. The sender
+/// encodes the new snapshot as the change from it, and the receiver decodes with the same baseline to
+/// recover the new snapshot exactly. Quantizing first is what makes that exact: both ends hold the same
+/// integers, so there is no drift however long a baseline chain runs. An empty baseline sends the whole
+/// snapshot, to start a stream or after the set of entities changes.
+///
+/// The encoding is a bit stream. Each entity costs one bit if it is unchanged from the baseline, and
+/// otherwise flags which of its position and rotation changed and writes the changed components as
+/// signed differences in an exponential-Golomb code: small changes in few bits, large ones in more.
+/// Entities are coded in blocks of 64, and each block picks the code parameter that suits the size of
+/// its changes. A rotation whose largest component moved to another axis is sent whole.
+///
+/// Differences are taken a block at a time in branch free loops over the flat snapshot arrays, which
+/// vectorize; only the bit packing runs an entity at a time. Encoding allocates nothing beyond the
+/// growth of its output, and the functions share no state, so one snapshot can be encoded against the
+/// baselines of many receivers on as many threads.
+GDK_MATH_BEGIN_NAMESPACE
+    /// \brief how finely a snapshot holds positions and rotations
+    template<typename component_type>
+    struct transform_precision final {
+        //! the spacing of the grid positions are rounded to, in world units
+        component_type position = static_cast<component_type>(0.001);
+
+        //! bits per quantized rotation component, from 2 to 15
+        std::uint32_t rotation_bits = 12;
+    };
+
+    /// \brief the quantized positions and rotations of a set of entities, in flat arrays
+    struct transform_snapshot final {
+        //! the rotation_bits of the precision the snapshot was quantized with
+        std::uint32_t rotation_bits = 0;
+
+        //! three grid coordinates per entity
+        std::vector<std::int32_t> positions;
+
+        //! four per entity: the index of the rotation's largest component in the order x, y, z, w, then
+        /// its other three, quantized
+        std::vector<std::uint16_t> rotations;
+
+        //! the number of entities
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] bool operator==(const transform_snapshot &aOther) const;
+
+        [[nodiscard]] bool operator!=(const transform_snapshot &aOther) const;
+    };
+
+    //! quantize aCount positions and unit rotations into aOut, reusing its storage. Throws
+    /// std::invalid_argument for a non-positive position spacing or rotation_bits out of range, and
+    /// std::out_of_range for a position more than 2^30 grid spacings from the origin, or not finite.
+    template<typename component_type>
+    void quantize(const vector3<component_type> *const aPositions, const quaternion<component_type> *const aRotations,
+        const std::size_t aCount, const transform_precision<component_type> &aPrecision,
+        transform_snapshot &aOut);
+
+    //! quantize the positions and rotations of views, such as the transforms of an entity array. aRotations
+    /// holds at least as many as aPositions; otherwise throws std::invalid_argument.
+    template<typename component_type>
+    void quantize(const strided_span<const vector3<component_type>> aPositions,
+        const strided_span<const quaternion<component_type>> aRotations,
+        const transform_precision<component_type> &aPrecision, transform_snapshot &aOut);
+
+    //! the positions and rotations aSnapshot holds, aSnapshot.size() of each. aPrecision must be the one
+    /// it was quantized with.
+    template<typename component_type>
+    void dequantize(const transform_snapshot &aSnapshot, const transform_precision<component_type> &aPrecision,
+        vector3<component_type> *const aPositions, quaternion<component_type> *const aRotations);
+
+    //! dequantize into views, each at least as large as aSnapshot; otherwise throws std::invalid_argument
+    template<typename component_type>
+    void dequantize(const transform_snapshot &aSnapshot, const transform_precision<component_type> &aPrecision,
+        const strided_span<vector3<component_type>> aPositions,
+        const strided_span<quaternion<component_type>> aRotations);
+
+    //! append aCurrent to aOut, encoded as its difference from aBaseline, whole and byte aligned. aBaseline
+    /// is empty, or has aCurrent's size and rotation_bits; otherwise throws std::invalid_argument.
+    inline void encode_delta(const transform_snapshot &aBaseline, const transform_snapshot &aCurrent,
+        std::vector<std::uint8_t> &aOut);
+
+    //! read a snapshot from [aFirst, aLast), encoded against aBaseline, into aOut, which may be aBaseline.
+    /// Returns one past the last byte read. Throws std::runtime_error for a stream that is truncated,
+    /// malformed, or encoded against a baseline of another size or precision, and then leaves aOut as it
+    /// was.
+    inline const std::uint8_t *decode_delta(const transform_snapshot &aBaseline, const std::uint8_t *const aFirst,
+        const std::uint8_t *const aLast, transform_snapshot &aOut);
+GDK_MATH_END_NAMESPACE
+
+#include <gdk/transform_delta.inl> // varies by implementation
+
+#endif
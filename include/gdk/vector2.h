@@ -3,6 +3,8 @@
 #ifndef GDK_MATH_VECTOR2_H
 #define GDK_MATH_VECTOR2_H
 
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
 #include <gdk/storage.inl> // varies by implementation
 
 #include <gdk/math_constants.h>
@@ -15,7 +17,7 @@
 #include <tuple>
 #include <type_traits>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     /// \brief 2d vector used to represent position, speed, direction, normalized coordinates
     template<typename component_type_param = float>
     class vector2 final : public vector2_storage<component_type_param> {
@@ -119,8 +121,12 @@ namespace gdk {
     template<typename component_type>
     [[nodiscard]] constexpr vector2<component_type> lerp(const vector2<component_type> &a,
         const vector2<component_type> &b, const component_type t);
-}
+GDK_MATH_END_NAMESPACE
 
 #include <gdk/vector2.inl> // varies by implementation
 
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(vector2)
+GDK_MATH_END_NAMESPACE
+
 #endif
@@ -3,6 +3,8 @@
 #ifndef GDK_MATH_VECTOR3_H
 #define GDK_MATH_VECTOR3_H
 
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
 #include <gdk/storage.inl> // varies by implementation
 
 #include <gdk/math_constants.h>
@@ -14,9 +16,11 @@
 #include <stdexcept>
 #include <type_traits>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     /// \brief 3d vector used to represent position, scale, velocity, heading, euler angles, etc.
     /// - **right-handed**: +X right, +Y up, +Z back
+    /// - signed integer components suit grid cells. Members that take a square root or compare
+    ///   against a threshold still require floating point.
     template<typename component_type_param = float>
     class vector3 final : public vector3_storage<component_type_param> {
     public:
@@ -99,8 +103,12 @@ namespace gdk {
     template<typename component_type>
     [[nodiscard]] constexpr vector3<component_type> lerp(const vector3<component_type> &a,
         const vector3<component_type> &b, const component_type t);
-}
+GDK_MATH_END_NAMESPACE
 
 #include <gdk/vector3.inl> // varies by implementation
 
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(vector3)
+GDK_MATH_END_NAMESPACE
+
 #endif
@@ -3,13 +3,15 @@
 #ifndef GDK_MATH_VECTOR4_H
 #define GDK_MATH_VECTOR4_H
 
+#include <gdk/backend.h>
+#include <gdk/extern_templates.h>
 #include <gdk/storage.inl> // varies by implementation
 
 #include <gdk/vector3.h>
 
 #include <iosfwd>
 
-namespace gdk {
+GDK_MATH_BEGIN_NAMESPACE
     /// \brief a homogeneous coordinate: a 3d position or direction plus w
     /// - w = 1 marks a position, so a transform's translation applies to it
     /// - w = 0 marks a direction, so it does not
@@ -52,8 +54,12 @@ namespace gdk {
         //! the origin as a point: {0, 0, 0, 1}. 
         static const vector4<component_type> origin;
     };
-}
+GDK_MATH_END_NAMESPACE
 
 #include <gdk/vector4.inl> // varies by implementation
 
+GDK_MATH_BEGIN_NAMESPACE
+    GDK_MATH_EXTERN_TEMPLATE(vector4)
+GDK_MATH_END_NAMESPACE
+
 #endif
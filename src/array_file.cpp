@@ -0,0 +1,94 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file the file mapping behind gdk/array_file.h, compiled into gdkmath_array_file so that the platform
+/// headers it needs, and the names they declare, stay out of every translation unit that includes gdk
+
+#include <gdk/array_file.h>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+GDK_MATH_BEGIN_NAMESPACE
+    namespace detail {
+        const unsigned char *map_array_file(const std::string &aPath, std::size_t &aSize) {
+            const unsigned char *data = nullptr;
+            aSize = 0;
+
+#if defined(_WIN32)
+            const auto file = CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+            if (file == INVALID_HANDLE_VALUE) array_file_error(aPath, "cannot be opened");
+
+            LARGE_INTEGER size;
+            const auto sized = GetFileSizeEx(file, &size);
+            const auto mapping = sized && size.QuadPart > 0
+                ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                : nullptr;
+
+            CloseHandle(file);
+
+            if (!sized) array_file_error(aPath, "cannot be sized");
+
+            if (mapping) {
+                data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                aSize = static_cast<std::size_t>(size.QuadPart);
+
+                // the view keeps the mapping open
+                CloseHandle(mapping);
+            }
+#else
+            const auto file = ::open(aPath.c_str(), O_RDONLY);
+
+            if (file < 0) array_file_error(aPath, "cannot be opened");
+
+            struct stat status;
+            const auto sized = ::fstat(file, &status) == 0;
+
+            if (sized && status.st_size > 0) {
+                void *const mapped = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ,
+                    MAP_PRIVATE, file, 0);
+
+                if (mapped != MAP_FAILED) {
+                    data = static_cast<const unsigned char *>(mapped);
+                    aSize = static_cast<std::size_t>(status.st_size);
+                }
+            }
+
+            // the mapping keeps the file open
+            ::close(file);
+
+            if (!sized) array_file_error(aPath, "cannot be sized");
+#endif
+
+            if (!data) {
+                aSize = 0;
+                array_file_error(aPath, "cannot be mapped, or is empty");
+            }
+
+            return data;
+        }
+
+        void unmap_array_file(const unsigned char *const aData, const std::size_t aSize) {
+#if defined(_WIN32)
+            static_cast<void>(aSize);
+
+            UnmapViewOfFile(aData);
+#else
+            ::munmap(const_cast<unsigned char *>(aData), aSize);
+#endif
+        }
+    }
+GDK_MATH_END_NAMESPACE
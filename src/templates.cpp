@@ -0,0 +1,41 @@
+// © Joseph Cameron - All Rights Reserved
+
+/// \file the float and double instantiations of every class template, compiled once into
+/// gdkmath_templates, for the translation units that declare them extern (see gdk/extern_templates.h)
+
+#include <gdk/math.h>
+
+GDK_MATH_BEGIN_NAMESPACE
+    template class aabb<float>;
+    template class aabb<double>;
+
+    template class vector2<float>;
+    template class vector2<double>;
+
+    template class vector3<float>;
+    template class vector3<double>;
+
+    template class vector4<float>;
+    template class vector4<double>;
+
+    template class quaternion<float>;
+    template class quaternion<double>;
+
+    template class matrix3x3<float>;
+    template class matrix3x3<double>;
+
+    template class matrix4x4<float>;
+    template class matrix4x4<double>;
+
+    template class obb<float>;
+    template class obb<double>;
+
+    template class sphere<float>;
+    template class sphere<double>;
+
+    template class spatial_hash_grid<float>;
+    template class spatial_hash_grid<double>;
+
+    template class sweep_and_prune<float>;
+    template class sweep_and_prune<double>;
+GDK_MATH_END_NAMESPACE
@@ -0,0 +1,100 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/aabb.h>
+
+#include <array>
+
+using namespace gdk;
+
+TEMPLATE_LIST_TEST_CASE("aabb construction", "[aabb]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using box = aabb<TestType>;
+
+    SECTION("the default is a zero size box at the origin")
+    {
+        const box b;
+
+        REQUIRE(b.min == vec::zero);
+        REQUIRE(b.max == vec::zero);
+        REQUIRE_FALSE(b.is_empty());
+    }
+
+    SECTION("from_points is the tightest box around the points")
+    {
+        const std::array<vec, 3> points{vec(1, -2, 3), vec(-4, 5, 0), vec(2, 2, -6)};
+
+        const auto b = box::from_points(points.data(), points.size());
+
+        REQUIRE(b.min == vec(-4, -2, -6));
+        REQUIRE(b.max == vec(2, 5, 3));
+
+        for (const auto &p : points) REQUIRE(b.contains(p));
+    }
+
+    SECTION("from no points is empty")
+    {
+        REQUIRE(box::from_points(nullptr, 0).is_empty());
+        REQUIRE(box::empty.is_empty());
+    }
+
+    SECTION("from_center agrees with center and half_extents")
+    {
+        const auto b = box::from_center(vec(1, 2, 3), vec(0.5f, 1, 2));
+
+        REQUIRE(b.center() == vec(1, 2, 3));
+        REQUIRE(b.half_extents() == vec(0.5f, 1, 2));
+        REQUIRE(b.size() == vec(1, 2, 4));
+        REQUIRE(b.surface_area() == Approx(2 * (2 + 8 + 4)));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("aabb queries", "[aabb]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using box = aabb<TestType>;
+
+    const box unit(vec(0, 0, 0), vec(1, 1, 1));
+
+    SECTION("containment is inclusive of the surface")
+    {
+        REQUIRE(unit.contains(vec(0.5f, 0.5f, 0.5f)));
+        REQUIRE(unit.contains(vec(1, 1, 1)));
+        REQUIRE_FALSE(unit.contains(vec(1.5f, 0.5f, 0.5f)));
+
+        REQUIRE(unit.contains(box(vec(0.25f), vec(0.75f))));
+        REQUIRE(unit.contains(unit));
+        REQUIRE_FALSE(unit.contains(box(vec(0.5f), vec(1.5f))));
+    }
+
+    SECTION("touching boxes overlap, separated ones do not")
+    {
+        REQUIRE(unit.overlaps(box(vec(1, 0, 0), vec(2, 1, 1))));
+        REQUIRE(unit.overlaps(box(vec(0.5f), vec(3))));
+        REQUIRE_FALSE(unit.overlaps(box(vec(0, 1.01f, 0), vec(1, 2, 1))));
+    }
+
+    SECTION("merging with empty is the identity")
+    {
+        REQUIRE(box::empty.merged(unit) == unit);
+        REQUIRE(unit.merged(box::empty) == unit);
+        REQUIRE_FALSE(box::empty.overlaps(unit));
+    }
+
+    SECTION("merged encloses both operands")
+    {
+        const auto merged = unit.merged(box(vec(-1, 2, 0), vec(0, 3, 0.5f)));
+
+        REQUIRE(merged == box(vec(-1, 0, 0), vec(1, 3, 1)));
+        REQUIRE(unit.merged(vec(2, -1, 0.5f)) == box(vec(0, -1, 0), vec(2, 1, 1)));
+    }
+
+    SECTION("expanded grows every side")
+    {
+        REQUIRE(unit.expanded(1) == box(vec(-1), vec(2)));
+        REQUIRE(unit.expanded(-0.25f) == box(vec(0.25f), vec(0.75f)));
+    }
+}
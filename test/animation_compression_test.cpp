@@ -0,0 +1,279 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/animation_compression.h>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! a smooth path with some sharp turns, one sample per frame
+    template<typename T>
+    std::vector<vector3<T>> translations(const std::size_t aFrames) {
+        std::vector<vector3<T>> out;
+
+        for (std::size_t i = 0; i < aFrames; ++i) {
+            const auto t = static_cast<T>(i) / 120;
+
+            out.emplace_back(std::sin(t) * 2, std::abs(std::sin(t * 3)), t * T(0.5));
+        }
+
+        return out;
+    }
+
+    //! a rotation that speeds up and changes axis, with every other sample negated, as exporters can
+    /// give: q and -q are the same rotation
+    template<typename T>
+    std::vector<quaternion<T>> rotations(const std::size_t aFrames) {
+        std::vector<quaternion<T>> out;
+
+        for (std::size_t i = 0; i < aFrames; ++i) {
+            const auto t = static_cast<T>(i) / 120;
+
+            const auto q = quaternion<T>::from_angle_axis(t * t, vector3<T>(1, t, 0).normal());
+
+            out.push_back(i % 2 ? -q : q);
+        }
+
+        return out;
+    }
+
+    template<typename T>
+    T angle_between(const quaternion<T> &a, const quaternion<T> &b) {
+        const auto d = a.dot_product(b) < 0 ? a + b : a + -b;
+
+        return 4 * std::asin(std::min(T(1), std::sqrt(d.dot_product(d)) / 2));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_compression: vector3 tracks", "[animation_compression]", type::floating_point)
+{
+    using T = TestType;
+
+    SECTION("every frame plays back within the tolerance, from fewer keys")
+    {
+        const auto source = translations<T>(300);
+        const auto tolerance = T(1e-3);
+
+        const auto track = compress(source.data(), source.size(), tolerance);
+
+        REQUIRE(track.frame_count == source.size());
+        REQUIRE(track.frames.front() == 0);
+        REQUIRE(track.frames.back() == source.size() - 1);
+        REQUIRE(track.frames.size() < source.size() / 2);
+        REQUIRE(track.values.size() == track.frames.size() * 3);
+
+        for (std::size_t i = 0; i < source.size(); ++i)
+            REQUIRE((sample(track, static_cast<T>(i)) - source[i]).length() <= tolerance);
+    }
+
+    SECTION("a track lerp reproduces keeps only its ends")
+    {
+        std::vector<vector3<T>> line, still;
+
+        for (int i = 0; i < 50; ++i) {
+            line.emplace_back(T(i), T(-2 * i), T(1));
+            still.emplace_back(T(3), T(4), T(5));
+        }
+
+        REQUIRE(compress(line.data(), line.size(), T(1e-3)).frames.size() == 2);
+        REQUIRE(compress(still.data(), still.size(), T(1e-3)).frames.size() == 2);
+        REQUIRE(sample(compress(still.data(), still.size(), T(1e-3)), T(20)) == vector3<T>(3, 4, 5));
+    }
+
+    SECTION("long tracks compress without measuring every segment frame by frame")
+    {
+        constexpr std::size_t FRAMES = 200000;
+
+        std::vector<vector3<T>> still(FRAMES, vector3<T>(1, 1, 1)), line, steps;
+
+        for (std::size_t i = 0; i < FRAMES; ++i) {
+            line.emplace_back(T(i) / FRAMES, T(0), T(0));
+            steps.emplace_back(T(i / 1000) / 100, T(0), T(0));
+        }
+
+        REQUIRE(compress(still.data(), still.size(), T(1e-3)).frames.size() == 2);
+        REQUIRE(compress(line.data(), line.size(), T(1e-3)).frames.size() == 2);
+
+        const auto track = compress(steps.data(), steps.size(), T(1e-3));
+
+        REQUIRE(track.frames.size() < FRAMES / 100);
+
+        for (std::size_t i = 0; i < FRAMES; i += 97)
+            REQUIRE((sample(track, static_cast<T>(i)) - steps[i]).length() <= T(1e-3));
+    }
+
+    SECTION("between frames is the interpolation of the keys, and outside them the end keys")
+    {
+        const std::vector<vector3<T>> source{{0, 0, 0}, {2, 4, 8}};
+
+        const auto track = compress(source.data(), source.size(), T(1e-3));
+
+        const auto middle = sample(track, T(0.25));
+
+        REQUIRE(middle.x == Approx(0.5));
+        REQUIRE(middle.z == Approx(2));
+        REQUIRE(sample(track, T(-3)) == sample(track, T(0)));
+        REQUIRE(sample(track, T(9)) == sample(track, T(1)));
+    }
+
+    SECTION("one frame is one key, and none is none")
+    {
+        const vector3<T> only(1, 2, 3);
+
+        REQUIRE(compress(&only, 1, T(1e-3)).frames.size() == 1);
+        REQUIRE(compress(&only, 0, T(1e-3)).frames.empty());
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_compression: quaternion tracks", "[animation_compression]",
+    type::floating_point)
+{
+    using T = TestType;
+
+    const auto source = rotations<T>(240);
+    const auto tolerance = T(2e-3);
+
+    const auto track = compress(source.data(), source.size(), tolerance);
+
+    REQUIRE(track.frames.size() < source.size() / 2);
+    REQUIRE(track.values.size() == track.frames.size() * 4);
+
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        const auto played = sample(track, static_cast<T>(i));
+
+        REQUIRE(played.dot_product(played) == Approx(1));
+        REQUIRE(angle_between(played, source[i]) <= tolerance);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_compression: many tracks", "[animation_compression]", type::floating_point)
+{
+    using T = TestType;
+
+    constexpr std::size_t TRACKS = 9, FRAMES = 120;
+
+    std::vector<std::vector<vector3<T>>> translationTracks;
+    std::vector<std::vector<quaternion<T>>> rotationTracks;
+    std::vector<const vector3<T> *> translationPointers;
+    std::vector<const quaternion<T> *> rotationPointers;
+
+    for (std::size_t i = 0; i < TRACKS; ++i) {
+        translationTracks.push_back(translations<T>(FRAMES + i * 10));
+        translationTracks.back().resize(FRAMES);
+        rotationTracks.push_back(rotations<T>(FRAMES + i * 10));
+        rotationTracks.back().resize(FRAMES);
+    }
+
+    for (std::size_t i = 0; i < TRACKS; ++i) {
+        translationPointers.push_back(translationTracks[i].data());
+        rotationPointers.push_back(rotationTracks[i].data());
+    }
+
+    std::vector<compressed_vector3_track<T>> translationsOut(TRACKS);
+    std::vector<compressed_quaternion_track<T>> rotationsOut(TRACKS);
+
+    compress(translationPointers.data(), TRACKS, FRAMES, T(1e-3), translationsOut.data());
+    compress(rotationPointers.data(), TRACKS, FRAMES, T(1e-3), rotationsOut.data());
+
+    SECTION("compressing them together gives what compressing each alone does")
+    {
+        for (std::size_t i = 0; i < TRACKS; ++i) {
+            const auto translation = compress(translationPointers[i], FRAMES, T(1e-3));
+            const auto rotation = compress(rotationPointers[i], FRAMES, T(1e-3));
+
+            REQUIRE(translationsOut[i].frames == translation.frames);
+            REQUIRE(translationsOut[i].values == translation.values);
+            REQUIRE(rotationsOut[i].frames == rotation.frames);
+            REQUIRE(rotationsOut[i].values == rotation.values);
+        }
+    }
+
+    SECTION("sampling a pose agrees with sampling each track")
+    {
+        std::vector<vector3<T>> translationPose(TRACKS);
+        std::vector<quaternion<T>> rotationPose(TRACKS);
+
+        const auto frame = T(47.5);
+
+        sample(translationsOut.data(), TRACKS, frame, translationPose.data());
+        sample(rotationsOut.data(), TRACKS, frame, rotationPose.data());
+
+        for (std::size_t i = 0; i < TRACKS; ++i) {
+            REQUIRE(translationPose[i] == sample(translationsOut[i], frame));
+            REQUIRE(rotationPose[i] == sample(rotationsOut[i], frame));
+        }
+    }
+    SECTION("a pose written through a view is the pose written to an array")
+    {
+        struct bone final {
+            vector3<T> translation;
+            quaternion<T> rotation;
+        };
+
+        std::vector<bone> bones(TRACKS);
+        std::vector<vector3<T>> translationPose(TRACKS);
+        std::vector<quaternion<T>> rotationPose(TRACKS);
+
+        const strided_span<vector3<T>> translationView(&bones[0].translation, TRACKS, sizeof(bone));
+        const strided_span<quaternion<T>> rotationView(&bones[0].rotation, TRACKS, sizeof(bone));
+
+        const auto frame = T(63.25);
+
+        sample(translationsOut.data(), TRACKS, frame, translationView);
+        sample(rotationsOut.data(), TRACKS, frame, rotationView);
+        sample(translationsOut.data(), TRACKS, frame, translationPose.data());
+        sample(rotationsOut.data(), TRACKS, frame, rotationPose.data());
+
+        for (std::size_t i = 0; i < TRACKS; ++i) {
+            REQUIRE(bones[i].translation == translationPose[i]);
+            REQUIRE(bones[i].rotation == rotationPose[i]);
+        }
+
+        REQUIRE_THROWS_AS(sample(translationsOut.data(), TRACKS, frame, translationView.subspan(0, TRACKS - 1)),
+            std::invalid_argument);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_compression: samples read through a view", "[animation_compression]",
+    type::floating_point)
+{
+    using T = TestType;
+
+    constexpr std::size_t FRAMES = 300;
+
+    const auto translationSource = translations<T>(FRAMES);
+    const auto rotationSource = rotations<T>(FRAMES);
+
+    //! one frame of a clip, its channels interleaved
+    struct frame final {
+        quaternion<T> rotation;
+        vector3<T> translation;
+    };
+
+    std::vector<frame> clip(FRAMES);
+
+    for (std::size_t i = 0; i < FRAMES; ++i) clip[i] = {rotationSource[i], translationSource[i]};
+
+    const strided_span<const vector3<T>> translationView(&clip[0].translation, FRAMES, sizeof(frame));
+    const strided_span<const quaternion<T>> rotationView(&clip[0].rotation, FRAMES, sizeof(frame));
+
+    const auto fromView = compress(translationView, T(1e-3));
+    const auto fromArray = compress(translationSource.data(), FRAMES, T(1e-3));
+    const auto rotationFromView = compress(rotationView, T(1e-3));
+    const auto rotationFromArray = compress(rotationSource.data(), FRAMES, T(1e-3));
+
+    REQUIRE(fromView.frame_count == FRAMES);
+    REQUIRE(fromView.frames == fromArray.frames);
+    REQUIRE(fromView.values == fromArray.values);
+    REQUIRE(rotationFromView.frames == rotationFromArray.frames);
+    REQUIRE(rotationFromView.values == rotationFromArray.values);
+
+    REQUIRE(compress(strided_span<const vector3<T>>(), T(1e-3)).frames.empty());
+}
@@ -0,0 +1,246 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/animation_sampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! tracks of different lengths with unevenly spaced keys, the arrays the views point into kept alive
+    template<typename T>
+    struct clip final {
+        std::vector<std::vector<T>> times;
+        std::vector<std::vector<vector3<T>>> translationValues, scaleValues;
+        std::vector<std::vector<quaternion<T>>> rotationValues;
+
+        std::vector<keyframe_track<vector3<T>>> translations, scales;
+        std::vector<keyframe_track<quaternion<T>>> rotations;
+
+        explicit clip(const std::size_t aTracks) {
+            for (std::size_t i = 0; i < aTracks; ++i) {
+                const auto keys = 1 + i % 23;
+
+                times.emplace_back();
+                translationValues.emplace_back();
+                scaleValues.emplace_back();
+                rotationValues.emplace_back();
+
+                T time = T(i % 3) * T(0.1);
+
+                for (std::size_t k = 0; k < keys; ++k) {
+                    time += T(0.05) + T((i + k) % 5) * T(0.03);
+
+                    const auto s = static_cast<T>(i + k);
+
+                    times.back().push_back(time);
+                    translationValues.back().emplace_back(std::sin(s), std::cos(s * 2), s);
+                    scaleValues.back().emplace_back(1 + s / 100, 1, 1 - s / 100);
+                    rotationValues.back().push_back(quaternion<T>::from_angle_axis(s * T(0.7),
+                        vector3<T>(1, s, 2).normal()));
+                }
+            }
+
+            for (std::size_t i = 0; i < aTracks; ++i) {
+                const auto count = times[i].size();
+
+                translations.push_back({times[i].data(), translationValues[i].data(), count});
+                scales.push_back({times[i].data(), scaleValues[i].data(), count});
+                rotations.push_back({times[i].data(), rotationValues[i].data(), count});
+            }
+        }
+    };
+
+    //! what a track gives at aTime, by binary search and the library's interpolations
+    template<typename value_type, typename T, typename blend_type>
+    value_type reference(const keyframe_track<value_type> &aTrack, const T aTime, blend_type &&aBlend) {
+        const auto *const end = aTrack.times + aTrack.count;
+        const auto after = static_cast<std::size_t>(std::upper_bound(aTrack.times, end, aTime) - aTrack.times);
+
+        if (after == 0) return aTrack.values[0];
+        if (after == aTrack.count) return aTrack.values[aTrack.count - 1];
+
+        const auto t = (aTime - aTrack.times[after - 1]) / (aTrack.times[after] - aTrack.times[after - 1]);
+
+        return aBlend(aTrack.values[after - 1], aTrack.values[after], t);
+    }
+
+    template<typename T>
+    bool near(const vector3<T> &a, const vector3<T> &b) {
+        return (a - b).length() <= T(1e-4);
+    }
+
+    template<typename T>
+    bool near(const quaternion<T> &a, const quaternion<T> &b) {
+        return std::abs(a.dot_product(b)) >= T(1) - T(1e-5);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_sampler: tracks", "[animation_sampler]", type::floating_point)
+{
+    using T = TestType;
+
+    // more tracks than one block holds
+    const clip<T> c(150);
+    const auto count = c.translations.size();
+
+    std::vector<vector3<T>> translations(count);
+    std::vector<quaternion<T>> rotations(count), slerped(count);
+
+    SECTION("playing forward, backward and jumping through one cursor agrees with searching afresh")
+    {
+        animation_cursor cursor, slerpCursor;
+
+        std::vector<T> steps;
+        for (T time = -0.1f; time < 2; time += T(0.013)) steps.push_back(time);
+        for (T time = 2; time > 0; time -= T(0.071)) steps.push_back(time);
+        for (const auto time : {T(0.9), T(0.05), T(1.7), T(0.4), T(3)}) steps.push_back(time);
+
+        for (const auto time : steps) {
+            sample(c.translations.data(), count, time, cursor, translations.data());
+            sample(c.rotations.data(), count, time, slerpCursor, rotations.data());
+            sample(c.rotations.data(), count, time, slerpCursor, slerped.data(), rotation_interpolation::slerp);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                REQUIRE(near(translations[i], reference(c.translations[i], time,
+                    [](const vector3<T> &a, const vector3<T> &b, const T t) { return lerp(a, b, t); })));
+                REQUIRE(near(rotations[i], reference(c.rotations[i], time,
+                    [](const quaternion<T> &a, const quaternion<T> &b, const T t) { return nlerp(a, b, t); })));
+                REQUIRE(near(slerped[i], reference(c.rotations[i], time,
+                    [](const quaternion<T> &a, const quaternion<T> &b, const T t) { return slerp(a, b, t); })));
+            }
+        }
+    }
+
+    SECTION("the cursor grows to the tracks sampled, and a single key is constant")
+    {
+        animation_cursor cursor(2);
+
+        sample(c.translations.data(), count, T(0.5), cursor, translations.data());
+
+        REQUIRE(cursor.keys.size() == count);
+        REQUIRE(c.translations[0].count == 1);
+        REQUIRE(translations[0] == c.translationValues[0][0]);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_sampler: poses", "[animation_sampler]", type::floating_point)
+{
+    using T = TestType;
+
+    const clip<T> c(100);
+    const auto count = c.translations.size();
+
+    animation_cursor cursor, trackCursor;
+
+    std::vector<bone_transform<T>> pose(count);
+    std::vector<matrix4x4<T>> matrices(count);
+    std::vector<vector3<T>> translations(count), scales(count);
+    std::vector<quaternion<T>> rotations(count);
+
+    for (const auto time : {T(0.2), T(0.35), T(0.8), T(0.1)}) {
+        sample(c.translations.data(), c.rotations.data(), c.scales.data(), count, time, cursor, pose.data());
+        sample(c.translations.data(), c.rotations.data(), c.scales.data(), count, time, cursor, matrices.data());
+
+        sample(c.translations.data(), count, time, trackCursor, translations.data());
+        sample(c.rotations.data(), count, time, trackCursor, rotations.data());
+        sample(c.scales.data(), count, time, trackCursor, scales.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(pose[i].translation == translations[i]);
+            REQUIRE(pose[i].rotation == rotations[i]);
+            REQUIRE(pose[i].scale == scales[i]);
+            REQUIRE(matrices[i] == matrix4x4<T>(translations[i], rotations[i], scales[i]));
+        }
+    }
+
+    SECTION("without scale tracks the scale is one")
+    {
+        sample(c.translations.data(), c.rotations.data(), nullptr, count, T(0.5), cursor, pose.data());
+
+        for (const auto &bone : pose) REQUIRE(bone.scale == vector3<T>(1));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("animation_sampler: views", "[animation_sampler]", type::floating_point)
+{
+    using T = TestType;
+
+    // more tracks than one block holds
+    const clip<T> c(150);
+    const auto count = c.translations.size();
+
+    //! an instance buffer entry, each output one member of it
+    struct instance final {
+        vector3<T> translation;
+        quaternion<T> rotation;
+        bone_transform<T> bone;
+        matrix4x4<T> matrix;
+    };
+
+    std::vector<instance> buffer(count);
+
+    const strided_span<vector3<T>> translationView(&buffer[0].translation, count, sizeof(instance));
+    const strided_span<quaternion<T>> rotationView(&buffer[0].rotation, count, sizeof(instance));
+    const strided_span<bone_transform<T>> boneView(&buffer[0].bone, count, sizeof(instance));
+    const strided_span<matrix4x4<T>> matrixView(&buffer[0].matrix, count, sizeof(instance));
+
+    std::vector<vector3<T>> translations(count);
+    std::vector<quaternion<T>> rotations(count);
+    std::vector<bone_transform<T>> pose(count);
+    std::vector<matrix4x4<T>> matrices(count);
+
+    SECTION("values written through a view are those written to an array")
+    {
+        animation_cursor viewCursor, arrayCursor;
+
+        for (const auto time : {T(0.2), T(0.35), T(1.8), T(0.1)}) {
+            sample(c.translations.data(), count, time, viewCursor, translationView);
+            sample(c.rotations.data(), count, time, viewCursor, rotationView, rotation_interpolation::slerp);
+            sample(c.translations.data(), c.rotations.data(), c.scales.data(), count, time, viewCursor, boneView);
+            sample(c.translations.data(), c.rotations.data(), nullptr, count, time, viewCursor, matrixView);
+
+            sample(c.translations.data(), count, time, arrayCursor, translations.data());
+            sample(c.rotations.data(), count, time, arrayCursor, rotations.data(), rotation_interpolation::slerp);
+            sample(c.translations.data(), c.rotations.data(), c.scales.data(), count, time, arrayCursor, pose.data());
+            sample(c.translations.data(), c.rotations.data(), nullptr, count, time, arrayCursor, matrices.data());
+
+            for (std::size_t i = 0; i < count; ++i) {
+                REQUIRE(buffer[i].translation == translations[i]);
+                REQUIRE(buffer[i].rotation == rotations[i]);
+                REQUIRE(buffer[i].bone.translation == pose[i].translation);
+                REQUIRE(buffer[i].bone.rotation == pose[i].rotation);
+                REQUIRE(buffer[i].bone.scale == pose[i].scale);
+                REQUIRE(buffer[i].matrix == matrices[i]);
+            }
+        }
+    }
+
+    SECTION("a contiguous view is written as the array it views")
+    {
+        animation_cursor viewCursor, arrayCursor;
+        std::vector<vector3<T>> viewed(count);
+
+        sample(c.translations.data(), count, T(0.7), viewCursor, strided_span<vector3<T>>(viewed.data(), count));
+        sample(c.translations.data(), count, T(0.7), arrayCursor, translations.data());
+
+        REQUIRE(viewed == translations);
+    }
+
+    SECTION("a view smaller than the track count throws")
+    {
+        animation_cursor cursor;
+
+        REQUIRE_THROWS_AS(sample(c.translations.data(), count, T(0.5), cursor, translationView.subspan(1, count - 1)),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(sample(c.translations.data(), c.rotations.data(), nullptr, count, T(0.5), cursor,
+            boneView.subspan(0, count - 1)), std::invalid_argument);
+    }
+}
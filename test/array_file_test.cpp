@@ -0,0 +1,202 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+
+#include <gdk/array_file.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! a file in the working directory, removed when the test is done with it
+    struct scratch_file final {
+        std::string path;
+
+        explicit scratch_file(std::string aPath)
+        : path(std::move(aPath)) {}
+
+        ~scratch_file() {
+            std::remove(path.c_str());
+        }
+    };
+
+    void write_bytes(const std::string &aPath, const void *const aBytes, const std::size_t aSize) {
+        std::FILE *const file = std::fopen(aPath.c_str(), "wb");
+        std::fwrite(aBytes, 1, aSize, file);
+        std::fclose(file);
+    }
+}
+
+TEMPLATE_TEST_CASE("array_file: round trips", "[array_file]", float, double)
+{
+    using T = TestType;
+
+    const scratch_file file("gdk_math_array_file_test.bin");
+
+    SECTION("matrices come back bit for bit, in place and aligned")
+    {
+        std::vector<matrix4x4<T>> matrices;
+
+        for (std::size_t i = 0; i < 10000; ++i) {
+            const auto s = static_cast<T>(i);
+
+            matrices.emplace_back(vector3<T>(s, -s, s / 3), quaternion<T>::from_angle_axis(s / 100,
+                vector3<T>(1, 2, 3).normal()), vector3<T>(1 + s / 1000));
+        }
+
+        write_array_file(file.path, matrices.data(), matrices.size());
+
+        const mapped_array_file mapped(file.path);
+        const auto view = mapped.view<matrix4x4<T>>();
+
+        REQUIRE(mapped.size() == matrices.size());
+        REQUIRE(mapped.holds<matrix4x4<T>>());
+        REQUIRE(view.is_contiguous());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(view.data()) % 64 == 0);
+
+        for (std::size_t i = 0; i < matrices.size(); ++i) REQUIRE(view[i] == matrices[i]);
+    }
+
+    SECTION("each element type is tagged, and asking for another throws")
+    {
+        const std::vector<quaternion<T>> rotations{quaternion<T>::identity, {0, 1, 0, 0}};
+
+        write_array_file(file.path, rotations.data(), rotations.size());
+
+        const mapped_array_file mapped(file.path);
+
+        REQUIRE(mapped.header().element == array_file_element::quaternion);
+        REQUIRE(mapped.header().element_size == sizeof(quaternion<T>));
+        REQUIRE(mapped.holds<quaternion<T>>());
+        REQUIRE(!mapped.holds<vector4<T>>());
+        REQUIRE(!mapped.holds<quaternion<typename std::conditional<std::is_same<T, float>::value, double,
+            float>::type>>());
+        REQUIRE_THROWS_AS(mapped.view<vector4<T>>(), std::runtime_error);
+
+        REQUIRE(mapped.view<quaternion<T>>()[1] == rotations[1]);
+    }
+
+    SECTION("vectors of every width, and an empty array")
+    {
+        const std::vector<vector2<T>> twos{{1, 2}, {3, 4}};
+        const std::vector<vector3<T>> threes{{1, 2, 3}};
+        const std::vector<matrix3x3<T>> none;
+
+        write_array_file(file.path, twos.data(), twos.size());
+        REQUIRE(mapped_array_file(file.path).view<vector2<T>>()[1] == twos[1]);
+
+        write_array_file(file.path, threes.data(), threes.size());
+        REQUIRE(mapped_array_file(file.path).view<vector3<T>>()[0] == threes[0]);
+
+        write_array_file(file.path, none.data(), none.size());
+        REQUIRE(mapped_array_file(file.path).view<matrix3x3<T>>().empty());
+    }
+
+    SECTION("moving hands over the mapping")
+    {
+        const std::vector<vector4<T>> values{{1, 2, 3, 4}};
+
+        write_array_file(file.path, values.data(), values.size());
+
+        mapped_array_file first(file.path);
+        mapped_array_file second(std::move(first));
+
+        REQUIRE(first.size() == 0);
+        REQUIRE(!first.holds<vector4<T>>());
+        REQUIRE(second.view<vector4<T>>()[0] == values[0]);
+
+        first = std::move(second);
+
+        REQUIRE(first.view<vector4<T>>()[0] == values[0]);
+    }
+}
+
+TEST_CASE("array_file: malformed files are rejected", "[array_file]")
+{
+    const scratch_file file("gdk_math_array_file_malformed.bin");
+
+    const std::vector<vector3<float>> values(10, vector3<float>(1));
+
+    write_array_file(file.path, values.data(), values.size());
+
+    std::vector<unsigned char> bytes(sizeof(array_file_header) + sizeof(vector3<float>) * values.size());
+    {
+        const mapped_array_file mapped(file.path);
+        std::memcpy(bytes.data(), &mapped.header(), bytes.size());
+    }
+
+    //! write aBytes over the file and map it
+    const auto map = [&](const std::vector<unsigned char> &aBytes) {
+        write_bytes(file.path, aBytes.data(), aBytes.size());
+
+        const mapped_array_file mapped(file.path);
+    };
+
+    const auto header = [&]() {
+        array_file_header h;
+        std::memcpy(&h, bytes.data(), sizeof h);
+
+        return h;
+    };
+
+    //! the file with its header replaced
+    const auto with = [&](const array_file_header &aHeader) {
+        auto changed = bytes;
+        std::memcpy(changed.data(), &aHeader, sizeof aHeader);
+
+        return changed;
+    };
+
+    SECTION("a missing file")
+    {
+        REQUIRE_THROWS_AS(mapped_array_file("gdk_math_array_file_missing.bin"), std::runtime_error);
+    }
+
+    SECTION("a file shorter than its header or its payload")
+    {
+        REQUIRE_THROWS_AS(map({bytes.begin(), bytes.begin() + 10}), std::runtime_error);
+        REQUIRE_THROWS_AS(map({bytes.begin(), bytes.end() - 1}), std::runtime_error);
+        REQUIRE_THROWS_AS(map({}), std::runtime_error);
+    }
+
+    SECTION("a wrong magic, version, byte order, type, element size or payload offset")
+    {
+        auto h = header();
+        h.magic[0] = 'X';
+        REQUIRE_THROWS_AS(map(with(h)), std::runtime_error);
+
+        h = header();
+        h.version = 2;
+        REQUIRE_THROWS_AS(map(with(h)), std::runtime_error);
+
+        h = header();
+        h.byte_order = 0x04030201;
+        REQUIRE_THROWS_AS(map(with(h)), std::runtime_error);
+
+        h = header();
+        h.element = static_cast<array_file_element>(99);
+        REQUIRE_THROWS_AS(map(with(h)), std::runtime_error);
+
+        h = header();
+        h.element_size = 16;
+        REQUIRE_THROWS_AS(map(with(h)), std::runtime_error);
+
+        h = header();
+        h.payload_offset = 1000;
+        REQUIRE_THROWS_AS(map(with(h)), std::runtime_error);
+    }
+
+    SECTION("the untouched bytes still map")
+    {
+        REQUIRE_NOTHROW(map(bytes));
+    }
+}
@@ -0,0 +1,44 @@
+// © Joseph Cameron - All Rights Reserved
+
+// this translation unit opts in to the backend namespace; the rest of the test binary does not, so
+// linking the two together is itself part of the test
+#define GDK_MATH_BACKEND_NAMESPACE std_
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/math.h>
+
+#include <type_traits>
+
+TEMPLATE_LIST_TEST_CASE("backend namespace: the types live in gdk::backend::std_", "[backend]", type::floating_point)
+{
+    using T = TestType;
+
+    SECTION("gdk names the same types as gdk::backend and gdk::backend::std_")
+    {
+        STATIC_REQUIRE(std::is_same<gdk::vector3<T>, gdk::backend::std_::vector3<T>>::value);
+        STATIC_REQUIRE(std::is_same<gdk::backend::matrix4x4<T>, gdk::backend::std_::matrix4x4<T>>::value);
+        STATIC_REQUIRE(std::is_same<gdk::aabb<T>, gdk::backend::std_::aabb<T>>::value);
+    }
+
+    SECTION("the operations resolve as they do without the opt in")
+    {
+        const gdk::vector3<T> v(3, 0, 4);
+
+        REQUIRE(v.length() == Approx(5));
+
+        gdk::matrix4x4<T> m;
+        m.set_translation({1, 2, 3});
+
+        REQUIRE(m * gdk::vector3<T>::zero == gdk::vector3<T>(1, 2, 3));
+        REQUIRE(gdk::to_radians(T(180)) == Approx(gdk::numbers::pi_v<T>));
+    }
+
+    SECTION("values cross to another backend as components")
+    {
+        const auto q = gdk::quaternion<T>::from_angle_axis(T(0.5), gdk::vector3<T>::up);
+
+        REQUIRE(gdk::from_components<gdk::quaternion<T>>(gdk::to_components(q)) == q);
+    }
+}
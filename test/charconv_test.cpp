@@ -0,0 +1,294 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+
+#include <gdk/charconv.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! finite values spread over every exponent, from their bit patterns
+    template<typename T>
+    std::vector<T> awkward_values(const std::size_t aCount) {
+        using bits_type = typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type;
+
+        std::vector<T> values{T(0), -T(0), T(0.1), T(1) / T(3), std::numeric_limits<T>::min(),
+            std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()};
+
+        std::uint64_t state = 0x9e3779b97f4a7c15ull;
+
+        while (values.size() < aCount) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+
+            const auto bits = static_cast<bits_type>(sizeof(T) == 4 ? state >> 32 : state);
+
+            T value;
+            std::memcpy(&value, &bits, sizeof value);
+
+            if (std::isfinite(value)) values.push_back(value);
+        }
+
+        return values;
+    }
+
+    template<typename T>
+    bool same_bits(const T aLeft, const T aRight) {
+        return std::memcmp(&aLeft, &aRight, sizeof(T)) == 0;
+    }
+
+    template<typename value_type>
+    std::string text(const value_type &aValue) {
+        char buffer[1024];
+
+        const auto result = to_chars(buffer, buffer + sizeof buffer, aValue);
+
+        return {buffer, result.ptr};
+    }
+}
+
+TEMPLATE_TEST_CASE("charconv: single values", "[charconv]", float, double)
+{
+    using T = TestType;
+
+    SECTION("components are written shortest, separated by spaces, matrices by column")
+    {
+        REQUIRE(text(vector2<T>(1, -2.5)) == "1 -2.5");
+        REQUIRE(text(vector3<T>(T(0.1), 0, 3)) == "0.1 0 3");
+        REQUIRE(text(vector4<T>(1, 2, 3, 4)) == "1 2 3 4");
+        REQUIRE(text(quaternion<T>(1, 2, 3, 4)) == "1 2 3 4");
+
+        matrix3x3<T> m;
+        for (std::size_t column = 0; column < 3; ++column) for (std::size_t row = 0; row < 3; ++row)
+            m.set(column, row, T(column * 3 + row));
+
+        REQUIRE(text(m) == "0 1 2 3 4 5 6 7 8");
+    }
+
+    SECTION("every component reads back bit for bit")
+    {
+        const auto values = awkward_values<T>(20000);
+
+        for (std::size_t i = 0; i + 4 <= values.size(); i += 4) {
+            const vector4<T> value(values[i], values[i + 1], values[i + 2], values[i + 3]);
+            const auto written = text(value);
+
+            vector4<T> read;
+            const auto result = from_chars(written.data(), written.data() + written.size(), read);
+
+            REQUIRE(result.ec == std::errc());
+            REQUIRE(result.ptr == written.data() + written.size());
+            REQUIRE(same_bits(read.x, value.x));
+            REQUIRE(same_bits(read.y, value.y));
+            REQUIRE(same_bits(read.z, value.z));
+            REQUIRE(same_bits(read.w, value.w));
+        }
+    }
+
+    SECTION("matrices and quaternions round trip")
+    {
+        const matrix4x4<T> m(vector3<T>(1, -2, T(0.3)), quaternion<T>::from_angle_axis(T(0.7),
+            vector3<T>(1, 2, 3).normal()), vector3<T>(T(1.1)));
+        const auto q = quaternion<T>::from_angle_axis(T(1.3), vector3<T>(0, 1, 0));
+
+        const auto mText = text(m);
+        const auto qText = text(q);
+
+        matrix4x4<T> mRead;
+        quaternion<T> qRead;
+
+        REQUIRE(from_chars(mText.data(), mText.data() + mText.size(), mRead).ec == std::errc());
+        REQUIRE(from_chars(qText.data(), qText.data() + qText.size(), qRead).ec == std::errc());
+        REQUIRE(mRead == m);
+        REQUIRE(qRead == q);
+    }
+
+    SECTION("any whitespace separates components, and trailing text is left")
+    {
+        const std::string input = "  1\t2\n\n 3.5e1,rest";
+
+        vector3<T> value;
+        const auto result = from_chars(input.data(), input.data() + input.size(), value);
+
+        REQUIRE(result.ec == std::errc());
+        REQUIRE(*result.ptr == ',');
+        REQUIRE(value == vector3<T>(1, 2, 35));
+    }
+
+    SECTION("a value that fails to read is unchanged, and ptr is at the failing component")
+    {
+        const vector3<T> original(7, 8, 9);
+
+        for (const std::string input : {"1 2 x", "1 2", "1 +2 3", "", "1 0x10 3", "1-2-3", "1.5.5 0", "1 2-3"}) {
+            auto value = original;
+
+            const auto result = from_chars(input.data(), input.data() + input.size(), value);
+
+            REQUIRE(result.ec == std::errc::invalid_argument);
+            REQUIRE(value == original);
+        }
+
+        const std::string input = "1 2 x";
+        auto value = original;
+
+        REQUIRE(from_chars(input.data(), input.data() + input.size(), value).ptr == input.data() + 4);
+
+        // components must be separated, so ptr is where the separator should have been
+        const std::string unseparated = "1.5.5 0";
+        REQUIRE(from_chars(unseparated.data(), unseparated.data() + unseparated.size(), value).ptr
+            == unseparated.data() + 3);
+
+        const std::string huge = "1 1e99999 3";
+        REQUIRE(from_chars(huge.data(), huge.data() + huge.size(), value).ec == std::errc::result_out_of_range);
+        REQUIRE(value == original);
+    }
+
+    SECTION("a buffer too small is value_too_large")
+    {
+        const vector3<T> value(T(0.1), T(0.2), T(0.3));
+        const auto written = text(value);
+
+        for (std::size_t size = 0; size < written.size(); ++size) {
+            std::vector<char> buffer(size + 1);
+
+            const auto result = to_chars(buffer.data(), buffer.data() + size, value);
+
+            REQUIRE(result.ec == std::errc::value_too_large);
+            REQUIRE(result.ptr == buffer.data() + size);
+        }
+
+        std::vector<char> buffer(written.size());
+
+        REQUIRE(to_chars(buffer.data(), buffer.data() + buffer.size(), value).ec == std::errc());
+    }
+}
+
+TEST_CASE("charconv: integer components", "[charconv]")
+{
+    const vector3<int> value(-1, 0, 2147483647);
+    const auto written = text(value);
+
+    REQUIRE(written == "-1 0 2147483647");
+
+    vector3<int> read;
+    REQUIRE(from_chars(written.data(), written.data() + written.size(), read).ec == std::errc());
+    REQUIRE(read == value);
+
+    const std::string fraction = "1 2.5 3";
+    REQUIRE(from_chars(fraction.data(), fraction.data() + fraction.size(), read).ec == std::errc::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("charconv: batches", "[charconv]", float, double)
+{
+    using T = TestType;
+
+    SECTION("a buffer of whitespace separated components fills a span of vector3")
+    {
+        const std::string input = "0 1 2\n3 4 5\r\n6 7\n8   9 10 11\n\n";
+
+        std::vector<vector3<T>> out(10, vector3<T>(-1));
+        const auto result = from_chars(input.data(), input.data() + input.size(),
+            strided_span<vector3<T>>(out.data(), out.size()));
+
+        REQUIRE(result.ec == std::errc());
+        REQUIRE(result.count == 4);
+        REQUIRE(result.ptr == input.data() + input.size() - 2);
+
+        for (std::size_t i = 0; i < 4; ++i) REQUIRE(out[i] == vector3<T>(T(i * 3), T(i * 3 + 1), T(i * 3 + 2)));
+
+        REQUIRE(out[4] == vector3<T>(-1));
+    }
+
+    SECTION("reading stops when the span is full")
+    {
+        const std::string input = "1 1 1 2 2 2 3 3 3";
+
+        std::vector<vector3<T>> out(2);
+        const auto result = from_chars(input.data(), input.data() + input.size(),
+            strided_span<vector3<T>>(out.data(), out.size()));
+
+        REQUIRE(result.ec == std::errc());
+        REQUIRE(result.count == 2);
+        REQUIRE(std::string(result.ptr) == " 3 3 3");
+    }
+
+    SECTION("a malformed value stops the batch, those before it read")
+    {
+        const std::string input = "1 2 3\n4 5 6\n7 oops 9\n10 11 12";
+
+        std::vector<vector3<T>> out(4, vector3<T>(-1));
+        const auto result = from_chars(input.data(), input.data() + input.size(),
+            strided_span<vector3<T>>(out.data(), out.size()));
+
+        REQUIRE(result.ec == std::errc::invalid_argument);
+        REQUIRE(result.count == 2);
+        REQUIRE(std::string(result.ptr, 4) == "oops");
+        REQUIRE(out[1] == vector3<T>(4, 5, 6));
+        REQUIRE(out[2] == vector3<T>(-1));
+    }
+
+    SECTION("a value that runs into the next character stops the batch, and is not stored")
+    {
+        for (const std::string input : {"1 2 3\n4 5 6x7 8 9", "1 2 3\n4 5 6,7 8 9", "1 2 3\n4 5 6-7 8 9"}) {
+            std::vector<vector3<T>> out(3, vector3<T>(-1));
+            const auto result = from_chars(input.data(), input.data() + input.size(),
+                strided_span<vector3<T>>(out.data(), out.size()));
+
+            REQUIRE(result.ec == std::errc::invalid_argument);
+            REQUIRE(result.count == 1);
+            REQUIRE(result.ptr == input.data() + 11);
+            REQUIRE(out[0] == vector3<T>(1, 2, 3));
+            REQUIRE(out[1] == vector3<T>(-1));
+        }
+    }
+
+    SECTION("positions written from an interleaved vertex buffer read back into one")
+    {
+        struct vertex final {
+            vector3<T> position;
+            vector2<T> uv;
+        };
+
+        const auto components = awkward_values<T>(3000);
+
+        std::vector<vertex> vertices(1000);
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+            vertices[i] = {vector3<T>(components[i * 3], components[i * 3 + 1], components[i * 3 + 2]),
+                vector2<T>(T(i), 0)};
+
+        std::vector<char> buffer(vertices.size() * 128);
+
+        const auto written = to_chars(buffer.data(), buffer.data() + buffer.size(), strided_span<const vector3<T>>(
+            &vertices.front().position, vertices.size(), sizeof(vertex)));
+
+        REQUIRE(written.ec == std::errc());
+        REQUIRE(*(written.ptr - 1) == '\n');
+
+        std::vector<vertex> reread(vertices.size());
+        const auto read = from_chars(buffer.data(), written.ptr, strided_span<vector3<T>>(
+            &reread.front().position, reread.size(), sizeof(vertex)));
+
+        REQUIRE(read.ec == std::errc());
+        REQUIRE(read.count == vertices.size());
+        REQUIRE(read.ptr == written.ptr - 1);
+
+        for (std::size_t i = 0; i < vertices.size(); ++i) {
+            REQUIRE(same_bits(reread[i].position.x, vertices[i].position.x));
+            REQUIRE(same_bits(reread[i].position.y, vertices[i].position.y));
+            REQUIRE(same_bits(reread[i].position.z, vertices[i].position.z));
+        }
+
+        const auto tooSmall = to_chars(buffer.data(), buffer.data() + 10, strided_span<const vector3<T>>(
+            &vertices.front().position, vertices.size(), sizeof(vertex)));
+
+        REQUIRE(tooSmall.ec == std::errc::value_too_large);
+    }
+}
@@ -0,0 +1,239 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/closest_point.h>
+
+#include "random_source.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    template<typename T>
+    vector3<T> random_vector(random_source &aRandom, const float aScale) {
+        const auto x = aRandom.next() * aScale, y = aRandom.next() * aScale, z = aRandom.next() * aScale;
+
+        return {x, y, z};
+    }
+
+    //! vectors held apart by component, as the batch forms want them
+    template<typename T>
+    struct soa_buffer final {
+        std::vector<T> x, y, z;
+
+        void push_back(const vector3<T> &aValue) {
+            x.push_back(aValue.x);
+            y.push_back(aValue.y);
+            z.push_back(aValue.z);
+        }
+
+        vector3_soa<const T> view() const { return {x.data(), y.data(), z.data()}; }
+
+        vector3_soa<T> view() { return {x.data(), y.data(), z.data()}; }
+
+        vector3<T> operator[](const std::size_t i) const { return {x[i], y[i], z[i]}; }
+    };
+
+    constexpr int SAMPLES = 64;
+}
+
+TEMPLATE_LIST_TEST_CASE("closest point queries", "[closest_point]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+
+    SECTION("closest_point_on_segment clamps to the ends and projects in between")
+    {
+        const vec a(0, 0, 0), b(10, 0, 0);
+
+        REQUIRE(closest_point_on_segment(vec(-5, 3, 0), a, b) == a);
+        REQUIRE(closest_point_on_segment(vec(15, 3, 0), a, b) == b);
+        REQUIRE(closest_point_on_segment(vec(4, 3, -2), a, b) == vec(4, 0, 0));
+        REQUIRE(closest_point_on_segment(vec(4, 3, -2), a, a) == a);
+    }
+
+    SECTION("closest_point_on_triangle finds each vertex, edge and face region")
+    {
+        const vec a(0, 0, 0), b(4, 0, 0), c(0, 4, 0);
+
+        REQUIRE(closest_point_on_triangle(vec(-1, -1, 3), a, b, c) == a);
+        REQUIRE(closest_point_on_triangle(vec(6, -1, 0), a, b, c) == b);
+        REQUIRE(closest_point_on_triangle(vec(-1, 6, 0), a, b, c) == c);
+        REQUIRE(closest_point_on_triangle(vec(2, -3, 1), a, b, c) == vec(2, 0, 0));
+        REQUIRE(closest_point_on_triangle(vec(-3, 2, 1), a, b, c) == vec(0, 2, 0));
+        REQUIRE(closest_point_on_triangle(vec(3, 3, 0), a, b, c) == vec(2, 2, 0));
+        REQUIRE(closest_point_on_triangle(vec(1, 1, 5), a, b, c) == vec(1, 1, 0));
+
+        // degenerate: a segment and a point
+        REQUIRE(closest_point_on_triangle(vec(2, 3, 0), a, b, b) == vec(2, 0, 0));
+        REQUIRE(closest_point_on_triangle(vec(2, 3, 0), a, a, a) == a);
+    }
+
+    SECTION("closest_point_on_aabb clamps to the box")
+    {
+        const aabb<TestType> box(vec(-1, -1, -1), vec(1, 2, 3));
+
+        REQUIRE(closest_point_on_aabb(vec(0, 0, 0), box) == vec(0, 0, 0));
+        REQUIRE(closest_point_on_aabb(vec(5, -5, 1), box) == vec(1, -1, 1));
+    }
+
+    SECTION("closest_points_between_segments handles crossing, parallel and degenerate segments")
+    {
+        const auto crossing = closest_points_between_segments(vec(-1, 0, 0), vec(1, 0, 0), vec(0, -1, 2), vec(0, 1, 2));
+
+        REQUIRE(crossing.first == vec(0, 0, 0));
+        REQUIRE(crossing.second == vec(0, 0, 2));
+        REQUIRE(crossing.s == Approx(0.5));
+        REQUIRE(crossing.t == Approx(0.5));
+        REQUIRE(crossing.distance_squared() == Approx(4));
+
+        const auto parallel = closest_points_between_segments(vec(0, 0, 0), vec(4, 0, 0), vec(1, 3, 0), vec(6, 3, 0));
+
+        REQUIRE(parallel.distance_squared() == Approx(9));
+
+        const auto points = closest_points_between_segments(vec(1, 1, 1), vec(1, 1, 1), vec(1, 1, 3), vec(1, 1, 3));
+
+        REQUIRE(points.distance_squared() == Approx(4));
+
+        const auto pointToSegment = closest_points_between_segments(vec(2, 5, 0), vec(2, 5, 0), vec(0, 0, 0),
+            vec(4, 0, 0));
+
+        REQUIRE(pointToSegment.second == vec(2, 0, 0));
+    }
+
+    SECTION("no sampled point beats the closest point")
+    {
+        random_source random{1};
+
+        // how much nearer a sample may be, to allow for rounding
+        const auto tolerance = static_cast<TestType>(1e-3);
+
+        std::size_t beaten = 0;
+
+        for (int trial = 0; trial < 50; ++trial) {
+            const auto p = random_vector<TestType>(random, 5);
+            const auto a = random_vector<TestType>(random, 5), b = random_vector<TestType>(random, 5);
+            const auto c = random_vector<TestType>(random, 5), d = random_vector<TestType>(random, 5);
+
+            const auto onSegment = (closest_point_on_segment(p, a, b) - p).length_squared();
+            const auto onTriangle = (closest_point_on_triangle(p, a, b, c) - p).length_squared();
+            const auto between = closest_points_between_segments(a, b, c, d).distance_squared();
+
+            for (int i = 0; i <= SAMPLES; ++i) {
+                const auto s = static_cast<TestType>(i) / SAMPLES;
+
+                if ((lerp(a, b, s) - p).length_squared() < onSegment - tolerance) ++beaten;
+
+                for (int j = 0; j <= SAMPLES; ++j) {
+                    const auto t = static_cast<TestType>(j) / SAMPLES;
+
+                    if ((lerp(c, d, t) - lerp(a, b, s)).length_squared() < between - tolerance) ++beaten;
+
+                    if (i + j <= SAMPLES && (a + (b - a) * s + (c - a) * t - p).length_squared() < onTriangle - tolerance)
+                        ++beaten;
+                }
+            }
+        }
+
+        REQUIRE(beaten == 0);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("closest point batch queries", "[closest_point]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+
+    random_source random{2};
+
+    constexpr std::size_t COUNT = 200;
+
+    const auto p = random_vector<TestType>(random, 5);
+
+    soa_buffer<TestType> a, b, c, closest;
+    std::vector<TestType> distances(COUNT);
+
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        a.push_back(random_vector<TestType>(random, 10));
+        b.push_back(random_vector<TestType>(random, 10));
+        c.push_back(random_vector<TestType>(random, 10));
+        closest.push_back(vec::zero);
+    }
+
+    // a degenerate segment, triangle and box
+    b.x[7] = a.x[7]; b.y[7] = a.y[7]; b.z[7] = a.z[7];
+    c.x[7] = a.x[7]; c.y[7] = a.y[7]; c.z[7] = a.z[7];
+
+    const auto check = [&](const std::size_t aNearest, auto aScalar) {
+        std::size_t disagreements = 0, expectedNearest = 0;
+
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            const vec expected = aScalar(i);
+
+            if ((closest[i] - expected).length() > static_cast<TestType>(1e-4)) ++disagreements;
+            if (distances[i] != Approx((expected - p).length_squared()).margin(1e-4)) ++disagreements;
+            if (distances[i] < distances[expectedNearest]) expectedNearest = i;
+        }
+
+        REQUIRE(disagreements == 0);
+        REQUIRE(aNearest == expectedNearest);
+    };
+
+    SECTION("segments")
+    {
+        const auto nearest = closest_points_on_segments(p, a.view(), b.view(), COUNT, closest.view(), distances.data());
+
+        check(nearest, [&](const std::size_t i) { return closest_point_on_segment(p, a[i], b[i]); });
+    }
+
+    SECTION("triangles")
+    {
+        const auto nearest = closest_points_on_triangles(p, a.view(), b.view(), c.view(), COUNT, closest.view(),
+            distances.data());
+
+        check(nearest, [&](const std::size_t i) { return closest_point_on_triangle(p, a[i], b[i], c[i]); });
+    }
+
+    SECTION("aabbs")
+    {
+        soa_buffer<TestType> mins, maxes;
+
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            mins.push_back(vec::min(a[i], b[i]));
+            maxes.push_back(vec::max(a[i], b[i]));
+        }
+
+        const auto nearest = closest_points_on_aabbs(p, mins.view(), maxes.view(), COUNT, closest.view(),
+            distances.data());
+
+        check(nearest, [&](const std::size_t i) {
+            return closest_point_on_aabb(p, aabb<TestType>(mins[i], maxes[i]));
+        });
+    }
+
+    SECTION("segment against segments")
+    {
+        const auto q = random_vector<TestType>(random, 5);
+
+        const auto nearest = distances_squared_between_segments(p, q, a.view(), b.view(), COUNT, distances.data());
+
+        std::size_t disagreements = 0, expectedNearest = 0;
+
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            if (distances[i] != closest_points_between_segments(p, q, a[i], b[i]).distance_squared()) ++disagreements;
+            if (distances[i] < distances[expectedNearest]) expectedNearest = i;
+        }
+
+        REQUIRE(disagreements == 0);
+        REQUIRE(nearest == expectedNearest);
+    }
+
+    SECTION("an empty batch reports no nearest")
+    {
+        REQUIRE(closest_points_on_segments(p, a.view(), b.view(), 0, closest.view(), distances.data()) == 0);
+    }
+}
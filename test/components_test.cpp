@@ -0,0 +1,58 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/math.h>
+
+#include <array>
+#include <cstddef>
+
+using namespace gdk;
+
+TEMPLATE_LIST_TEST_CASE("components: every type round trips through its component array", "[components]",
+    type::floating_point)
+{
+    using T = TestType;
+
+    SECTION("vectors and quaternions list x, y, z, w")
+    {
+        REQUIRE(to_components(vector2<T>(1, 2)) == std::array<T, 2>{1, 2});
+        REQUIRE(to_components(vector3<T>(1, 2, 3)) == std::array<T, 3>{1, 2, 3});
+        REQUIRE(to_components(vector4<T>(1, 2, 3, 4)) == std::array<T, 4>{1, 2, 3, 4});
+        REQUIRE(to_components(quaternion<T>(1, 2, 3, 4)) == std::array<T, 4>{1, 2, 3, 4});
+
+        REQUIRE(from_components<vector3<T>>({1, 2, 3}) == vector3<T>(1, 2, 3));
+        REQUIRE(from_components<quaternion<T>>({1, 2, 3, 4}) == quaternion<T>(1, 2, 3, 4));
+    }
+
+    SECTION("matrices list column by column")
+    {
+        matrix4x4<T> m;
+        m.set_translation({5, 6, 7});
+
+        const auto components = to_components(m);
+
+        REQUIRE(components.size() == 16);
+        REQUIRE(components[12] == 5);
+        REQUIRE(components[13] == 6);
+        REQUIRE(components[14] == 7);
+        REQUIRE(components[15] == 1);
+
+        REQUIRE(from_components<matrix4x4<T>>(components) == m);
+
+        matrix3x3<T> n;
+        n.set(1, 2, 9);
+
+        REQUIRE(to_components(n)[1 * 3 + 2] == 9);
+        REQUIRE(from_components<matrix3x3<T>>(to_components(n)) == n);
+    }
+
+    SECTION("usable in constant expressions")
+    {
+        constexpr auto components = to_components(vector3<T>(1, 2, 3));
+        constexpr auto v = from_components<vector3<T>>(components);
+
+        STATIC_REQUIRE(v.z == 3);
+    }
+}
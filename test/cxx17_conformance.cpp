@@ -2,7 +2,19 @@
 
 #include <gdk/math.h>
 
+// the headers bring in no platform headers, so names those declare are still free for the user
+int read, write, open, close, stat;
+
+// nor the macros the implementations use internally
+#if defined(GDK_MATH_DETAIL_RESTRICT) || defined(GDK_MATH_DETAIL_F16C) || defined(GDK_MATH_DETAIL_SSE2)
+#error a GDK_MATH_DETAIL_ macro leaked out of the headers
+#endif
+
 namespace gdk {
+    template class aabb<float>;
+    template class aabb<double>;
+    template class aabb<long double>;
+
     template class vector2<float>;
     template class vector2<double>;
     template class vector2<long double>;
@@ -26,6 +38,18 @@ namespace gdk {
     template class matrix4x4<float>;
     template class matrix4x4<double>;
     template class matrix4x4<long double>;
+
+    template class obb<float>;
+    template class obb<double>;
+    template class obb<long double>;
+
+    template struct segment_closest_points<float>;
+    template struct segment_closest_points<double>;
+    template struct segment_closest_points<long double>;
+
+    template class sphere<float>;
+    template class sphere<double>;
+    template class sphere<long double>;
 }
 
 namespace {
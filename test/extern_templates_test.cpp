@@ -0,0 +1,47 @@
+// © Joseph Cameron - All Rights Reserved
+
+// this translation unit declares the float and double instantiations extern, and so compiles none of
+// their non-inline members; instantiation_test.cpp defines them, as gdkmath_templates would, so
+// linking the two together is itself part of the test
+#define GDK_MATH_EXTERN_TEMPLATES
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/math.h>
+
+TEMPLATE_LIST_TEST_CASE("extern templates: the types work as they do when instantiated here", "[extern_templates]",
+    type::floating_point)
+{
+    using T = TestType;
+
+    SECTION("members that are not constexpr link to the one instantiation")
+    {
+        const gdk::vector3<T> v(3, 0, 4);
+
+        REQUIRE(v.length() == Approx(5));
+        REQUIRE(v.normal().length() == Approx(1));
+
+        const auto q = gdk::quaternion<T>::from_angle_axis(T(0.5), gdk::vector3<T>::up);
+
+        REQUIRE(q.angle() == Approx(0.5));
+
+        gdk::matrix4x4<T> m;
+        m.set_rotation(q);
+
+        REQUIRE(m.rotation().dot_product(q) == Approx(1));
+    }
+
+    SECTION("static members are shared with the instantiation")
+    {
+        REQUIRE(gdk::vector3<T>::up == gdk::vector3<T>(0, 1, 0));
+        REQUIRE(gdk::quaternion<T>::identity == gdk::quaternion<T>(0, 0, 0, 1));
+    }
+
+    SECTION("constexpr members are still usable in constant expressions")
+    {
+        constexpr gdk::vector3<T> a(1, 2, 3), b(4, 5, 6);
+
+        STATIC_REQUIRE(a.dot_product(b) == T(32));
+    }
+}
@@ -0,0 +1,194 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+
+#include <gdk/gpu_layout.h>
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! a destination with room to start it on a 16 byte boundary or off one
+    template<typename T>
+    struct destination final {
+        std::vector<padded_vector3<T>> storage;
+
+        explicit destination(const std::size_t aBytes)
+        : storage(aBytes / sizeof(padded_vector3<T>) + 2) {
+            std::memset(storage.data(), 0xff, storage.size() * sizeof(padded_vector3<T>));
+        }
+
+        //! aligned, or offset by one component, which is as far off as a buffer of T can be
+        unsigned char *at(const bool aAligned) {
+            return reinterpret_cast<unsigned char *>(storage.data()) + (aAligned ? 0 : sizeof(T));
+        }
+    };
+
+    template<typename T>
+    T component(const unsigned char *const aBuffer, const std::size_t aIndex) {
+        T value;
+        std::memcpy(&value, aBuffer + aIndex * sizeof(T), sizeof(T));
+
+        return value;
+    }
+}
+
+TEMPLATE_TEST_CASE("gpu_layout: strides and padded types", "[gpu_layout]", float, double)
+{
+    using T = TestType;
+
+    REQUIRE(sizeof(padded_vector3<T>) == 4 * sizeof(T));
+    REQUIRE(sizeof(padded_matrix3x3<T>) == 12 * sizeof(T));
+    REQUIRE(sizeof(std140_vector2<T>) == 16);
+
+    REQUIRE(array_stride<vector2<T>>(buffer_layout::std140) == 16);
+    REQUIRE(array_stride<vector2<T>>(buffer_layout::std430) == 2 * sizeof(T));
+    REQUIRE(array_stride<vector3<T>>(buffer_layout::std140) == sizeof(padded_vector3<T>));
+    REQUIRE(array_stride<vector3<T>>(buffer_layout::std430) == sizeof(padded_vector3<T>));
+    REQUIRE(array_stride<vector4<T>>(buffer_layout::std430) == 4 * sizeof(T));
+    REQUIRE(array_stride<matrix3x3<T>>(buffer_layout::std140) == sizeof(padded_matrix3x3<T>));
+    REQUIRE(array_stride<matrix4x4<T>>(buffer_layout::std430) == 16 * sizeof(T));
+}
+
+TEMPLATE_TEST_CASE("gpu_layout: packing", "[gpu_layout]", float, double)
+{
+    using T = TestType;
+
+    constexpr std::size_t COUNT = 37;
+
+    const buffer_layout layouts[] = {buffer_layout::std140, buffer_layout::std430};
+
+    SECTION("vector3s are padded to four components, the padding zeroed")
+    {
+        for (const bool aligned : {true, false}) for (const auto layout : layouts) {
+            std::vector<vector3<T>> values;
+            for (std::size_t i = 0; i < COUNT; ++i) values.emplace_back(T(i), T(i) + T(0.5), -T(i));
+
+            destination<T> buffer(COUNT * array_stride<vector3<T>>(layout) + 64);
+            pack_buffer(values.data(), values.size(), layout, buffer.at(aligned));
+
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                REQUIRE(component<T>(buffer.at(aligned), i * 4 + 0) == values[i].x);
+                REQUIRE(component<T>(buffer.at(aligned), i * 4 + 1) == values[i].y);
+                REQUIRE(component<T>(buffer.at(aligned), i * 4 + 2) == values[i].z);
+                REQUIRE(component<T>(buffer.at(aligned), i * 4 + 3) == 0);
+            }
+
+            // nothing past the end is touched
+            REQUIRE(buffer.at(aligned)[COUNT * 4 * sizeof(T)] == 0xff);
+        }
+    }
+
+    SECTION("vector2s are packed in std430 and padded in std140, an odd count included")
+    {
+        for (const bool aligned : {true, false}) for (const auto layout : layouts) {
+            std::vector<vector2<T>> values;
+            for (std::size_t i = 0; i < COUNT; ++i) values.emplace_back(T(i), -T(i));
+
+            const auto stride = array_stride<vector2<T>>(layout) / sizeof(T);
+
+            destination<T> buffer(COUNT * stride * sizeof(T) + 64);
+            pack_buffer(values.data(), values.size(), layout, buffer.at(aligned));
+
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                REQUIRE(component<T>(buffer.at(aligned), i * stride + 0) == values[i].x);
+                REQUIRE(component<T>(buffer.at(aligned), i * stride + 1) == values[i].y);
+
+                for (std::size_t padding = 2; padding < stride; ++padding)
+                    REQUIRE(component<T>(buffer.at(aligned), i * stride + padding) == 0);
+            }
+
+            REQUIRE(buffer.at(aligned)[COUNT * stride * sizeof(T)] == 0xff);
+        }
+    }
+
+    SECTION("vector4s and matrix4x4s are copied as they are")
+    {
+        for (const bool aligned : {true, false}) for (const auto layout : layouts) {
+            std::vector<vector4<T>> vectors;
+            std::vector<matrix4x4<T>> matrices;
+
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                const auto s = static_cast<T>(i);
+
+                vectors.emplace_back(s, s + 1, s + 2, s + 3);
+                matrices.emplace_back(vector3<T>(s, 1, 2), quaternion<T>::from_angle_axis(s, vector3<T>(0, 1, 0)),
+                    vector3<T>(s + 1));
+            }
+
+            destination<T> vectorBuffer(COUNT * sizeof(vector4<T>) + 64);
+            destination<T> matrixBuffer(COUNT * sizeof(matrix4x4<T>) + 64);
+
+            pack_buffer(vectors.data(), vectors.size(), layout, vectorBuffer.at(aligned));
+            pack_buffer(matrices.data(), matrices.size(), layout, matrixBuffer.at(aligned));
+
+            REQUIRE(std::memcmp(vectorBuffer.at(aligned), vectors.data(), COUNT * sizeof(vector4<T>)) == 0);
+            REQUIRE(std::memcmp(matrixBuffer.at(aligned), matrices.data(), COUNT * sizeof(matrix4x4<T>)) == 0);
+        }
+    }
+
+    SECTION("matrix3x3 columns are padded, and read back as padded_matrix3x3")
+    {
+        for (const bool aligned : {true, false}) for (const auto layout : layouts) {
+            std::vector<matrix3x3<T>> values(COUNT);
+
+            for (std::size_t i = 0; i < COUNT; ++i) for (std::size_t column = 0; column < 3; ++column)
+                for (std::size_t row = 0; row < 3; ++row) values[i].set(column, row, T(i * 9 + column * 3 + row));
+
+            std::vector<padded_matrix3x3<T>> padded(COUNT);
+
+            pack_buffer(values.data(), values.size(), layout, padded.data());
+
+            for (std::size_t i = 0; i < COUNT; ++i) for (std::size_t column = 0; column < 3; ++column) {
+                REQUIRE(padded[i].columns[column].x == values[i].get(column, 0));
+                REQUIRE(padded[i].columns[column].y == values[i].get(column, 1));
+                REQUIRE(padded[i].columns[column].z == values[i].get(column, 2));
+                REQUIRE(padded[i].columns[column].padding == 0);
+            }
+
+            destination<T> buffer(COUNT * sizeof(padded_matrix3x3<T>) + 64);
+            pack_buffer(values.data(), values.size(), layout, buffer.at(aligned));
+
+            REQUIRE(std::memcmp(buffer.at(aligned), padded.data(), COUNT * sizeof(padded_matrix3x3<T>)) == 0);
+        }
+    }
+
+    SECTION("a strided view packs as its copy does")
+    {
+        for (const auto layout : layouts) {
+            struct vertex final {
+                vector3<T> position;
+                vector2<T> uv;
+            };
+
+            std::vector<vertex> vertices(COUNT);
+            std::vector<vector3<T>> positions;
+            std::vector<vector2<T>> uvs;
+
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                vertices[i] = {vector3<T>(T(i), 2, 3), vector2<T>(T(i), 5)};
+                positions.push_back(vertices[i].position);
+                uvs.push_back(vertices[i].uv);
+            }
+
+            const strided_span<const vector3<T>> positionView(&vertices.front().position, COUNT, sizeof(vertex));
+            const strided_span<const vector2<T>> uvView(&vertices.front().uv, COUNT, sizeof(vertex));
+
+            std::vector<padded_vector3<T>> fromView(COUNT), fromCopy(COUNT);
+            pack_buffer(positionView, layout, fromView.data());
+            pack_buffer(positions.data(), positions.size(), layout, fromCopy.data());
+
+            REQUIRE(std::memcmp(fromView.data(), fromCopy.data(), COUNT * sizeof(padded_vector3<T>)) == 0);
+
+            std::vector<std140_vector2<T>> uvsFromView(COUNT), uvsFromCopy(COUNT);
+            pack_buffer(uvView, layout, uvsFromView.data());
+            pack_buffer(uvs.data(), uvs.size(), layout, uvsFromCopy.data());
+
+            REQUIRE(std::memcmp(uvsFromView.data(), uvsFromCopy.data(), COUNT * array_stride<vector2<T>>(layout)) == 0);
+        }
+    }
+}
@@ -0,0 +1,181 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/half.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace gdk;
+
+TEST_CASE("half: conversion from float", "[half]")
+{
+    SECTION("exactly representable values convert exactly")
+    {
+        REQUIRE(to_half(1.0f).bits == 0x3c00);
+        REQUIRE(to_half(-2.0f).bits == 0xc000);
+        REQUIRE(to_half(0.5f).bits == 0x3800);
+        REQUIRE(to_half(0.0f).bits == 0x0000);
+        REQUIRE(to_half(-0.0f).bits == 0x8000);
+        REQUIRE(to_half(65504.0f).bits == 0x7bff);
+        REQUIRE(to_half(std::ldexp(1.0f, -14)).bits == 0x0400);
+        REQUIRE(to_half(std::ldexp(1.0f, -24)).bits == 0x0001);
+    }
+
+    SECTION("rounds to nearest, ties to even")
+    {
+        REQUIRE(to_half(1.0f + std::ldexp(1.0f, -11)).bits == 0x3c00);
+        REQUIRE(to_half(1.0f + 3 * std::ldexp(1.0f, -11)).bits == 0x3c02);
+        REQUIRE(to_half(1.0f + std::ldexp(1.2f, -11)).bits == 0x3c01);
+        REQUIRE(to_half(std::ldexp(1.0f, -25)).bits == 0x0000);
+        REQUIRE(to_half(3 * std::ldexp(1.0f, -25)).bits == 0x0002);
+        REQUIRE(to_half(65519.0f).bits == 0x7bff);
+    }
+
+    SECTION("beyond the range is infinity, and NaN stays NaN")
+    {
+        REQUIRE(to_half(65520.0f).bits == 0x7c00);
+        REQUIRE(to_half(1e10f).bits == 0x7c00);
+        REQUIRE(to_half(-std::numeric_limits<float>::infinity()).bits == 0xfc00);
+        REQUIRE(std::isnan(from_half(to_half(std::numeric_limits<float>::quiet_NaN()))));
+    }
+}
+
+TEST_CASE("half: conversion to float", "[half]")
+{
+    SECTION("every half but NaN converts to a float that converts back to it")
+    {
+        for (std::uint32_t bits = 0; bits <= 0xffff; ++bits) {
+            const half h{static_cast<std::uint16_t>(bits)};
+            const auto f = from_half(h);
+
+            if ((bits & 0x7c00) == 0x7c00 && (bits & 0x3ff)) REQUIRE(std::isnan(f));
+            else REQUIRE(to_half(f) == h);
+        }
+    }
+
+    SECTION("subnormals, infinities and signs")
+    {
+        REQUIRE(from_half(half{0x0001}) == std::ldexp(1.0f, -24));
+        REQUIRE(from_half(half{0x83ff}) == -std::ldexp(1023.0f, -24));
+        REQUIRE(from_half(half{0x7c00}) == std::numeric_limits<float>::infinity());
+        REQUIRE(std::signbit(from_half(half{0x8000})));
+    }
+
+    SECTION("NaN keeps its payload and comes back quiet, signaling or not, as F16C converts it")
+    {
+        std::vector<half> nans;
+        for (std::uint16_t mantissa = 1; mantissa <= 0x3ff; ++mantissa) {
+            nans.push_back(half{static_cast<std::uint16_t>(0x7c00 | mantissa)});
+            nans.push_back(half{static_cast<std::uint16_t>(0xfc00 | mantissa)});
+        }
+
+        std::vector<float> batch(nans.size());
+        from_half(nans.data(), nans.size(), batch.data());
+
+        for (std::size_t i = 0; i < nans.size(); ++i) {
+            const auto expected = (std::uint32_t(nans[i].bits & 0x8000) << 16) | 0x7fc00000u
+                | (std::uint32_t(nans[i].bits & 0x3ff) << 13);
+
+            const auto scalar = from_half(nans[i]);
+            std::uint32_t scalarBits, batchBits;
+            std::memcpy(&scalarBits, &scalar, sizeof scalar);
+            std::memcpy(&batchBits, &batch[i], sizeof batchBits);
+
+            REQUIRE(scalarBits == expected);
+            REQUIRE(batchBits == expected);
+        }
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("half: vectors and quaternions", "[half]", type::floating_point)
+{
+    using T = TestType;
+
+    // 11 significant bits: within 2^-11 of the value, relative
+    const auto within = [](const T aHalf, const T aValue) {
+        return std::abs(aHalf - aValue) <= std::abs(aValue) * std::ldexp(T(1), -11);
+    };
+
+    const vector2<T> v2(T(0.1), T(-3000.7));
+    const vector3<T> v3(T(1.3), T(-0.002), T(42.42));
+    const vector4<T> v4(T(-7.25), T(0.333), T(1e-3), T(100));
+    const auto q = quaternion<T>(T(0.1), T(0.7), T(-0.2), T(0.5)).normalized();
+
+    const auto r2 = from_half<T>(to_half(v2));
+    const auto r3 = from_half<T>(to_half(v3));
+    const auto r4 = from_half<T>(to_half(v4));
+    const auto rq = from_half<T>(to_half(q));
+
+    STATIC_REQUIRE(sizeof(half_vector3) == 6);
+    STATIC_REQUIRE(sizeof(half_quaternion) == 8);
+
+    REQUIRE((within(r2.x, v2.x) && within(r2.y, v2.y)));
+    REQUIRE((within(r3.x, v3.x) && within(r3.y, v3.y) && within(r3.z, v3.z)));
+    REQUIRE((within(r4.x, v4.x) && within(r4.y, v4.y) && within(r4.z, v4.z) && within(r4.w, v4.w)));
+    REQUIRE((within(rq.x, q.x) && within(rq.y, q.y) && within(rq.z, q.z) && within(rq.w, q.w)));
+}
+
+TEST_CASE("half: the batch forms", "[half]")
+{
+    // not a multiple of 8, so any vector body has a tail
+    std::vector<float> values;
+
+    for (int i = 0; i < 37; ++i) values.push_back(std::ldexp(static_cast<float>(i * 7 - 100), i % 9 - 6));
+
+    const auto count = values.size();
+
+    SECTION("floats agree with the scalar forms")
+    {
+        std::vector<half> halves(count);
+        std::vector<float> floats(count);
+
+        to_half(values.data(), count, halves.data());
+        from_half(halves.data(), count, floats.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(halves[i] == to_half(values[i]));
+            REQUIRE(floats[i] == from_half(halves[i]));
+        }
+    }
+
+    SECTION("vectors and quaternions agree with the scalar forms")
+    {
+        std::vector<vector3<float>> vectors;
+        std::vector<quaternion<float>> rotations;
+
+        for (std::size_t i = 0; i + 3 < count; ++i) {
+            vectors.emplace_back(values[i], values[i + 1], values[i + 2]);
+            rotations.emplace_back(values[i], values[i + 1], values[i + 2], values[i + 3]);
+        }
+
+        std::vector<half_vector3> halfVectors(vectors.size());
+        std::vector<half_quaternion> halfRotations(rotations.size());
+        std::vector<vector3<float>> outVectors(vectors.size());
+        std::vector<quaternion<float>> outRotations(rotations.size());
+
+        to_half(vectors.data(), vectors.size(), halfVectors.data());
+        to_half(rotations.data(), rotations.size(), halfRotations.data());
+        from_half(halfVectors.data(), halfVectors.size(), outVectors.data());
+        from_half(halfRotations.data(), halfRotations.size(), outRotations.data());
+
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            REQUIRE(outVectors[i] == from_half(to_half(vectors[i])));
+            REQUIRE(outRotations[i] == from_half(to_half(rotations[i])));
+        }
+    }
+
+    SECTION("a count of zero writes nothing")
+    {
+        half untouched{0x1234};
+
+        to_half(values.data(), 0, &untouched);
+
+        REQUIRE(untouched.bits == 0x1234);
+    }
+}
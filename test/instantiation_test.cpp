@@ -8,6 +8,10 @@
 #include <type_traits>
 
 namespace gdk {
+    template class aabb<float>;
+    template class aabb<double>;
+    template class aabb<long double>;
+
     template class vector2<float>;
     template class vector2<double>;
     template class vector2<long double>;
@@ -31,6 +35,18 @@ namespace gdk {
     template class matrix4x4<float>;
     template class matrix4x4<double>;
     template class matrix4x4<long double>;
+
+    template class obb<float>;
+    template class obb<double>;
+    template class obb<long double>;
+
+    template struct segment_closest_points<float>;
+    template struct segment_closest_points<double>;
+    template struct segment_closest_points<long double>;
+
+    template class sphere<float>;
+    template class sphere<double>;
+    template class sphere<long double>;
 }
 
 using namespace gdk;
@@ -0,0 +1,216 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/obb.h>
+
+#include "random_source.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    template<typename T>
+    obb<T> random_box(random_source &aRandom, const float aSpread) {
+        const auto rotation = quaternion<T>::from_euler({aRandom.next() * 3, aRandom.next() * 3, aRandom.next() * 3});
+
+        const matrix4x4<T> transform(
+            vector3<T>(aRandom.next() * aSpread, aRandom.next() * aSpread, aRandom.next() * aSpread), rotation,
+            vector3<T>(1.5f + aRandom.next(), 1.5f + aRandom.next(), 1.5f + aRandom.next()));
+
+        return obb<T>::from_transform(transform, aabb<T>(vector3<T>(-1), vector3<T>(1)));
+    }
+
+    template<typename T>
+    std::vector<vector3<T>> corners(const obb<T> &aBox) {
+        std::vector<vector3<T>> result;
+
+        for (int i = 0; i < 8; ++i)
+            result.push_back(aBox.center
+                + aBox.axis(0) * (i & 1 ? aBox.half_extents.x : -aBox.half_extents.x)
+                + aBox.axis(1) * (i & 2 ? aBox.half_extents.y : -aBox.half_extents.y)
+                + aBox.axis(2) * (i & 4 ? aBox.half_extents.z : -aBox.half_extents.z));
+
+        return result;
+    }
+
+    //! true when the two boxes' corners project to disjoint intervals on aAxis
+    template<typename T>
+    bool separated_on(const obb<T> &a, const obb<T> &b, const vector3<T> &aAxis) {
+        T aMin = 1e30f, aMax = -1e30f, bMin = 1e30f, bMax = -1e30f;
+
+        for (const auto &p : corners(a)) { aMin = std::min(aMin, p.dot_product(aAxis)); aMax = std::max(aMax, p.dot_product(aAxis)); }
+        for (const auto &p : corners(b)) { bMin = std::min(bMin, p.dot_product(aAxis)); bMax = std::max(bMax, p.dot_product(aAxis)); }
+
+        return aMax < bMin || bMax < aMin;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("obb construction", "[obb]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using box = obb<TestType>;
+
+    SECTION("from_transform moves scale into the half extents and leaves a unit basis")
+    {
+        const matrix4x4<TestType> transform(vec(1, 2, 3),
+            quaternion<TestType>::from_angle_axis(to_radians(static_cast<TestType>(90)), vec::up), vec(2, 3, 4));
+
+        const auto b = box::from_transform(transform, aabb<TestType>(vec(-1, -1, -1), vec(1, 1, 3)));
+
+        REQUIRE(b.half_extents.x == Approx(2));
+        REQUIRE(b.half_extents.y == Approx(3));
+        REQUIRE(b.half_extents.z == Approx(8));
+
+        for (std::size_t i = 0; i < 3; ++i) REQUIRE(b.axis(i).length() == Approx(1));
+
+        // the local center (0, 0, 1) is scaled to z = 4, then turned a quarter about +Y onto +X
+        REQUIRE(b.center.x == Approx(5));
+        REQUIRE(b.center.y == Approx(2));
+        REQUIRE(b.center.z == Approx(3).margin(1e-5));
+    }
+
+    SECTION("contains is inclusive, and respects the rotation")
+    {
+        const box b(vec::zero, vec(2, 1, 1), upper_left(matrix4x4<TestType>(vec::zero,
+            quaternion<TestType>::from_angle_axis(to_radians(static_cast<TestType>(90)), vec::up))));
+
+        REQUIRE(b.contains(vec(0, 0, 1.9f)));
+        REQUIRE_FALSE(b.contains(vec(1.9f, 0, 0)));
+        REQUIRE(b.contains(vec(0, 1, 0)));
+    }
+
+    SECTION("bounds encloses every corner, and is tight for an unrotated box")
+    {
+        random_source random{1};
+
+        for (int i = 0; i < 20; ++i) {
+            const auto b = random_box<TestType>(random, 10);
+            const auto bounds = b.bounds().expanded(static_cast<TestType>(1e-4));
+
+            for (const auto &p : corners(b)) REQUIRE(bounds.contains(p));
+        }
+
+        REQUIRE(box(vec(1), vec(1, 2, 3)).bounds() == aabb<TestType>(vec(0, -1, -2), vec(2, 3, 4)));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("obb separating axis test", "[obb]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using box = obb<TestType>;
+
+    SECTION("unrotated boxes agree with aabb::overlaps, including touching faces")
+    {
+        random_source random{2};
+
+        std::size_t disagreements = 0;
+
+        for (int i = 0; i < 500; ++i) {
+            const box a(vec(random.next() * 4, random.next() * 4, random.next() * 4), vec(1, 0.5f, 2));
+            const box b(vec(random.next() * 4, random.next() * 4, random.next() * 4), vec(0.5f, 1, 1));
+
+            if (a.overlaps(b) != a.bounds().overlaps(b.bounds())) ++disagreements;
+        }
+
+        REQUIRE(disagreements == 0);
+
+        REQUIRE(box(vec::zero, vec(1)).overlaps(box(vec(2, 0, 0), vec(1))));
+    }
+
+    SECTION("it is symmetric, never misses a separating axis, and finds overlap when a corner is inside")
+    {
+        random_source random{3};
+        std::size_t separated = 0, overlapping = 0, asymmetric = 0, missedCorner = 0, missedAxis = 0;
+
+        for (int i = 0; i < 2000; ++i) {
+            const auto a = random_box<TestType>(random, 6);
+            const auto b = random_box<TestType>(random, 6);
+            const auto result = a.overlaps(b);
+
+            if (result) ++overlapping; else ++separated;
+            if (result != b.overlaps(a)) ++asymmetric;
+
+            for (const auto &p : corners(b)) if (a.contains(p) && !result) ++missedCorner;
+
+            for (std::size_t i0 = 0; i0 < 3; ++i0) for (std::size_t j0 = 0; j0 < 3; ++j0) {
+                const auto edge = a.axis(i0).cross_product(b.axis(j0));
+
+                for (const auto &axis : {a.axis(i0), b.axis(j0), edge})
+                    if (result && !axis.is_effectively_zero() && separated_on(a, b, axis)) ++missedAxis;
+            }
+        }
+
+        REQUIRE(asymmetric == 0);
+        REQUIRE(missedCorner == 0);
+        REQUIRE(missedAxis == 0);
+        REQUIRE(separated > 0);
+        REQUIRE(overlapping > 0);
+    }
+
+    SECTION("boxes crossed edge to edge are separated by an edge axis alone")
+    {
+        // two long bars, one along x and one along z, crossing above one another at 45 degrees
+        const auto tilt = upper_left(matrix4x4<TestType>(vec::zero,
+            quaternion<TestType>::from_angle_axis(to_radians(static_cast<TestType>(45)), vec::right)));
+
+        const box along(vec::zero, vec(10, 1, 1), tilt);
+        const box across(vec(0, 2.9f, 0), vec(1, 1, 10), tilt);
+
+        REQUIRE_FALSE(along.overlaps(across));
+
+        const box lower(vec(0, 2.7f, 0), vec(1, 1, 10), tilt);
+
+        REQUIRE(along.overlaps(lower));
+    }
+
+    SECTION("the batch form agrees with the pairwise one")
+    {
+        random_source random{4};
+
+        const auto probe = random_box<TestType>(random, 2);
+
+        std::vector<box> others;
+        for (int i = 0; i < 300; ++i) others.push_back(random_box<TestType>(random, 8));
+
+        const std::unique_ptr<bool[]> results(new bool[others.size()]);
+        const auto count = overlaps(probe, others.data(), others.size(), results.get());
+
+        std::size_t expected = 0, disagreements = 0;
+        for (std::size_t i = 0; i < others.size(); ++i) {
+            if (results[i] != probe.overlaps(others[i])) ++disagreements;
+            expected += results[i];
+        }
+
+        REQUIRE(disagreements == 0);
+        REQUIRE(count == expected);
+
+        struct entity final {
+            int id;
+            box bounds;
+            bool hit;
+        };
+
+        std::vector<entity> entities;
+        for (const auto &other : others) entities.push_back({0, other, false});
+
+        const strided_span<bool> hits(&entities.front().hit, entities.size(), sizeof(entity));
+
+        REQUIRE(overlaps(probe, strided_span<const box>(&entities.front().bounds, entities.size(), sizeof(entity)),
+            hits) == count);
+
+        for (std::size_t i = 0; i < entities.size(); ++i) REQUIRE(entities[i].hit == results[i]);
+
+        REQUIRE_THROWS_AS(overlaps(probe, strided_span<const box>(others.data(), others.size()),
+            hits.subspan(0, 10)), std::invalid_argument);
+    }
+}
@@ -0,0 +1,157 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/octahedral.h>
+
+#include "random_source.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    //! random unit directions, then the ones on the edges of the mapping: the axes, the equator, where
+    /// the fold meets itself, and the diagonals of each octant
+    template<typename T>
+    std::vector<vector3<T>> directions() {
+        std::vector<vector3<T>> out;
+
+        random_source rng{11};
+
+        for (int i = 0; i < 1000; ++i) {
+            const vector3<T> v(rng.next(), rng.next(), rng.next());
+
+            if (v.length_squared() > T(0.01)) out.push_back(v.normal());
+        }
+
+        out.push_back({1, 0, 0});
+        out.push_back({-1, 0, 0});
+        out.push_back({0, 1, 0});
+        out.push_back({0, -1, 0});
+        out.push_back({0, 0, 1});
+        out.push_back({0, 0, -1});
+        out.push_back(vector3<T>(1, -1, 0).normal());
+        out.push_back(vector3<T>(1, 1, 1).normal());
+        out.push_back(vector3<T>(-1, 1, -1).normal());
+        out.push_back(vector3<T>(-1, -1, -1).normal());
+
+        return out;
+    }
+
+    //! the angle between two directions, in degrees. From the chord between the two in double, as a
+    /// float cosine this close to 1 cannot resolve angles this small.
+    template<typename T>
+    double angle_between(const vector3<T> &a, const vector3<T> &b) {
+        const auto widen = [](const vector3<T> &v) {
+            return vector3<double>(static_cast<double>(v.x), static_cast<double>(v.y),
+                static_cast<double>(v.z)).normal();
+        };
+
+        return to_degrees(2 * std::asin((widen(a) - widen(b)).length() / 2));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("octahedral: round trips within the documented error", "[octahedral]", type::floating_point)
+{
+    using T = TestType;
+
+    for (const auto &v : directions<T>()) {
+        REQUIRE(angle_between(decode<T>(encode16(v)), v) <= 1);
+        REQUIRE(angle_between(decode<T>(encode24(v)), v) <= 0.06);
+        REQUIRE(angle_between(decode<T>(encode32(v)), v) <= 0.004);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("octahedral: the format", "[octahedral]", type::floating_point)
+{
+    using T = TestType;
+
+    SECTION("2, 3 and 4 bytes")
+    {
+        STATIC_REQUIRE(sizeof(octahedral16) == 2);
+        STATIC_REQUIRE(sizeof(octahedral24) == 3);
+        STATIC_REQUIRE(sizeof(octahedral32) == 4);
+    }
+
+    SECTION("the axes round trip exactly")
+    {
+        for (const auto &axis : {vector3<T>::right, vector3<T>::left, vector3<T>::up, vector3<T>::down,
+            vector3<T>::forward, vector3<T>::backward}) {
+            REQUIRE(decode<T>(encode16(axis)) == axis);
+            REQUIRE(decode<T>(encode24(axis)) == axis);
+            REQUIRE(decode<T>(encode32(axis)) == axis);
+        }
+    }
+
+    SECTION("+z is the center of the square")
+    {
+        REQUIRE(encode16(vector3<T>::backward).bits == 0x7f7f);
+        REQUIRE(encode32(vector3<T>::backward).bits == 0x7fff7fffu);
+    }
+
+    SECTION("only the direction is encoded, not the length")
+    {
+        for (const auto &v : directions<T>()) {
+            REQUIRE(encode16(v * T(3)) == encode16(v));
+            REQUIRE(encode32(v * T(0.25)) == encode32(v));
+        }
+    }
+
+    SECTION("decoding gives a unit vector")
+    {
+        for (const auto &v : directions<T>()) {
+            REQUIRE(decode<T>(encode16(v)).length() == Approx(1).margin(1e-5));
+            REQUIRE(decode<T>(encode24(v)).length() == Approx(1).margin(1e-5));
+            REQUIRE(decode<T>(encode32(v)).length() == Approx(1).margin(1e-5));
+        }
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("octahedral: the batch forms", "[octahedral]", type::floating_point)
+{
+    using T = TestType;
+
+    const auto in = directions<T>();
+    const auto count = in.size();
+
+    std::vector<octahedral16> encoded16(count);
+    std::vector<octahedral24> encoded24(count);
+    std::vector<octahedral32> encoded32(count);
+
+    encode16(in.data(), count, encoded16.data());
+    encode24(in.data(), count, encoded24.data());
+    encode32(in.data(), count, encoded32.data());
+
+    SECTION("encode and decode agree with the scalar forms")
+    {
+        std::vector<vector3<T>> out16(count), out24(count), out32(count);
+
+        decode(encoded16.data(), count, out16.data());
+        decode(encoded24.data(), count, out24.data());
+        decode(encoded32.data(), count, out32.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(encoded16[i] == encode16(in[i]));
+            REQUIRE(encoded24[i] == encode24(in[i]));
+            REQUIRE(encoded32[i] == encode32(in[i]));
+            REQUIRE(out16[i] == decode<T>(encoded16[i]));
+            REQUIRE(out24[i] == decode<T>(encoded24[i]));
+            REQUIRE(out32[i] == decode<T>(encoded32[i]));
+        }
+    }
+
+    SECTION("a count of zero writes nothing")
+    {
+        octahedral32 untouched{0x12345678u};
+
+        encode32(in.data(), 0, &untouched);
+
+        REQUIRE(untouched.bits == 0x12345678u);
+    }
+}
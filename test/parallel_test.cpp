@@ -0,0 +1,156 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/parallel.h>
+
+#include "random_source.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    //! an ellipsoidal cloud, so the axis-aligned extremes are not the whole story
+    template<typename T>
+    std::vector<vector3<T>> cloud(const std::size_t aCount, const std::uint32_t aSeed) {
+        random_source random{aSeed};
+        std::vector<vector3<T>> points;
+
+        const auto tilt = quaternion<T>::from_euler({0.4f, 0.9f, 0.2f});
+
+        while (points.size() < aCount) {
+            const vector3<T> p(random.next(), random.next(), random.next());
+
+            if (p.length_squared() > 1) continue;
+
+            points.push_back(tilt * p.element_wise_product({10, 3, 1}) + vector3<T>(5, -2, 7));
+        }
+
+        return points;
+    }
+
+    template<typename T>
+    void require_bounds(const sphere<T> &aSphere, const std::vector<vector3<T>> &aPoints) {
+        T farthest = 0;
+
+        for (const auto &p : aPoints) farthest = std::max(farthest, aSphere.center.distance_from(p));
+
+        REQUIRE(farthest <= aSphere.radius * static_cast<T>(1.0001));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("parallel: bounding spheres", "[parallel]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+
+    const auto points = cloud<TestType>(100000, 23);
+
+    SECTION("no points gives the default sphere")
+    {
+        REQUIRE(bounding_sphere_ritter<TestType>(nullptr, 0, 4) == sphere<TestType>());
+        REQUIRE(bounding_sphere_epos<TestType>(nullptr, 0, 0) == sphere<TestType>());
+    }
+
+    SECTION("one thread gives the single threaded sphere")
+    {
+        REQUIRE(bounding_sphere_ritter(points.data(), points.size(), 1)
+            == bounding_sphere_ritter(points.data(), points.size()));
+        REQUIRE(bounding_sphere_epos(points.data(), points.size(), 1)
+            == bounding_sphere_epos(points.data(), points.size()));
+    }
+
+    SECTION("splitting across threads still encloses every point")
+    {
+        const auto serial = bounding_sphere_ritter(points.data(), points.size());
+        const auto threaded = bounding_sphere_ritter(points.data(), points.size(), 4);
+        const auto everyCore = bounding_sphere_epos(points.data(), points.size(), 0);
+
+        require_bounds(threaded, points);
+        require_bounds(everyCore, points);
+
+        REQUIRE(threaded.radius <= serial.radius * static_cast<TestType>(1.05));
+    }
+
+    SECTION("a view is bounded as the array it views")
+    {
+        const strided_span<const vec> view(points.data(), points.size());
+
+        REQUIRE(bounding_sphere_ritter(view, 4) == bounding_sphere_ritter(points.data(), points.size(), 4));
+        REQUIRE(bounding_sphere_epos(view, 3) == bounding_sphere_epos(points.data(), points.size(), 3));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("parallel: many animation tracks", "[parallel]", type::floating_point)
+{
+    using T = TestType;
+
+    constexpr std::size_t TRACKS = 9, FRAMES = 120;
+
+    std::vector<std::vector<vector3<T>>> translationTracks(TRACKS);
+    std::vector<std::vector<quaternion<T>>> rotationTracks(TRACKS);
+    std::vector<const vector3<T> *> translationPointers;
+    std::vector<const quaternion<T> *> rotationPointers;
+
+    for (std::size_t i = 0; i < TRACKS; ++i) {
+        for (std::size_t frame = 0; frame < FRAMES; ++frame) {
+            const auto t = static_cast<T>(frame + i * 10) / 120;
+
+            translationTracks[i].emplace_back(std::sin(t) * 2, std::abs(std::sin(t * 3)), t * T(0.5));
+            rotationTracks[i].push_back(quaternion<T>::from_angle_axis(t * t, vector3<T>(1, t, 0).normal()));
+        }
+
+        translationPointers.push_back(translationTracks[i].data());
+        rotationPointers.push_back(rotationTracks[i].data());
+    }
+
+    SECTION("compressing across threads gives what compressing each alone does")
+    {
+        for (const std::size_t threads : {std::size_t(0), std::size_t(1), std::size_t(4), TRACKS * 2}) {
+            std::vector<compressed_vector3_track<T>> translationsOut(TRACKS);
+            std::vector<compressed_quaternion_track<T>> rotationsOut(TRACKS);
+
+            compress(translationPointers.data(), TRACKS, FRAMES, T(1e-3), translationsOut.data(), threads);
+            compress(rotationPointers.data(), TRACKS, FRAMES, T(1e-3), rotationsOut.data(), threads);
+
+            for (std::size_t i = 0; i < TRACKS; ++i) {
+                const auto translation = compress(translationPointers[i], FRAMES, T(1e-3));
+                const auto rotation = compress(rotationPointers[i], FRAMES, T(1e-3));
+
+                REQUIRE(translationsOut[i].frames == translation.frames);
+                REQUIRE(translationsOut[i].values == translation.values);
+                REQUIRE(rotationsOut[i].frames == rotation.frames);
+                REQUIRE(rotationsOut[i].values == rotation.values);
+            }
+        }
+    }
+}
+
+TEST_CASE("the threads behind the batch kernels pass exceptions back", "[parallel]")
+{
+    std::vector<int> done(4, 0);
+
+    const auto body = [&](const std::size_t, const std::size_t, const std::size_t aChunk) {
+        done[aChunk] = 1;
+
+        if (aChunk == 2) throw std::runtime_error("chunk 2");
+        if (aChunk == 3) throw std::length_error("chunk 3");
+    };
+
+    REQUIRE_THROWS_WITH(detail::parallel_chunks(100, 4, body), "chunk 2");
+    REQUIRE(done == std::vector<int>{1, 1, 1, 1});
+
+    const auto first = [](const std::size_t, const std::size_t, const std::size_t aChunk) {
+        if (aChunk == 0) throw std::logic_error("the calling thread's chunk");
+    };
+
+    REQUIRE_THROWS_AS(detail::parallel_chunks(100, 4, first), std::logic_error);
+}
@@ -0,0 +1,194 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/quantized_quaternion.h>
+
+#include "random_source.h"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    //! random unit rotations, then the ones that sit on the edges of the format: a largest component
+    /// at each index, negative largest components, and ties
+    template<typename T>
+    std::vector<quaternion<T>> rotations() {
+        std::vector<quaternion<T>> out;
+
+        random_source rng{7};
+
+        for (int i = 0; i < 1000; ++i) {
+            const auto a = rng.next(), b = rng.next(), c = rng.next(), d = rng.next();
+
+            const quaternion<T> q(a, b, c, d);
+
+            if (q.dot_product(q) > T(0.01)) out.push_back(q.normalized());
+        }
+
+        out.push_back({1, 0, 0, 0});
+        out.push_back({0, -1, 0, 0});
+        out.push_back({0, 0, 1, 0});
+        out.push_back({0, 0, 0, -1});
+        out.push_back({T(0.5), T(0.5), T(0.5), T(0.5)});
+        out.push_back({T(-0.5), T(0.5), T(-0.5), T(0.5)});
+        out.push_back(quaternion<T>(1, 1, 0, 0).normalized());
+        out.push_back(quaternion<T>(0, -1, 0, -1).normalized());
+
+        return out;
+    }
+
+    //! the angle between two rotations, in degrees, whichever of q and -q each is. From the chord
+    /// between the two in double, as a float cosine this close to 1 cannot resolve angles this small.
+    template<typename T>
+    double angle_between(const quaternion<T> &a, const quaternion<T> &b) {
+        const auto widen = [](const quaternion<T> &q) {
+            return quaternion<double>(static_cast<double>(q.x), static_cast<double>(q.y), static_cast<double>(q.z),
+                static_cast<double>(q.w)).normalized();
+        };
+
+        const auto da = widen(a), db = a.dot_product(b) < 0 ? -widen(b) : widen(b);
+        const auto chord = std::sqrt((da.x - db.x) * (da.x - db.x) + (da.y - db.y) * (da.y - db.y)
+            + (da.z - db.z) * (da.z - db.z) + (da.w - db.w) * (da.w - db.w));
+
+        return to_degrees(4 * std::asin(chord / 2));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("quantized_quaternion: round trips within the documented error", "[quantized_quaternion]",
+    type::floating_point)
+{
+    using T = TestType;
+
+    for (const auto &q : rotations<T>()) {
+        REQUIRE(angle_between(unpack<T>(pack32(q)), q) <= 0.25);
+        REQUIRE(angle_between(unpack<T>(pack48(q)), q) <= 0.008);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("quantized_quaternion: the format", "[quantized_quaternion]", type::floating_point)
+{
+    using T = TestType;
+
+    SECTION("4 and 6 bytes")
+    {
+        STATIC_REQUIRE(sizeof(packed_quaternion32) == 4);
+        STATIC_REQUIRE(sizeof(packed_quaternion48) == 6);
+    }
+
+    SECTION("the top 2 bits in use hold the index of the largest component")
+    {
+        REQUIRE(pack32(quaternion<T>(0, 0, 0, 1)).bits >> 30 == 3);
+        REQUIRE(pack32(quaternion<T>(0, -1, 0, 0)).bits >> 30 == 1);
+        REQUIRE(pack48(quaternion<T>(0, 0, 1, 0)).words[0] >> 13 == 2);
+    }
+
+    SECTION("q and -q pack the same, and unpack with a non-negative largest component")
+    {
+        for (const auto &q : rotations<T>()) {
+            REQUIRE(pack32(q) == pack32(-q));
+            REQUIRE(pack48(q) == pack48(-q));
+        }
+
+        const auto unpacked = unpack<T>(pack32(quaternion<T>(0, 0, 0, -1)));
+
+        REQUIRE(unpacked.w == Approx(1));
+    }
+
+    SECTION("unpacking gives a unit quaternion")
+    {
+        for (const auto &q : rotations<T>()) {
+            REQUIRE(unpack<T>(pack32(q)).dot_product(unpack<T>(pack32(q))) == Approx(1).margin(1e-5));
+            REQUIRE(unpack<T>(pack48(q)).dot_product(unpack<T>(pack48(q))) == Approx(1).margin(1e-5));
+        }
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("quantized_quaternion: the batch forms", "[quantized_quaternion]", type::floating_point)
+{
+    using T = TestType;
+
+    const auto in = rotations<T>();
+    const auto count = in.size();
+
+    std::vector<packed_quaternion32> packed32(count);
+    std::vector<packed_quaternion48> packed48(count);
+
+    pack32(in.data(), count, packed32.data());
+    pack48(in.data(), count, packed48.data());
+
+    SECTION("pack and unpack agree with the scalar forms")
+    {
+        std::vector<quaternion<T>> out32(count), out48(count);
+
+        unpack(packed32.data(), count, out32.data());
+        unpack(packed48.data(), count, out48.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(packed32[i] == pack32(in[i]));
+            REQUIRE(packed48[i] == pack48(in[i]));
+            REQUIRE(out32[i] == unpack<T>(packed32[i]));
+            REQUIRE(out48[i] == unpack<T>(packed48[i]));
+        }
+    }
+
+    SECTION("nlerp and slerp of packed rotations match them on the unpacked")
+    {
+        std::vector<packed_quaternion32> to32(packed32.rbegin(), packed32.rend());
+        std::vector<packed_quaternion48> to48(packed48.rbegin(), packed48.rend());
+
+        std::vector<quaternion<T>> n32(count), n48(count), s32(count), s48(count);
+
+        const auto t = T(0.3);
+
+        nlerp(packed32.data(), to32.data(), t, count, n32.data());
+        nlerp(packed48.data(), to48.data(), t, count, n48.data());
+        slerp(packed32.data(), to32.data(), t, count, s32.data());
+        slerp(packed48.data(), to48.data(), t, count, s48.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(n32[i] == nlerp(unpack<T>(packed32[i]), unpack<T>(to32[i]), t));
+            REQUIRE(n48[i] == nlerp(unpack<T>(packed48[i]), unpack<T>(to48[i]), t));
+            REQUIRE(s32[i] == slerp(unpack<T>(packed32[i]), unpack<T>(to32[i]), t));
+            REQUIRE(s48[i] == slerp(unpack<T>(packed48[i]), unpack<T>(to48[i]), t));
+        }
+
+        const strided_span<const packed_quaternion32> from32View(packed32.data(), count), to32View(to32.data(), count);
+        const strided_span<const packed_quaternion48> from48View(packed48.data(), count), to48View(to48.data(), count);
+
+        // every other element of a buffer twice the size
+        std::vector<quaternion<T>> interleaved(count * 2);
+        const strided_span<quaternion<T>> out(interleaved.data(), count, 2 * sizeof(quaternion<T>));
+
+        nlerp(from32View, to32View, t, out);
+        for (std::size_t i = 0; i < count; ++i) REQUIRE(interleaved[i * 2] == n32[i]);
+
+        nlerp(from48View, to48View, t, out);
+        for (std::size_t i = 0; i < count; ++i) REQUIRE(interleaved[i * 2] == n48[i]);
+
+        slerp(from32View, to32View, t, out);
+        for (std::size_t i = 0; i < count; ++i) REQUIRE(interleaved[i * 2] == s32[i]);
+
+        slerp(from48View, to48View, t, out);
+        for (std::size_t i = 0; i < count; ++i) REQUIRE(interleaved[i * 2] == s48[i]);
+
+        REQUIRE_THROWS_AS(nlerp(from32View, to32View.subspan(1, count - 1), t, out), std::invalid_argument);
+        REQUIRE_THROWS_AS(slerp(from48View, to48View, t, out.subspan(1, count - 1)), std::invalid_argument);
+    }
+
+    SECTION("a count of zero writes nothing")
+    {
+        packed_quaternion32 untouched{0x12345678u};
+
+        pack32(in.data(), 0, &untouched);
+
+        REQUIRE(untouched.bits == 0x12345678u);
+    }
+}
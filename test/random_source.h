@@ -0,0 +1,33 @@
+// © Joseph Cameron - All Rights Reserved
+
+#ifndef GDK_MATH_TEST_RANDOM_SOURCE_H
+#define GDK_MATH_TEST_RANDOM_SOURCE_H
+
+#include <cstdint>
+
+/// \file the generator the tests and the bench draw their inputs from: a linear congruential generator
+/// with the Numerical Recipes constants, so that a seed makes the same inputs on every platform and
+/// standard library, where std::uniform_real_distribution does not.
+namespace gdk {
+    namespace testing {
+        struct random_source final {
+            std::uint32_t state;
+
+            explicit random_source(const std::uint32_t aSeed) : state(aSeed) {}
+
+            //! uniform in [0, 1)
+            float next_unit() {
+                state = state * 1664525u + 1013904223u;
+
+                return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+            }
+
+            //! uniform in [-1, 1)
+            float next() {
+                return next_unit() * 2.0f - 1.0f;
+            }
+        };
+    }
+}
+
+#endif
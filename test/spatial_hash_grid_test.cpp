@@ -0,0 +1,218 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/spatial_hash_grid.h>
+
+#include "random_source.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    template<typename T>
+    std::vector<vector3<T>> random_points(random_source &aRandom, const std::size_t aCount, const float aWorld) {
+        std::vector<vector3<T>> points;
+
+        for (std::size_t i = 0; i < aCount; ++i)
+            points.emplace_back(aRandom.next_unit() * aWorld - aWorld / 2, aRandom.next_unit() * aWorld - aWorld / 2,
+                aRandom.next_unit() * aWorld - aWorld / 2);
+
+        return points;
+    }
+
+    template<typename T>
+    std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> aIndices) {
+        std::sort(aIndices.begin(), aIndices.end());
+
+        return aIndices;
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("spatial_hash_grid radius queries over points", "[spatial_hash_grid]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+
+    random_source random{3};
+    const auto points = random_points<TestType>(random, 2000, 40);
+
+    spatial_hash_grid<TestType> grid(2);
+    grid.build(points.data(), points.size());
+
+    REQUIRE(grid.size() == points.size());
+    REQUIRE(grid.cell_count() > 0);
+    REQUIRE(grid.cell_count() <= points.size());
+
+    std::vector<std::uint32_t> found;
+
+    SECTION("they agree with brute force, for radii smaller and larger than a cell")
+    {
+        for (const auto radius : {0.5f, 2.0f, 7.5f}) for (int q = 0; q < 20; ++q) {
+            const auto center = random_points<TestType>(random, 1, 50)[0];
+
+            std::vector<std::uint32_t> expected;
+            for (std::uint32_t i = 0; i < points.size(); ++i)
+                if ((points[i] - center).length_squared() <= static_cast<TestType>(radius * radius))
+                    expected.push_back(i);
+
+            grid.query_radius(center, radius, found);
+
+            REQUIRE(sorted<TestType>(found) == expected);
+        }
+    }
+
+    SECTION("a radius covering everything finds everything, without overflowing the cell coordinates")
+    {
+        grid.query_radius(vec::zero, std::numeric_limits<TestType>::max(), found);
+
+        REQUIRE(found.size() == points.size());
+    }
+
+    SECTION("a query far from every point finds nothing")
+    {
+        grid.query_radius(vec(1e6f, 0, 0), 1, found);
+
+        REQUIRE(found.empty());
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("spatial_hash_grid radius queries over spheres", "[spatial_hash_grid]", type::floating_point)
+{
+    random_source random{5};
+    const auto centers = random_points<TestType>(random, 1000, 30);
+
+    std::vector<TestType> radii;
+    for (std::size_t i = 0; i < centers.size(); ++i) radii.push_back(static_cast<TestType>(random.next_unit() * 3));
+
+    spatial_hash_grid<TestType> grid(1);
+    grid.build(centers.data(), radii.data(), centers.size());
+
+    std::vector<std::uint32_t> found;
+
+    for (int q = 0; q < 50; ++q) {
+        const auto center = random_points<TestType>(random, 1, 30)[0];
+        const TestType radius = static_cast<TestType>(random.next_unit());
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < centers.size(); ++i) {
+            const auto limit = radius + radii[i];
+
+            if ((centers[i] - center).length_squared() <= limit * limit) expected.push_back(i);
+        }
+
+        grid.query_radius(center, radius, found);
+
+        REQUIRE(sorted<TestType>(found) == expected);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("spatial_hash_grid nearest queries", "[spatial_hash_grid]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+
+    random_source random{11};
+    const auto points = random_points<TestType>(random, 1500, 60);
+
+    spatial_hash_grid<TestType> grid(3);
+    grid.build(points.data(), points.size());
+
+    std::vector<std::uint32_t> found;
+
+    const auto brute_force = [&](const vec &aPoint, const std::size_t aCount) {
+        std::vector<std::uint32_t> order(points.size());
+        for (std::uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+
+        std::sort(order.begin(), order.end(), [&](const std::uint32_t a, const std::uint32_t b) {
+            const auto da = (points[a] - aPoint).length_squared();
+            const auto db = (points[b] - aPoint).length_squared();
+
+            return da < db || (da == db && a < b);
+        });
+
+        order.resize(std::min(aCount, order.size()));
+
+        return order;
+    };
+
+    SECTION("they agree with brute force, nearest first, from inside and outside the cloud")
+    {
+        for (const auto k : {std::size_t(1), std::size_t(8), std::size_t(40)}) for (int q = 0; q < 20; ++q) {
+            const auto point = random_points<TestType>(random, 1, q % 2 ? 200.0f : 60.0f)[0];
+
+            grid.query_nearest(point, k, found);
+
+            REQUIRE(found == brute_force(point, k));
+        }
+    }
+
+    SECTION("asking for more than there are returns them all")
+    {
+        grid.query_nearest(vec::zero, points.size() + 10, found);
+
+        REQUIRE(found.size() == points.size());
+    }
+
+    SECTION("a few points spread far apart are found without walking the cells between them")
+    {
+        const std::vector<vec> sparse{vec(-100000, -100000, -100000), vec(100000, 100000, 100000), vec(1, 2, 3)};
+
+        spatial_hash_grid<TestType> fine(1);
+        fine.build(sparse.data(), sparse.size());
+
+        fine.query_nearest(vec(90000, 90000, 90000), 2, found);
+        REQUIRE(found == std::vector<std::uint32_t>{1, 2});
+
+        fine.query_nearest(vec::zero, 3, found);
+        REQUIRE(found == std::vector<std::uint32_t>{2, 0, 1});
+    }
+
+    SECTION("an empty grid returns nothing")
+    {
+        grid.build(points.data(), 0);
+
+        grid.query_nearest(vec::zero, 5, found);
+        REQUIRE(found.empty());
+
+        grid.query_radius(vec::zero, 100, found);
+        REQUIRE(found.empty());
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("spatial_hash_grid cells", "[spatial_hash_grid]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using cell = vector3<std::int32_t>;
+
+    spatial_hash_grid<TestType> grid(2);
+
+    SECTION("cell_of floors, so negative coordinates do not share cell zero")
+    {
+        REQUIRE(grid.cell_of(vec(0.5f, 1.9f, 2)) == cell(0, 0, 1));
+        REQUIRE(grid.cell_of(vec(-0.5f, -2, -2.1f)) == cell(-1, -1, -2));
+    }
+
+    SECTION("cell_of clamps distant and non-finite points instead of overflowing")
+    {
+        const auto limit = std::int32_t(1) << 30;
+
+        REQUIRE(grid.cell_of(vec(1e30f, -1e30f, 0)) == cell(limit, -limit, 0));
+        REQUIRE(grid.cell_of(vec(std::numeric_limits<TestType>::infinity(), 0, 0)).x == limit);
+
+        const auto nan = grid.cell_of(vec(std::numeric_limits<TestType>::quiet_NaN(), 0, 0)).x;
+        REQUIRE((nan >= -limit && nan <= limit));
+    }
+
+    SECTION("the cell size must be positive")
+    {
+        REQUIRE_THROWS_AS(spatial_hash_grid<TestType>(0), std::domain_error);
+        REQUIRE_THROWS_AS(spatial_hash_grid<TestType>(-1), std::domain_error);
+    }
+}
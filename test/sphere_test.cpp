@@ -0,0 +1,166 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/sphere.h>
+
+#include "random_source.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    //! an ellipsoidal cloud, so the axis-aligned extremes are not the whole story
+    template<typename T>
+    std::vector<vector3<T>> cloud(const std::size_t aCount, const std::uint32_t aSeed) {
+        random_source random{aSeed};
+        std::vector<vector3<T>> points;
+
+        const auto tilt = quaternion<T>::from_euler({0.4f, 0.9f, 0.2f});
+
+        while (points.size() < aCount) {
+            const vector3<T> p(random.next(), random.next(), random.next());
+
+            if (p.length_squared() > 1) continue;
+
+            points.push_back(tilt * p.element_wise_product({10, 3, 1}) + vector3<T>(5, -2, 7));
+        }
+
+        return points;
+    }
+
+    template<typename T>
+    void require_bounds(const sphere<T> &aSphere, const std::vector<vector3<T>> &aPoints) {
+        T farthest = 0;
+
+        for (const auto &p : aPoints) farthest = std::max(farthest, aSphere.center.distance_from(p));
+
+        REQUIRE(farthest <= aSphere.radius * static_cast<T>(1.0001));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("sphere queries", "[sphere]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using ball = sphere<TestType>;
+
+    const ball unit(vec::zero, 1);
+
+    SECTION("the default is a point at the origin")
+    {
+        REQUIRE(ball() == ball(vec::zero, 0));
+    }
+
+    SECTION("containment and overlap are inclusive of the surface")
+    {
+        REQUIRE(unit.contains(vec(1, 0, 0)));
+        REQUIRE_FALSE(unit.contains(vec(1, 0.01f, 0)));
+
+        REQUIRE(unit.contains(ball(vec(0.5f, 0, 0), 0.5f)));
+        REQUIRE_FALSE(unit.contains(ball(vec(0.5f, 0, 0), 0.6f)));
+
+        REQUIRE(unit.overlaps(ball(vec(3, 0, 0), 2)));
+        REQUIRE_FALSE(unit.overlaps(ball(vec(3, 0, 0), 1.9f)));
+    }
+
+    SECTION("merging two apart spans both exactly")
+    {
+        const auto merged = unit.merged(ball(vec(4, 0, 0), 1));
+
+        REQUIRE(merged.center.x == Approx(2));
+        REQUIRE(merged.radius == Approx(3));
+    }
+
+    SECTION("merging with an enclosed sphere or point changes nothing")
+    {
+        REQUIRE(unit.merged(ball(vec(0.2f, 0, 0), 0.1f)) == unit);
+        REQUIRE(ball(vec(0.2f, 0, 0), 0.1f).merged(unit) == unit);
+        REQUIRE(unit.merged(vec(0, 0.5f, 0)) == unit);
+    }
+
+    SECTION("merging a point grows to reach it and no further")
+    {
+        const auto merged = unit.merged(vec(3, 0, 0));
+
+        REQUIRE(merged.center.x == Approx(1));
+        REQUIRE(merged.radius == Approx(2));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("sphere transformed", "[sphere]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using ball = sphere<TestType>;
+
+    const ball b(vec(1, 0, 0), 2);
+
+    SECTION("translation and rotation move the center, not the radius")
+    {
+        const matrix4x4<TestType> m(vec(0, 5, 0), quaternion<TestType>::from_angle_axis(
+            to_radians(static_cast<TestType>(90)), vec::up));
+
+        const auto moved = b.transformed(m);
+
+        REQUIRE(moved.center.x == Approx(0).margin(1e-5));
+        REQUIRE(moved.center.y == Approx(5));
+        REQUIRE(moved.center.z == Approx(-1));
+        REQUIRE(moved.radius == Approx(2));
+    }
+
+    SECTION("the largest scale axis scales the radius")
+    {
+        const matrix4x4<TestType> m(vec::zero, quaternion<TestType>::identity, vec(1, 3, 2));
+
+        REQUIRE(b.transformed(m).radius == Approx(6));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("bounding sphere construction", "[sphere]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+
+    SECTION("no points gives the default sphere")
+    {
+        REQUIRE(bounding_sphere_ritter<TestType>(nullptr, 0) == sphere<TestType>());
+        REQUIRE(bounding_sphere_epos<TestType>(nullptr, 0) == sphere<TestType>());
+    }
+
+    SECTION("a single point gives a zero radius sphere on it")
+    {
+        const vec p(1, 2, 3);
+
+        REQUIRE(bounding_sphere_ritter(&p, 1) == sphere<TestType>(p, 0));
+    }
+
+    SECTION("two points give the sphere across them")
+    {
+        const vec points[] = {vec(-1, 0, 0), vec(3, 0, 0)};
+        const auto b = bounding_sphere_epos(points, 2);
+
+        REQUIRE(b.center.x == Approx(1));
+        REQUIRE(b.radius == Approx(2));
+    }
+
+    SECTION("both enclose every point, and EPOS is no looser than Ritter here")
+    {
+        const auto points = cloud<TestType>(5000, 17);
+
+        const auto ritter = bounding_sphere_ritter(points.data(), points.size());
+        const auto epos = bounding_sphere_epos(points.data(), points.size());
+
+        require_bounds(ritter, points);
+        require_bounds(epos, points);
+
+        // the ellipsoid's longest semi-axis is 10, the lower bound on any enclosing sphere
+        REQUIRE(epos.radius >= static_cast<TestType>(9.5));
+        REQUIRE(epos.radius <= ritter.radius * static_cast<TestType>(1.0001));
+        REQUIRE(ritter.radius < static_cast<TestType>(10 * 1.2));
+    }
+}
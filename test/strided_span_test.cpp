@@ -0,0 +1,287 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/aabb.h>
+#include <gdk/half.h>
+#include <gdk/matrix4x4.h>
+#include <gdk/octahedral.h>
+#include <gdk/quantized_quaternion.h>
+#include <gdk/spatial_hash_grid.h>
+#include <gdk/sphere.h>
+#include <gdk/strided_span.h>
+#include <gdk/vector2.h>
+#include <gdk/vector4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! an interleaved vertex, as a renderer would lay it out
+    template<typename T>
+    struct vertex final {
+        vector3<T> position;
+        vector3<T> normal;
+        vector2<T> uv;
+    };
+
+    template<typename T>
+    std::vector<vertex<T>> vertices(const std::size_t aCount) {
+        std::vector<vertex<T>> out(aCount);
+
+        for (std::size_t i = 0; i < aCount; ++i) {
+            const auto s = static_cast<T>(i);
+
+            out[i].position = {std::sin(s) * 10, std::cos(s * T(0.7)) * 5, s / 10};
+            out[i].normal = vector3<T>(std::cos(s), 1, std::sin(s * 3)).normal();
+            out[i].uv = {s, -s};
+        }
+
+        return out;
+    }
+
+    template<typename T>
+    strided_span<vector3<T>> positions(std::vector<vertex<T>> &aVertices) {
+        return {&aVertices.front().position, aVertices.size(), sizeof(vertex<T>)};
+    }
+
+    template<typename T>
+    strided_span<vector3<T>> normals(std::vector<vertex<T>> &aVertices) {
+        return {&aVertices.front().normal, aVertices.size(), sizeof(vertex<T>)};
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("strided_span: views", "[strided_span]", type::floating_point)
+{
+    using T = TestType;
+
+    auto buffer = vertices<T>(20);
+    const auto view = positions(buffer);
+
+    SECTION("elements are the members of the interleaved structs, read and written in place")
+    {
+        REQUIRE(view.size() == 20);
+        REQUIRE(view.stride() == sizeof(vertex<T>));
+        REQUIRE(!view.is_contiguous());
+
+        for (std::size_t i = 0; i < view.size(); ++i) REQUIRE(&view[i] == &buffer[i].position);
+
+        view[3] = {1, 2, 3};
+
+        REQUIRE(buffer[3].position == vector3<T>(1, 2, 3));
+        REQUIRE(buffer[3].uv == vector2<T>(3, -3));
+    }
+
+    SECTION("iterators step by the stride and work with the standard algorithms")
+    {
+        REQUIRE(std::distance(view.begin(), view.end()) == 20);
+        REQUIRE(view.begin()[5] == buffer[5].position);
+        REQUIRE(*(view.end() - 1) == buffer.back().position);
+        REQUIRE(view.begin()->x == buffer[0].position.x);
+
+        const auto sum = std::accumulate(view.begin(), view.end(), vector3<T>::zero);
+        auto expected = vector3<T>::zero;
+        for (const auto &v : buffer) expected += v.position;
+
+        REQUIRE(sum == expected);
+
+        std::fill(view.begin(), view.end(), vector3<T>(7));
+
+        for (const auto &v : buffer) REQUIRE(v.position == vector3<T>(7));
+    }
+
+    SECTION("an array is a contiguous span, and mutable spans convert to const ones")
+    {
+        std::vector<vector3<T>> array(4, vector3<T>(2));
+
+        const strided_span<vector3<T>> contiguous(array.data(), array.size());
+        const strided_span<const vector3<T>> reading = contiguous;
+
+        REQUIRE(contiguous.is_contiguous());
+        REQUIRE(reading.data() == array.data());
+        REQUIRE(reading.size() == 4);
+        REQUIRE(strided_span<const vector3<T>>().empty());
+        REQUIRE(strided_span<const vector3<T>>().data() == nullptr);
+    }
+
+    SECTION("a subspan keeps the stride")
+    {
+        const auto sub = view.subspan(5, 10);
+
+        REQUIRE(sub.size() == 10);
+        REQUIRE(&sub[0] == &buffer[5].position);
+        REQUIRE(&sub[9] == &buffer[14].position);
+        REQUIRE(view.subspan(20, 0).empty());
+        REQUIRE_THROWS_AS(view.subspan(15, 6), std::out_of_range);
+    }
+
+    SECTION("a zero, overlapping or misaligned stride or start is rejected")
+    {
+        auto *const bytes = reinterpret_cast<unsigned char *>(buffer.data());
+
+        REQUIRE_THROWS_AS(strided_span<vector3<T>>(bytes, 2, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(strided_span<vector3<T>>(bytes, 2, sizeof(T)), std::invalid_argument);
+        REQUIRE_THROWS_AS(strided_span<vector3<T>>(bytes + 1, 2, sizeof(vertex<T>)), std::invalid_argument);
+        REQUIRE_THROWS_AS(strided_span<vector3<T>>(bytes, 2, sizeof(vertex<T>) + 1), std::invalid_argument);
+    }
+
+    SECTION("a matrix per instance, beside other per instance data")
+    {
+        struct instance final {
+            matrix4x4<T> world;
+            vector4<T> color;
+        };
+
+        std::vector<instance> instances(8);
+
+        const strided_span<matrix4x4<T>> worlds(&instances.front().world, instances.size(), sizeof(instance));
+
+        for (std::size_t i = 0; i < worlds.size(); ++i) {
+            worlds[i] = matrix4x4<T>(vector3<T>(static_cast<T>(i), 0, 0), quaternion<T>::identity, vector3<T>(1));
+            instances[i].color = vector4<T>(1, 1, 1, 1);
+        }
+
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            REQUIRE(instances[i].world == matrix4x4<T>(vector3<T>(static_cast<T>(i), 0, 0),
+                quaternion<T>::identity, vector3<T>(1)));
+            REQUIRE(instances[i].color == vector4<T>(1, 1, 1, 1));
+        }
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("strided_span: batch operations over interleaved buffers", "[strided_span]",
+    type::floating_point)
+{
+    using T = TestType;
+
+    auto buffer = vertices<T>(300);
+
+    const strided_span<const vector3<T>> points = positions(buffer);
+    const strided_span<const vector3<T>> directions = normals(buffer);
+
+    std::vector<vector3<T>> copied(points.begin(), points.end());
+
+    SECTION("bounding volumes are those of the copied points")
+    {
+        REQUIRE(aabb<T>::from_points(points) == aabb<T>::from_points(copied.data(), copied.size()));
+        REQUIRE(aabb<T>::from_points(strided_span<const vector3<T>>()).is_empty());
+
+        REQUIRE(bounding_sphere_ritter(points) == bounding_sphere_ritter(copied.data(), copied.size()));
+        REQUIRE(bounding_sphere_epos(points) == bounding_sphere_epos(copied.data(), copied.size()));
+    }
+
+    SECTION("a grid built from a view answers as one built from the copy")
+    {
+        spatial_hash_grid<T> fromView(2), fromCopy(2);
+        fromView.build(points);
+        fromCopy.build(copied.data(), copied.size());
+
+        std::vector<std::uint32_t> a, b;
+        fromView.query_radius(vector3<T>(1, 1, 1), 4, a);
+        fromCopy.query_radius(vector3<T>(1, 1, 1), 4, b);
+
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+
+        REQUIRE(!a.empty());
+        REQUIRE(a == b);
+
+        const std::vector<T> radii(copied.size(), T(0.5));
+        fromView.build(points, strided_span<const T>(radii.data(), radii.size()));
+        fromView.query_radius(vector3<T>(1, 1, 1), 4, a);
+
+        REQUIRE(a.size() >= b.size());
+
+        REQUIRE_THROWS_AS(fromView.build(points, strided_span<const T>(radii.data(), radii.size() - 1)),
+            std::invalid_argument);
+    }
+
+    SECTION("normals encode into the buffer's own octahedral column and decode back in place")
+    {
+        struct packed_vertex final {
+            vector3<T> position;
+            octahedral32 normal;
+        };
+
+        std::vector<packed_vertex> packed(buffer.size());
+        const strided_span<octahedral32> encoded(&packed.front().normal, packed.size(), sizeof(packed_vertex));
+
+        encode32(directions, encoded);
+
+        std::vector<octahedral32> expected(copied.size());
+        std::vector<vector3<T>> normalsCopy(directions.begin(), directions.end());
+        encode32(normalsCopy.data(), normalsCopy.size(), expected.data());
+
+        for (std::size_t i = 0; i < packed.size(); ++i) REQUIRE(packed[i].normal.bits == expected[i].bits);
+
+        decode(strided_span<const octahedral32>(encoded), normals(buffer));
+
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+            REQUIRE((buffer[i].normal - normalsCopy[i]).length() < T(1e-4));
+    }
+
+    SECTION("rotations pack and unpack through views")
+    {
+        std::vector<quaternion<T>> rotations;
+        for (const auto &n : directions) rotations.push_back(quaternion<T>::from_angle_axis(n.x * 3, n));
+
+        std::vector<packed_quaternion48> viaSpan(rotations.size()), viaArray(rotations.size());
+        pack48(strided_span<const quaternion<T>>(rotations.data(), rotations.size()),
+            strided_span<packed_quaternion48>(viaSpan.data(), viaSpan.size()));
+        pack48(rotations.data(), rotations.size(), viaArray.data());
+
+        for (std::size_t i = 0; i < rotations.size(); ++i) REQUIRE(viaSpan[i] == viaArray[i]);
+
+        std::vector<quaternion<T>> unpacked(rotations.size(), quaternion<T>::identity);
+        const strided_span<quaternion<T>> everyOther(unpacked.data(), unpacked.size() / 2, 2 * sizeof(quaternion<T>));
+
+        unpack(strided_span<const packed_quaternion48>(viaArray.data(), everyOther.size()), everyOther);
+
+        for (std::size_t i = 0; i < unpacked.size(); ++i) {
+            if (i % 2) REQUIRE(unpacked[i] == quaternion<T>::identity);
+            else REQUIRE(unpacked[i] == unpack<T>(viaArray[i / 2]));
+        }
+
+        REQUIRE_THROWS_AS(unpack(strided_span<const packed_quaternion48>(viaArray.data(), viaArray.size()),
+            everyOther), std::invalid_argument);
+    }
+}
+
+TEST_CASE("strided_span: half positions in an interleaved buffer", "[strided_span]")
+{
+    auto buffer = vertices<float>(100);
+
+    struct half_vertex final {
+        half_vector3 position;
+        half_vector2 uv;
+    };
+
+    std::vector<half_vertex> halves(buffer.size());
+
+    const strided_span<const vector3<float>> points = positions(buffer);
+
+    to_half(points, strided_span<half_vector3>(&halves.front().position, halves.size(), sizeof(half_vertex)));
+
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        const auto expected = to_half(buffer[i].position);
+
+        REQUIRE(halves[i].position.x == expected.x);
+        REQUIRE(halves[i].position.y == expected.y);
+        REQUIRE(halves[i].position.z == expected.z);
+    }
+
+    from_half(strided_span<const half_vector3>(&halves.front().position, halves.size(), sizeof(half_vertex)),
+        positions(buffer));
+
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+        REQUIRE(buffer[i].position == from_half(halves[i].position));
+}
@@ -0,0 +1,211 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+#include <jfc/types.h>
+
+#include <gdk/sweep_and_prune.h>
+
+#include "random_source.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    using gdk::testing::random_source;
+
+    template<typename T>
+    aabb<T> random_box(random_source &aRandom, const float aWorld) {
+        const vector3<T> center(aRandom.next_unit() * aWorld, aRandom.next_unit() * aWorld,
+            aRandom.next_unit() * aWorld);
+        const vector3<T> half(aRandom.next_unit() + 0.1f, aRandom.next_unit() + 0.1f, aRandom.next_unit() + 0.1f);
+
+        return aabb<T>::from_center(center, half);
+    }
+
+    template<typename T>
+    std::vector<typename sweep_and_prune<T>::pair_type> brute_force(const sweep_and_prune<T> &aBroadphase,
+        const std::vector<typename sweep_and_prune<T>::body_type> &aBodies) {
+        std::vector<typename sweep_and_prune<T>::pair_type> pairs;
+
+        for (std::size_t i = 0; i < aBodies.size(); ++i)
+            for (std::size_t j = i + 1; j < aBodies.size(); ++j)
+                if (aBroadphase.bounds(aBodies[i]).overlaps(aBroadphase.bounds(aBodies[j])))
+                    pairs.emplace_back(std::min(aBodies[i], aBodies[j]), std::max(aBodies[i], aBodies[j]));
+
+        std::sort(pairs.begin(), pairs.end());
+
+        return pairs;
+    }
+
+    template<typename T>
+    void require_same_pairs(std::vector<typename sweep_and_prune<T>::pair_type> aFound,
+        const std::vector<typename sweep_and_prune<T>::pair_type> &aExpected) {
+        std::sort(aFound.begin(), aFound.end());
+
+        REQUIRE(aFound == aExpected);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("sweep_and_prune finds exactly the overlapping pairs", "[sweep_and_prune]", type::floating_point)
+{
+    using broadphase = sweep_and_prune<TestType>;
+
+    random_source random{7};
+    broadphase sap;
+    std::vector<typename broadphase::body_type> bodies;
+    std::vector<typename broadphase::pair_type> pairs;
+
+    for (int i = 0; i < 300; ++i) bodies.push_back(sap.add(random_box<TestType>(random, 20)));
+
+    SECTION("after the first, full sort")
+    {
+        sap.find_pairs(pairs);
+
+        REQUIRE_FALSE(pairs.empty());
+        require_same_pairs<TestType>(pairs, brute_force(sap, bodies));
+    }
+
+    SECTION("across ticks of small motion, which take the insertion sort path")
+    {
+        sap.find_pairs(pairs);
+
+        for (int tick = 0; tick < 20; ++tick) {
+            for (const auto body : bodies) {
+                const vector3<TestType> step(random.next_unit() - 0.5f, random.next_unit() - 0.5f,
+                    random.next_unit() - 0.5f);
+                const auto &bounds = sap.bounds(body);
+
+                sap.update(body, {bounds.min + step, bounds.max + step});
+            }
+
+            sap.find_pairs(pairs);
+
+            require_same_pairs<TestType>(pairs, brute_force(sap, bodies));
+        }
+    }
+
+    SECTION("bodies can be removed and their handles reused")
+    {
+        for (std::size_t i = 0; i < bodies.size(); i += 3) sap.remove(bodies[i]);
+
+        std::vector<typename broadphase::body_type> survivors;
+        for (std::size_t i = 0; i < bodies.size(); ++i) if (i % 3) survivors.push_back(bodies[i]);
+
+        REQUIRE(sap.size() == survivors.size());
+
+        const auto reused = sap.add(random_box<TestType>(random, 20));
+        survivors.push_back(reused);
+
+        REQUIRE(reused == bodies[bodies.size() - 1 - (bodies.size() - 1) % 3]);
+
+        sap.find_pairs(pairs);
+
+        require_same_pairs<TestType>(pairs, brute_force(sap, survivors));
+    }
+
+    SECTION("the result does not depend on the axis")
+    {
+        sap.find_pairs(pairs);
+        const auto expected = brute_force(sap, bodies);
+
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            sap.set_axis(axis);
+            sap.find_pairs(pairs);
+
+            REQUIRE(sap.axis() == axis);
+            require_same_pairs<TestType>(pairs, expected);
+        }
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("sweep_and_prune bookkeeping", "[sweep_and_prune]", type::floating_point)
+{
+    using vec = vector3<TestType>;
+    using box = aabb<TestType>;
+    using broadphase = sweep_and_prune<TestType>;
+
+    SECTION("touching boxes are reported, as aabb::overlaps would")
+    {
+        broadphase sap;
+        std::vector<typename broadphase::pair_type> pairs;
+
+        const auto a = sap.add(box(vec(0), vec(1)));
+        const auto b = sap.add(box(vec(1, 0, 0), vec(2, 1, 1)));
+        (void)sap.add(box(vec(5), vec(6)));
+
+        sap.find_pairs(pairs);
+
+        REQUIRE(pairs.size() == 1);
+        REQUIRE(pairs[0] == typename broadphase::pair_type(a, b));
+    }
+
+    SECTION("empty and inverted boxes are tracked but overlap nothing")
+    {
+        broadphase sap;
+        std::vector<typename broadphase::pair_type> pairs;
+
+        for (int i = 0; i < 5; ++i) (void)sap.add(box(vec(0), vec(1)));
+
+        const auto empty = sap.add(box::empty);
+        const auto inverted = sap.add(box(vec(3, 0, 0), vec(2, 1, 1)));
+
+        for (int tick = 0; tick < 2; ++tick) {
+            sap.find_pairs(pairs);
+
+            REQUIRE(pairs.size() == 10);
+            for (const auto &pair : pairs) REQUIRE((pair.first != empty && pair.second != inverted));
+
+            // an inverted box moved over the others still finds nothing, through the insertion sort
+            sap.update(inverted, box(vec(1, 0, 0), vec(0, 1, 1)));
+        }
+
+        REQUIRE(sap.best_axis() < 3);
+
+        sap.update(empty, box(vec(0), vec(1)));
+        sap.find_pairs(pairs);
+
+        REQUIRE(pairs.size() == 15);
+    }
+
+    SECTION("NaN bounds throw")
+    {
+        broadphase sap;
+        const auto nan = std::numeric_limits<TestType>::quiet_NaN();
+
+        REQUIRE_THROWS_AS(sap.add(box(vec(0), vec(nan, 1, 1))), std::invalid_argument);
+
+        const auto body = sap.add(box(vec(0), vec(1)));
+
+        REQUIRE_THROWS_AS(sap.update(body, box(vec(0, nan, 0), vec(1))), std::invalid_argument);
+        REQUIRE(sap.bounds(body) == box(vec(0), vec(1)));
+    }
+
+    SECTION("best_axis is the one the bodies are spread along")
+    {
+        broadphase sap;
+
+        for (int i = 0; i < 10; ++i)
+            (void)sap.add(box::from_center(vec(0, 0, static_cast<TestType>(i * 10)), vec(1)));
+
+        REQUIRE(sap.best_axis() == 2);
+    }
+
+    SECTION("bad handles and axes throw")
+    {
+        broadphase sap;
+        const auto body = sap.add(box());
+
+        sap.remove(body);
+
+        REQUIRE_THROWS_AS(sap.update(body, box()), std::out_of_range);
+        REQUIRE_THROWS_AS(sap.remove(body), std::out_of_range);
+        REQUIRE_THROWS_AS(sap.bounds(42), std::out_of_range);
+        REQUIRE_THROWS_AS(broadphase(3), std::out_of_range);
+        REQUIRE_THROWS_AS(sap.set_axis(3), std::out_of_range);
+    }
+}
@@ -0,0 +1,336 @@
+// © Joseph Cameron - All Rights Reserved
+
+#include <jfc/catch.hpp>
+
+#include <gdk/transform_delta.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdk;
+
+namespace {
+    //! a crowd of entities, a few of them moving and turning each tick
+    template<typename T>
+    struct crowd final {
+        std::vector<vector3<T>> positions;
+        std::vector<quaternion<T>> rotations;
+
+        explicit crowd(const std::size_t aCount) {
+            for (std::size_t i = 0; i < aCount; ++i) {
+                const auto s = static_cast<T>(i);
+
+                positions.emplace_back(s * T(1.37) - 500, std::sin(s) * 20, s * T(-0.61) + 300);
+                rotations.push_back(quaternion<T>::from_angle_axis(s * T(0.37),
+                    vector3<T>(std::cos(s), 1, std::sin(s)).normal()));
+            }
+        }
+
+        //! move every aEvery-th entity by about a tick's worth of walking, and turn it a little
+        void tick(const std::size_t aEvery, const T aTime) {
+            for (std::size_t i = 0; i < positions.size(); i += aEvery) {
+                positions[i] += vector3<T>(T(0.08), 0, std::sin(aTime + T(i)) * T(0.05));
+                const auto turn = quaternion<T>::from_angle_axis(T(0.02), vector3<T>(0, 1, 0));
+
+                rotations[i] = (rotations[i] * turn).normalized();
+            }
+        }
+    };
+
+    //! the angle between two rotations, in double as float's acos is too coarse near zero
+    template<typename T>
+    double angle_between(const quaternion<T> &aLeft, const quaternion<T> &aRight) {
+        const auto dot = std::abs(double(aLeft.x) * aRight.x + double(aLeft.y) * aRight.y
+            + double(aLeft.z) * aRight.z + double(aLeft.w) * aRight.w);
+
+        return 2 * std::acos(std::min(dot, 1.0));
+    }
+
+    transform_snapshot decode(const transform_snapshot &aBaseline, const std::vector<std::uint8_t> &aBytes) {
+        transform_snapshot out;
+
+        REQUIRE(decode_delta(aBaseline, aBytes.data(), aBytes.data() + aBytes.size(), out)
+            == aBytes.data() + aBytes.size());
+
+        return out;
+    }
+}
+
+TEMPLATE_TEST_CASE("transform_delta: quantization", "[transform_delta]", float, double)
+{
+    using T = TestType;
+
+    const crowd<T> entities(1000);
+
+    SECTION("positions are within half a spacing, rotations within the precision's error")
+    {
+        for (const std::uint32_t bits : {8u, 12u, 15u}) {
+            const transform_precision<T> precision{T(0.01), bits};
+
+            transform_snapshot snapshot;
+            quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), precision,
+                snapshot);
+
+            REQUIRE(snapshot.size() == entities.positions.size());
+            REQUIRE(snapshot.rotation_bits == bits);
+
+            std::vector<vector3<T>> positions(snapshot.size());
+            std::vector<quaternion<T>> rotations(snapshot.size());
+            dequantize(snapshot, precision, positions.data(), rotations.data());
+
+            // half a step of each of the three smallest components and the largest rebuilt from them, plus the
+            // least angle between two rotations of T that is not lost to rounding
+            const auto rotationError = 4 * std::sqrt(2.0) / ((1u << bits) - 1)
+                + 4 * std::sqrt(double(std::numeric_limits<T>::epsilon()));
+
+            for (std::size_t i = 0; i < snapshot.size(); ++i) {
+                REQUIRE(std::abs(positions[i].x - entities.positions[i].x) <= T(0.00501));
+                REQUIRE(std::abs(positions[i].y - entities.positions[i].y) <= T(0.00501));
+                REQUIRE(std::abs(positions[i].z - entities.positions[i].z) <= T(0.00501));
+                REQUIRE(angle_between(rotations[i], entities.rotations[i]) <= rotationError);
+            }
+        }
+    }
+
+    SECTION("views quantize and dequantize as arrays do")
+    {
+        struct entity final {
+            int id;
+            vector3<T> position;
+            quaternion<T> rotation;
+        };
+
+        std::vector<entity> interleaved;
+        for (std::size_t i = 0; i < entities.positions.size(); ++i)
+            interleaved.push_back({int(i), entities.positions[i], entities.rotations[i]});
+
+        const transform_precision<T> precision;
+
+        transform_snapshot fromArrays, fromViews;
+        quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), precision,
+            fromArrays);
+        quantize(strided_span<const vector3<T>>(&interleaved.front().position, interleaved.size(), sizeof(entity)),
+            strided_span<const quaternion<T>>(&interleaved.front().rotation, interleaved.size(), sizeof(entity)),
+            precision, fromViews);
+
+        REQUIRE(fromViews == fromArrays);
+
+        std::vector<entity> out(interleaved.size());
+        dequantize(fromViews, precision,
+            strided_span<vector3<T>>(&out.front().position, out.size(), sizeof(entity)),
+            strided_span<quaternion<T>>(&out.front().rotation, out.size(), sizeof(entity)));
+
+        std::vector<vector3<T>> positions(fromArrays.size());
+        std::vector<quaternion<T>> rotations(fromArrays.size());
+        dequantize(fromArrays, precision, positions.data(), rotations.data());
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            REQUIRE(out[i].position == positions[i]);
+            REQUIRE(out[i].rotation == rotations[i]);
+        }
+
+        REQUIRE_THROWS_AS(quantize(strided_span<const vector3<T>>(positions.data(), positions.size()),
+            strided_span<const quaternion<T>>(rotations.data(), rotations.size() - 1), precision, fromViews),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(dequantize(fromArrays, precision,
+            strided_span<vector3<T>>(positions.data(), positions.size()),
+            strided_span<quaternion<T>>(rotations.data(), rotations.size() - 1)), std::invalid_argument);
+    }
+
+    SECTION("bad precisions and positions out of range throw")
+    {
+        transform_snapshot snapshot;
+
+        const auto with = [&](const transform_precision<T> &aPrecision) {
+            quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), aPrecision,
+                snapshot);
+        };
+
+        REQUIRE_THROWS_AS(with({T(0), 12}), std::invalid_argument);
+        REQUIRE_THROWS_AS(with({T(-1), 12}), std::invalid_argument);
+        REQUIRE_THROWS_AS(with({T(0.01), 1}), std::invalid_argument);
+        REQUIRE_THROWS_AS(with({T(0.01), 16}), std::invalid_argument);
+        REQUIRE_NOTHROW(with({T(0.01), 2}));
+
+        const vector3<T> far(0, T(2e9), 0);
+        const vector3<T> notANumber(std::numeric_limits<T>::quiet_NaN(), 0, 0);
+        const auto rotation = quaternion<T>::identity;
+
+        REQUIRE_THROWS_AS(quantize(&far, &rotation, 1, transform_precision<T>{T(1), 12}, snapshot),
+            std::out_of_range);
+        REQUIRE_THROWS_AS(quantize(&notANumber, &rotation, 1, transform_precision<T>{T(1), 12}, snapshot),
+            std::out_of_range);
+
+        std::vector<vector3<T>> positions(1);
+        std::vector<quaternion<T>> rotations(1);
+
+        quantize(&far, &rotation, 1, transform_precision<T>{T(1e3), 12}, snapshot);
+        REQUIRE_THROWS_AS(dequantize(snapshot, transform_precision<T>{T(1e3), 13}, positions.data(), rotations.data()),
+            std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE("transform_delta: encoding", "[transform_delta]", float, double)
+{
+    using T = TestType;
+
+    const transform_precision<T> precision{T(0.001), 14};
+
+    crowd<T> entities(5000);
+
+    transform_snapshot baseline;
+    quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), precision, baseline);
+
+    SECTION("a whole snapshot decodes exactly, against no baseline")
+    {
+        std::vector<std::uint8_t> bytes;
+        encode_delta({}, baseline, bytes);
+
+        REQUIRE(decode({}, bytes) == baseline);
+
+        // and against one, which it does not need
+        REQUIRE(decode(baseline, bytes) == baseline);
+
+        // smaller than the raw snapshot: 4 bytes a position component, 2 bits and 3 components a rotation
+        REQUIRE(bytes.size() < baseline.size() * (12 + (2 + 3 * 14) / 8));
+    }
+
+    SECTION("ticks decode exactly against their baselines, and cost little when little moves")
+    {
+        for (std::size_t tick = 0; tick < 10; ++tick) {
+            entities.tick(10, T(tick));
+
+            transform_snapshot current;
+            quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), precision,
+                current);
+
+            std::vector<std::uint8_t> bytes;
+            encode_delta(baseline, current, bytes);
+
+            REQUIRE(decode(baseline, bytes) == current);
+
+            // a tenth of the entities moving a few centimetres: under half the 18 bytes each takes raw
+            REQUIRE(bytes.size() < current.size() / 10 * 9);
+
+            baseline = current;
+        }
+    }
+
+    SECTION("an unchanged snapshot is about a bit per entity")
+    {
+        std::vector<std::uint8_t> bytes;
+        encode_delta(baseline, baseline, bytes);
+
+        REQUIRE(decode(baseline, bytes) == baseline);
+        REQUIRE(bytes.size() <= baseline.size() / 8 + baseline.size() / 64 * 2 + 8);
+    }
+
+    SECTION("large moves, rotations whose largest component changes, and extreme positions")
+    {
+        auto current = baseline;
+
+        for (std::size_t i = 0; i < current.size(); i += 7) {
+            current.positions[i * 3] = std::numeric_limits<std::int32_t>::max();
+            current.positions[i * 3 + 1] = std::numeric_limits<std::int32_t>::min();
+            current.positions[i * 3 + 2] += 1;
+        }
+
+        const auto steps = static_cast<std::uint16_t>((1u << precision.rotation_bits) - 1);
+
+        for (std::size_t i = 3; i < current.size(); i += 11) {
+            current.rotations[i * 4] = static_cast<std::uint16_t>((current.rotations[i * 4] + 1) % 4);
+            current.rotations[i * 4 + 1] = steps;
+            current.rotations[i * 4 + 3] = 0;
+        }
+
+        std::vector<std::uint8_t> bytes;
+        encode_delta(baseline, current, bytes);
+
+        REQUIRE(decode(baseline, bytes) == current);
+    }
+
+    SECTION("decoding over the baseline, and streams one after another")
+    {
+        std::vector<transform_snapshot> ticks;
+        std::vector<std::uint8_t> bytes;
+
+        encode_delta({}, baseline, bytes);
+        ticks.push_back(baseline);
+
+        for (std::size_t tick = 0; tick < 5; ++tick) {
+            entities.tick(3, T(tick));
+
+            transform_snapshot current;
+            quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), precision,
+                current);
+
+            encode_delta(ticks.back(), current, bytes);
+            ticks.push_back(current);
+        }
+
+        transform_snapshot received;
+        const auto *position = bytes.data();
+
+        for (const auto &tick : ticks) {
+            position = decode_delta(received, position, bytes.data() + bytes.size(), received);
+
+            REQUIRE(received == tick);
+        }
+
+        REQUIRE(position == bytes.data() + bytes.size());
+    }
+
+    SECTION("mismatched baselines, truncated and malformed streams throw")
+    {
+        transform_snapshot fewer;
+        quantize(entities.positions.data(), entities.rotations.data(), 10, precision, fewer);
+
+        transform_snapshot coarser;
+        quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(),
+            transform_precision<T>{precision.position, 10}, coarser);
+
+        std::vector<std::uint8_t> bytes;
+
+        REQUIRE_THROWS_AS(encode_delta(fewer, baseline, bytes), std::invalid_argument);
+        REQUIRE_THROWS_AS(encode_delta(coarser, baseline, bytes), std::invalid_argument);
+
+        entities.tick(2, 0);
+
+        transform_snapshot current;
+        quantize(entities.positions.data(), entities.rotations.data(), entities.positions.size(), precision,
+            current);
+
+        encode_delta(baseline, current, bytes);
+
+        transform_snapshot out;
+
+        REQUIRE_THROWS_AS(decode_delta({}, bytes.data(), bytes.data() + bytes.size(), out), std::runtime_error);
+        REQUIRE_THROWS_AS(decode_delta(fewer, bytes.data(), bytes.data() + bytes.size(), out), std::runtime_error);
+        REQUIRE_THROWS_AS(decode_delta(coarser, bytes.data(), bytes.data() + bytes.size(), out), std::runtime_error);
+        REQUIRE_THROWS_AS(decode_delta(baseline, bytes.data(), bytes.data() + bytes.size() / 2, out),
+            std::runtime_error);
+        REQUIRE_THROWS_AS(decode_delta(baseline, bytes.data(), bytes.data(), out), std::runtime_error);
+
+        // a count far beyond what the bytes could hold
+        const std::vector<std::uint8_t> huge{0xf8, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00};
+        REQUIRE_THROWS_AS(decode_delta({}, huge.data(), huge.data() + huge.size(), out), std::runtime_error);
+
+        REQUIRE(decode(baseline, bytes) == current);
+
+        // decoding over the baseline, a stream that turns out bad leaves the baseline as it was
+        const auto saved = baseline;
+
+        for (const auto length : {bytes.size() / 2, bytes.size() - 1}) {
+            REQUIRE_THROWS_AS(decode_delta(baseline, bytes.data(), bytes.data() + length, baseline),
+                std::runtime_error);
+            REQUIRE(baseline == saved);
+        }
+
+        decode_delta(baseline, bytes.data(), bytes.data() + bytes.size(), baseline);
+        REQUIRE(baseline == current);
+    }
+}
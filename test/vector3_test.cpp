@@ -6,6 +6,7 @@
 #include <gdk/vector3.h>
 
 #include <cmath>
+#include <cstdint>
 #include <stdexcept>
 
 using namespace gdk;
@@ -259,3 +260,33 @@ TEMPLATE_LIST_TEST_CASE("vector3 operators", "[vector3]", type::floating_point)
         REQUIRE(vec::max(a, b) == vec(4, 5, 6));
     }
 }
+
+TEMPLATE_TEST_CASE("vector3 with integer components", "[vector3]", int, std::int16_t, std::int64_t)
+{
+    using vec = vector3<TestType>;
+
+    const vec a(1, -2, 3);
+    const vec b(4, 5, -6);
+
+    SECTION("arithmetic stays in the component type, as it does for vector2")
+    {
+        REQUIRE(a + b == vec(5, 3, -3));
+        REQUIRE(a - b == vec(-3, -7, 9));
+        REQUIRE(-a == vec(-1, 2, -3));
+        REQUIRE(a * 3 == vec(3, -6, 9));
+        REQUIRE(a.element_wise_product(b) == vec(4, -10, -18));
+    }
+
+    SECTION("the measurements that need no square root")
+    {
+        REQUIRE(a.dot_product(b) == -24);
+        REQUIRE(a.length_squared() == 14);
+        REQUIRE(a.cross_product(b) == vec(-3, 18, 13));
+    }
+
+    SECTION("min and max, used to bound a run of cells")
+    {
+        REQUIRE(vec::min(a, b) == vec(1, -2, -6));
+        REQUIRE(vec::max(a, b) == vec(4, 5, 3));
+    }
+}